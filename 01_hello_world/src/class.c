@@ -0,0 +1,71 @@
+#ifndef __CLASS_C__
+#define __CLASS_C__
+
+#include "class.h"
+
+void set_u8(File* file, u8 bytes) {
+    SET_BYTES(file, &bytes);
+}
+
+void set_u16(File* file, u16 bytes) {
+    /* NOTE: See `https://gcc.gnu.org/onlinedocs/gcc/Other-Builtins.html`. */
+    const u16 swap_bytes = __builtin_bswap16(bytes);
+    SET_BYTES(file, &swap_bytes);
+}
+
+void set_u32(File* file, u32 bytes) {
+    const u32 swap_bytes = __builtin_bswap32(bytes);
+    SET_BYTES(file, &swap_bytes);
+}
+
+void set_constant_pool_utf8(File* file, const char* string) {
+    const u16 len = (u16)get_len(string);
+    set_u8(file, CONSTANT_UTF8);
+    set_u16(file, len);
+    if (fwrite(string, sizeof(char), len, file) != len) {
+        exit(EXIT_FAILURE);
+    }
+}
+
+void set_constant_pool_class(File* file, u16 index, const char* string) {
+    set_constant_pool_utf8(file, string);
+    set_u8(file, CONSTANT_CLASS);
+    set_u16(file, index);
+}
+
+void set_constant_pool_string(File* file, u16 index, const char* string) {
+    set_constant_pool_utf8(file, string);
+    set_u8(file, CONSTANT_STRING);
+    set_u16(file, index);
+}
+
+void set_constant_pool_indices(File*    file,
+                               Constant op_code,
+                               u16      index_a,
+                               u16      index_b) {
+    set_u8(file, op_code);
+    set_u16(file, index_a);
+    set_u16(file, index_b);
+}
+
+void set_instr_empty(File* file, Instr instr) {
+    set_u8(file, instr);
+}
+
+void set_instr_u8(File* file, Instr instr, u8 bytes) {
+    set_u8(file, instr);
+    set_u8(file, bytes);
+}
+
+void set_instr_u8_u8(File* file, Instr instr, u8 bytes_a, u8 bytes_b) {
+    set_u8(file, instr);
+    set_u8(file, bytes_a);
+    set_u8(file, bytes_b);
+}
+
+void set_instr_u16(File* file, Instr instr, u16 bytes) {
+    set_u8(file, instr);
+    set_u16(file, bytes);
+}
+
+#endif
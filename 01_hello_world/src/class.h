@@ -0,0 +1,120 @@
+#ifndef __CLASS_H__
+#define __CLASS_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef FILE File;
+
+typedef uint8_t  u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+
+typedef int32_t i32;
+
+typedef enum {
+    ACCESS_PUBLIC = 0x0001,
+    ACCESS_PRIVATE = 0x0002,
+    ACCESS_PROTECTED = 0x0004,
+    ACCESS_STATIC = 0x0008,
+    ACCESS_FINAL = 0x0010,
+    ACCESS_SUPER = 0x0020,
+    ACCESS_VOLATILE = 0x0040,
+    ACCESS_TRANSIENT = 0x0080,
+    ACCESS_INTERFACE = 0x0200,
+    ACCESS_ABSTRACT = 0x0400,
+    ACCESS_SYNTHETIC = 0x1000,
+    ACCESS_ANNOTATION = 0x2000,
+    ACCESS_ENUM = 0x4000,
+    ACCESS_MODULE = 0x8000,
+} Access;
+
+typedef enum {
+    CONSTANT_UTF8 = 1,
+    CONSTANT_INTEGER = 3,
+    CONSTANT_FLOAT = 4,
+    CONSTANT_LONG = 5,
+    CONSTANT_DOUBLE = 6,
+    CONSTANT_CLASS = 7,
+    CONSTANT_STRING = 8,
+    CONSTANT_FIELD_REF = 9,
+    CONSTANT_METHOD_REF = 10,
+    CONSTANT_INTERFACE_METHODREF = 11,
+    CONSTANT_NAME_AND_TYPE = 12,
+    CONSTANT_METHOD_HANDLE = 15,
+    CONSTANT_METHOD_TYPE = 16,
+    CONSTANT_DYNAMIC = 17,
+    CONSTANT_INVOKE_DYNAMIC = 18,
+    CONSTANT_MODULE = 19,
+    CONSTANT_PACKAGE = 20,
+} Constant;
+
+typedef enum {
+    INSTR_LDC = 0x12,
+    INSTR_LDC_W = 0x13,
+    INSTR_ILOAD_0 = 0x1a,
+    INSTR_POP = 0x57,
+    INSTR_IINC = 0x84,
+    INSTR_IFEQ = 0x99,
+    INSTR_IRETURN = 0xac,
+    INSTR_RETVOID = 0xb1,
+    INSTR_GETSTATIC = 0xb2,
+    INSTR_INVOKEVIRTUAL = 0xb6,
+} Instr;
+
+typedef struct {
+    u32 magic;
+    u16 minor_version;
+    u16 major_version;
+} Version;
+
+typedef struct {
+    u16 access_modifiers;
+    u16 class_constant_index;
+    u16 super_constant_index;
+} Flags;
+
+typedef struct {
+    u16 size;
+    u16 access_modifiers;
+    u16 name_index;
+    u16 type_index;
+    u16 attribute_size;
+    u16 code_index;
+    u32 code_attribute_size;
+    u16 max_stack_size;
+    u16 max_local_var_size;
+    u32 code_size;
+} Method;
+
+static const u16 EMPTY = 0;
+
+__attribute__((unused)) static u16 get_len(const char* x) {
+    u16 i = 0;
+    while (x[i] != '\0') {
+        ++i;
+    }
+    return i;
+}
+
+#define SET_BYTES(file, bytes)                         \
+    if (fwrite(bytes, sizeof(*bytes), 1, file) != 1) { \
+        exit(EXIT_FAILURE);                            \
+    }
+
+void set_u8(File*, u8);
+void set_u16(File*, u16);
+void set_u32(File*, u32);
+
+void set_constant_pool_utf8(File*, const char*);
+void set_constant_pool_class(File*, u16, const char*);
+void set_constant_pool_string(File*, u16, const char*);
+void set_constant_pool_indices(File*, Constant, u16, u16);
+
+void set_instr_empty(File*, Instr);
+void set_instr_u8(File*, Instr, u8);
+void set_instr_u8_u8(File*, Instr, u8, u8);
+void set_instr_u16(File*, Instr, u16);
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef __ARENA_C__
+#define __ARENA_C__
+
+#include "arena.h"
+
+ArenaBlock* alloc_arena_block(u64 size) {
+    ArenaBlock* block = malloc(sizeof(ArenaBlock) + size);
+    if (block == NULL) {
+        return NULL;
+    }
+    block->next_block = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+/* NOTE: Bump allocation out of a chain of large blocks. Blocks are kept
+ * across `reset_arena`, so once the chain has grown to fit the largest class
+ * seen so far, parsing another one never touches `malloc`. Returns `NULL`
+ * if a new block is needed and `malloc` fails. */
+void* alloc_bytes(Arena* arena, u64 size, u64 align) {
+    ArenaBlock* block = arena->current_block;
+    for (;;) {
+        if (block != NULL) {
+            uintptr_t address = (uintptr_t)&block->bytes[block->used];
+            u64       padding = (u64)((-address) & (align - 1));
+            if ((block->used + padding + size) <= block->size) {
+                void* bytes = &block->bytes[block->used + padding];
+                block->used += padding + size;
+                arena->used += padding + size;
+                if (arena->high_water < arena->used) {
+                    arena->high_water = arena->used;
+                }
+                arena->current_block = block;
+                return bytes;
+            }
+            arena->used += block->size - block->used;
+        }
+        ArenaBlock* next_block =
+            block == NULL ? arena->first_block : block->next_block;
+        if ((next_block == NULL) || (next_block->size < (size + align))) {
+            u64 block_size = SIZE_ARENA_BLOCK;
+            if (block_size < (size + align)) {
+                block_size = size + align;
+            }
+            ArenaBlock* new_block = alloc_arena_block(block_size);
+            if (new_block == NULL) {
+                return NULL;
+            }
+            arena->reserved += block_size;
+            new_block->next_block = next_block;
+            if (block == NULL) {
+                arena->first_block = new_block;
+            } else {
+                block->next_block = new_block;
+            }
+            next_block = new_block;
+        }
+        next_block->used = 0;
+        block = next_block;
+    }
+}
+
+void reset_arena(Arena* arena) {
+    arena->current_block = arena->first_block;
+    if (arena->current_block != NULL) {
+        arena->current_block->used = 0;
+    }
+    arena->used = 0;
+}
+
+void free_arena(Arena* arena) {
+    ArenaBlock* block = arena->first_block;
+    while (block != NULL) {
+        ArenaBlock* next_block = block->next_block;
+        free(block);
+        block = next_block;
+    }
+    arena->first_block = NULL;
+    arena->current_block = NULL;
+    arena->used = 0;
+    arena->reserved = 0;
+}
+
+#endif
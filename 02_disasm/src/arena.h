@@ -0,0 +1,31 @@
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+#include "prelude.h"
+
+#define SIZE_ARENA_BLOCK (1 << 20)
+
+typedef struct ArenaBlock ArenaBlock;
+
+struct ArenaBlock {
+    ArenaBlock* next_block;
+    u64         size;
+    u64         used;
+    u8          bytes[];
+};
+
+typedef struct {
+    ArenaBlock* first_block;
+    ArenaBlock* current_block;
+    u64         used;
+    u64         high_water;
+    u64         reserved;
+} Arena;
+
+ArenaBlock* alloc_arena_block(u64);
+
+void* alloc_bytes(Arena*, u64, u64);
+void  reset_arena(Arena*);
+void  free_arena(Arena*);
+
+#endif
@@ -0,0 +1,382 @@
+#ifndef __BATCH_C__
+#define __BATCH_C__
+
+#include "batch.h"
+
+Bool is_class_file(const char* path) {
+    return is_class_name(path, (u32)strlen(path));
+}
+
+Bool is_jar_file(const char* path) {
+    u32 n = (u32)strlen(path);
+    return (4 < n) && (strcmp(&path[n - 4], ".jar") == 0);
+}
+
+BatchJob* push_batch_job(Batch* batch, const char* path) {
+    if (batch->job_capacity <= batch->job_count) {
+        u32 job_capacity = batch->job_capacity == 0
+                               ? COUNT_BATCH_JOBS
+                               : batch->job_capacity * 2;
+        BatchJob* jobs =
+            realloc(batch->jobs, sizeof(BatchJob) * job_capacity);
+        if (jobs == NULL) {
+            fprintf(stderr, "[ERROR] `realloc` failed\n");
+            exit(EXIT_FAILURE);
+        }
+        batch->jobs = jobs;
+        batch->job_capacity = job_capacity;
+    }
+    BatchJob* job = &batch->jobs[batch->job_count++];
+    job->path = strdup(path);
+    if (job->path == NULL) {
+        fprintf(stderr, "[ERROR] `strdup` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    job->entry.name = NULL;
+    job->output.chars = NULL;
+    job->done = FALSE;
+    return job;
+}
+
+void set_batch_jobs(Batch* batch, const char* directory) {
+    DIR* dir = opendir(directory);
+    if (dir == NULL) {
+        fprintf(stderr, "[ERROR] Unable to open directory `%s`\n", directory);
+        exit(EXIT_FAILURE);
+    }
+    for (struct dirent* entry = readdir(dir); entry != NULL;
+         entry = readdir(dir))
+    {
+        if ((strcmp(entry->d_name, ".") == 0) ||
+            (strcmp(entry->d_name, "..") == 0))
+        {
+            continue;
+        }
+        size_t size = strlen(directory) + strlen(entry->d_name) + 2;
+        char*  path = malloc(size);
+        if (path == NULL) {
+            fprintf(stderr, "[ERROR] `malloc` failed\n");
+            exit(EXIT_FAILURE);
+        }
+        snprintf(path, size, "%s/%s", directory, entry->d_name);
+        /* NOTE: Links are followed to files but never into directories,
+         * so a link back up the tree cannot send the walk round forever. */
+        struct stat path_stat;
+        Bool        is_link =
+            (lstat(path, &path_stat) == 0) && S_ISLNK(path_stat.st_mode);
+        if (stat(path, &path_stat) < 0) {
+            /* NOTE: Queued anyway, so its job reports why it is unreadable
+             * in place. */
+            if (is_class_file(path)) {
+                push_batch_job(batch, path);
+            }
+        } else if (S_ISDIR(path_stat.st_mode)) {
+            if (!is_link) {
+                set_batch_jobs(batch, path);
+            }
+        } else if (S_ISREG(path_stat.st_mode) && is_class_file(path)) {
+            push_batch_job(batch, path);
+        }
+        free(path);
+    }
+    closedir(dir);
+}
+
+void set_batch_jar_jobs(Batch* batch, const char* path) {
+    batch->jar_bytes = map_file(path, &batch->jar_size);
+    JarReader reader;
+    set_jar_reader(&reader, batch->jar_bytes, batch->jar_size);
+    JarEntry entry;
+    while (pop_jar_entry(&reader, &entry)) {
+        if (!is_class_name(entry.name, entry.name_size)) {
+            continue;
+        }
+        size_t size = strlen(path) + entry.name_size + 3;
+        char*  entry_path = malloc(size);
+        if (entry_path == NULL) {
+            fprintf(stderr, "[ERROR] `malloc` failed\n");
+            exit(EXIT_FAILURE);
+        }
+        snprintf(entry_path,
+                 size,
+                 "%s!/%.*s",
+                 path,
+                 (i32)entry.name_size,
+                 entry.name);
+        push_batch_job(batch, entry_path)->entry = entry;
+        free(entry_path);
+    }
+}
+
+i32 compare_batch_jobs(const void* a, const void* b) {
+    return strcmp(((const BatchJob*)a)->path, ((const BatchJob*)b)->path);
+}
+
+/* NOTE: Owners take work from the head of their queue, thieves take it from
+ * the tail. Jobs are dealt out round-robin in output order, so owners work
+ * on the files the reorder buffer is waiting for while thieves take the
+ * ones it will need last. */
+Bool pop_work_queue(WorkQueue* queue, u32* job_index) {
+    Bool popped = FALSE;
+    pthread_mutex_lock(&queue->lock);
+    if (queue->head < queue->tail) {
+        *job_index = queue->job_indices[queue->head++];
+        popped = TRUE;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return popped;
+}
+
+Bool steal_work_queue(WorkQueue* queue, u32* job_index) {
+    Bool stolen = FALSE;
+    pthread_mutex_lock(&queue->lock);
+    if (queue->head < queue->tail) {
+        *job_index = queue->job_indices[--queue->tail];
+        stolen = TRUE;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return stolen;
+}
+
+void unset_batch_job_bytes(Memory* memory, const BatchJob* job) {
+    if (job->entry.name == NULL) {
+        unset_file_to_bytes(memory);
+    } else {
+        memory->bytes = NULL;
+        memory->file_size = 0;
+    }
+}
+
+/* NOTE: Returns `NULL`, or why the job's bytes could not be had. */
+const char* set_batch_job_bytes(Worker* worker, BatchJob* job) {
+    Memory* memory = &worker->memory;
+    if (job->entry.name == NULL) {
+        return try_file_to_bytes(memory, job->path);
+    }
+    memory->file_size = job->entry.size;
+    return try_jar_entry_bytes(&job->entry,
+                               &worker->buffer,
+                               &worker->buffer_capacity,
+                               &memory->bytes);
+}
+
+void set_batch_job_output(Worker* worker, BatchJob* job) {
+    Memory* memory = &worker->memory;
+    STATS_PUSH(memory, STATS_LOAD);
+    const char* load_error = set_batch_job_bytes(worker, job);
+    STATS_POP(memory, STATS_LOAD);
+    Buffer* output = &job->output;
+    View    view = worker->batch->view;
+    set_buffer(output, -1);
+    if (view.tag == VIEW_JSON) {
+        print_json_file(output, job->path);
+    } else {
+        put_str(output, "[FILE] ");
+        put_str(output, job->path);
+        put_str(output, "\n\n");
+    }
+    /* NOTE: A file that cannot be read is reported like a malformed one,
+     * and never cached. */
+    if (load_error != NULL) {
+        if (view.tag == VIEW_JSON) {
+            print_json_load_error(output, load_error);
+        } else {
+            put_str(output, "[ERROR] ");
+            put_str(output, load_error);
+            put_str(output, "\n\n");
+        }
+        return;
+    }
+    /* NOTE: Everything after the `[FILE]` line (or `file` record) depends
+     * only on the class bytes and the view, so that is what gets cached. */
+    Cache*  cache = worker->batch->cache;
+    Hash128 hash = {0};
+    u32     start = output->size;
+    if (cache != NULL) {
+        hash = get_hash128(memory->bytes, memory->file_size, cache->seed);
+        if (get_cache_entry(cache, hash, output)) {
+            ++worker->cache_hit_count;
+            unset_batch_job_bytes(memory, job);
+            return;
+        }
+    }
+    ParseError error = print_class(output, memory, view);
+    STATS_CLASS(memory, output);
+    /* NOTE: A malformed class is reported in place and the batch carries
+     * on. */
+    if (view.tag == VIEW_JSON) {
+        if (error.code != PARSE_OK) {
+            print_json_error(output, error);
+        }
+    } else if (error.code != PARSE_OK) {
+        put_str(output, "[ERROR] ");
+        put_str(output, get_parse_error_name(error.code));
+        put_str(output, " (byte ");
+        put_u32(output, error.offset);
+        put_str(output, ")\n\n");
+    } else {
+        put_str(output, "\n[INFO] ");
+        put_u32(output, memory->file_size - memory->byte_index);
+        put_str(output, " bytes left!\n\n");
+    }
+    if (cache != NULL) {
+        put_cache_entry(cache,
+                        hash,
+                        &output->chars[start],
+                        output->size - start,
+                        worker->index);
+    }
+    unset_batch_job_bytes(memory, job);
+}
+
+void* run_worker(void* argument) {
+    Worker* worker = argument;
+    Batch*  batch = worker->batch;
+    for (;;) {
+        u32 job_index;
+        if (!pop_work_queue(&worker->queue, &job_index)) {
+            Bool stolen = FALSE;
+            for (u32 i = 1; i < batch->worker_count; ++i) {
+                Worker* victim =
+                    &batch->workers[(worker->index + i) % batch->worker_count];
+                if (steal_work_queue(&victim->queue, &job_index)) {
+                    stolen = TRUE;
+                    break;
+                }
+            }
+            if (!stolen) {
+                break;
+            }
+        }
+        BatchJob* job = &batch->jobs[job_index];
+        set_batch_job_output(worker, job);
+        pthread_mutex_lock(&batch->lock);
+        job->done = TRUE;
+        pthread_cond_broadcast(&batch->done);
+        pthread_mutex_unlock(&batch->lock);
+    }
+    return NULL;
+}
+
+void run_batch(const char*  path,
+               u32          worker_count,
+               View         view,
+               const char*  cache_path,
+               StatsReport* report) {
+    Batch batch = {0};
+    Cache cache;
+    batch.view = view;
+    if (cache_path != NULL) {
+        char view_key[SIZE_CACHE_PATH];
+        i32  size = snprintf(view_key,
+                             sizeof(view_key),
+                             "%d %u %u %u %s",
+                             OUTPUT_VERSION,
+                             (u32)view.tag,
+                             (u32)view.resolve,
+                             view.attribute_skip_mask,
+                             view.method_name == NULL ? "" : view.method_name);
+        if ((size < 0) || ((i32)sizeof(view_key) <= size)) {
+            fprintf(stderr, "[ERROR] Cache key is too long\n");
+            exit(EXIT_FAILURE);
+        }
+        set_cache(&cache, cache_path, view_key);
+        batch.cache = &cache;
+    }
+    if (is_jar_file(path)) {
+        set_batch_jar_jobs(&batch, path);
+    } else {
+        set_batch_jobs(&batch, path);
+    }
+    qsort(batch.jobs, batch.job_count, sizeof(BatchJob), compare_batch_jobs);
+    if (worker_count == 0) {
+        worker_count = 1;
+    }
+    batch.worker_count = worker_count;
+    batch.workers = calloc(worker_count, sizeof(Worker));
+    if (batch.workers == NULL) {
+        fprintf(stderr, "[ERROR] `calloc` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    pthread_mutex_init(&batch.lock, NULL);
+    pthread_cond_init(&batch.done, NULL);
+    u32 queue_size = (batch.job_count / worker_count) + 1;
+    for (u32 i = 0; i < worker_count; ++i) {
+        Worker* worker = &batch.workers[i];
+        worker->batch = &batch;
+        worker->memory.lazy_methods = view.tag != VIEW_TOKENS;
+        worker->memory.attribute_skip_mask = view.attribute_skip_mask;
+        worker->index = i;
+        pthread_mutex_init(&worker->queue.lock, NULL);
+        worker->queue.job_indices = malloc(sizeof(u32) * queue_size);
+        if (worker->queue.job_indices == NULL) {
+            fprintf(stderr, "[ERROR] `malloc` failed\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (u32 i = 0; i < batch.job_count; ++i) {
+        WorkQueue* queue = &batch.workers[i % worker_count].queue;
+        queue->job_indices[queue->tail++] = i;
+    }
+    for (u32 i = 0; i < worker_count; ++i) {
+        if (pthread_create(&batch.workers[i].thread,
+                           NULL,
+                           run_worker,
+                           &batch.workers[i]) != 0)
+        {
+            fprintf(stderr, "[ERROR] `pthread_create` failed\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    /* NOTE: Reorder buffer; finished jobs wait here until every job sorted
+     * before them has been written, so output order never depends on
+     * scheduling. */
+    for (u32 i = 0; i < batch.job_count; ++i) {
+        BatchJob* job = &batch.jobs[i];
+        pthread_mutex_lock(&batch.lock);
+        while (!job->done) {
+            pthread_cond_wait(&batch.done, &batch.lock);
+        }
+        pthread_mutex_unlock(&batch.lock);
+        job->output.file = STDOUT_FILENO;
+        free_buffer(&job->output);
+        free(job->path);
+    }
+    for (u32 i = 0; i < worker_count; ++i) {
+        pthread_join(batch.workers[i].thread, NULL);
+    }
+    /* NOTE: Reported on `stderr` so the output itself is byte for byte
+     * the same with or without the cache. */
+    if (batch.cache != NULL) {
+        u32 cache_hit_count = 0;
+        for (u32 i = 0; i < worker_count; ++i) {
+            cache_hit_count += batch.workers[i].cache_hit_count;
+        }
+        fprintf(stderr,
+                "[INFO] Cache: %u hits, %u misses\n",
+                cache_hit_count,
+                batch.job_count - cache_hit_count);
+    }
+#ifdef STATS
+    for (u32 i = 0; i < worker_count; ++i) {
+        merge_stats(report, &batch.workers[i].memory, i);
+    }
+#endif
+    print_stats_report(report);
+    for (u32 i = 0; i < worker_count; ++i) {
+        Worker* worker = &batch.workers[i];
+        pthread_mutex_destroy(&worker->queue.lock);
+        free(worker->queue.job_indices);
+        free(worker->buffer);
+        free_memory(&worker->memory);
+    }
+    pthread_cond_destroy(&batch.done);
+    pthread_mutex_destroy(&batch.lock);
+    free(batch.workers);
+    free(batch.jobs);
+    if (batch.jar_bytes != NULL) {
+        unmap_file(batch.jar_bytes, batch.jar_size);
+    }
+}
+
+#endif
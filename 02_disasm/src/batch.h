@@ -0,0 +1,73 @@
+#ifndef __BATCH_H__
+#define __BATCH_H__
+
+#include <dirent.h>
+#include <pthread.h>
+#include <string.h>
+
+#include "cache.c"
+#include "jar.c"
+#include "print.c"
+#include "report.c"
+
+#define COUNT_BATCH_JOBS 1024
+
+typedef struct {
+    char*    path;
+    JarEntry entry;
+    Buffer   output;
+    Bool     done;
+} BatchJob;
+
+typedef struct {
+    pthread_mutex_t lock;
+    u32*            job_indices;
+    u32             head;
+    u32             tail;
+} WorkQueue;
+
+typedef struct Batch Batch;
+
+typedef struct {
+    Memory    memory;
+    WorkQueue queue;
+    Batch*    batch;
+    u8*       buffer;
+    u32       buffer_capacity;
+    pthread_t thread;
+    u32       index;
+    u32       cache_hit_count;
+} Worker;
+
+struct Batch {
+    const u8*       jar_bytes;
+    u32             jar_size;
+    BatchJob*       jobs;
+    u32             job_count;
+    u32             job_capacity;
+    Worker*         workers;
+    u32             worker_count;
+    View            view;
+    Cache*          cache;
+    pthread_mutex_t lock;
+    pthread_cond_t  done;
+};
+
+Bool is_class_file(const char*);
+Bool is_jar_file(const char*);
+
+BatchJob* push_batch_job(Batch*, const char*);
+void      set_batch_jobs(Batch*, const char*);
+void      set_batch_jar_jobs(Batch*, const char*);
+i32  compare_batch_jobs(const void*, const void*);
+
+Bool pop_work_queue(WorkQueue*, u32*);
+Bool steal_work_queue(WorkQueue*, u32*);
+
+void        unset_batch_job_bytes(Memory*, const BatchJob*);
+const char* set_batch_job_bytes(Worker*, BatchJob*);
+void        set_batch_job_output(Worker*, BatchJob*);
+void*       run_worker(void*);
+void        run_batch(const char*, u32, View, const char*, StatsReport*);
+
+#endif
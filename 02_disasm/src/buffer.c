@@ -0,0 +1,156 @@
+#ifndef __BUFFER_C__
+#define __BUFFER_C__
+
+#include "buffer.h"
+
+/* NOTE: A `Buffer` either drains into `file` with `write(2)` whenever it
+ * fills up, or, when `file` is negative, grows in memory and is handed off
+ * whole (as in batch mode). The `_pad` variants left-justify into a column,
+ * matching `printf`'s `%-Nu`. */
+
+void set_buffer(Buffer* buffer, i32 file) {
+    buffer->chars = malloc(SIZE_BUFFER);
+    if (buffer->chars == NULL) {
+        fprintf(stderr, "[ERROR] `malloc` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    buffer->size = 0;
+    buffer->capacity = SIZE_BUFFER;
+    buffer->file = file;
+}
+
+void flush_buffer(Buffer* buffer) {
+    if (buffer->file < 0) {
+        return;
+    }
+    for (u32 i = 0; i < buffer->size;) {
+        ssize_t size =
+            write(buffer->file, &buffer->chars[i], buffer->size - i);
+        if (size < 0) {
+            fprintf(stderr, "[ERROR] `write` failed\n");
+            exit(EXIT_FAILURE);
+        }
+        i += (u32)size;
+    }
+    buffer->size = 0;
+}
+
+void free_buffer(Buffer* buffer) {
+    flush_buffer(buffer);
+    free(buffer->chars);
+    buffer->chars = NULL;
+    buffer->capacity = 0;
+}
+
+void reserve_buffer(Buffer* buffer, u32 size) {
+    if ((buffer->size + size) <= buffer->capacity) {
+        return;
+    }
+    flush_buffer(buffer);
+    if ((buffer->size + size) <= buffer->capacity) {
+        return;
+    }
+    u32 capacity = buffer->capacity;
+    while (capacity < (buffer->size + size)) {
+        capacity *= 2;
+    }
+    char* chars = realloc(buffer->chars, capacity);
+    if (chars == NULL) {
+        fprintf(stderr, "[ERROR] `realloc` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    buffer->chars = chars;
+    buffer->capacity = capacity;
+}
+
+void put_char(Buffer* buffer, char x) {
+    reserve_buffer(buffer, 1);
+    buffer->chars[buffer->size++] = x;
+}
+
+void put_chars(Buffer* buffer, const char* chars, u32 size) {
+    reserve_buffer(buffer, size);
+    memcpy(&buffer->chars[buffer->size], chars, size);
+    buffer->size += size;
+}
+
+void put_str(Buffer* buffer, const char* string) {
+    put_chars(buffer, string, (u32)strlen(string));
+}
+
+void put_spaces(Buffer* buffer, u32 count) {
+    reserve_buffer(buffer, count);
+    memset(&buffer->chars[buffer->size], ' ', count);
+    buffer->size += count;
+}
+
+void put_str_pad(Buffer* buffer, const char* string, u32 width) {
+    u32 size = (u32)strlen(string);
+    put_chars(buffer, string, size);
+    if (size < width) {
+        put_spaces(buffer, width - size);
+    }
+}
+
+u32 get_digits(char* digits, u32 value) {
+    u32 n = 0;
+    do {
+        digits[n++] = (char)('0' + (value % 10));
+        value /= 10;
+    } while (value != 0);
+    return n;
+}
+
+void put_digits(Buffer*      buffer,
+                const char* digits,
+                u32         n,
+                Bool        negative,
+                u32         width) {
+    u32 size = n + (negative ? 1 : 0);
+    reserve_buffer(buffer, size < width ? width : size);
+    char* chars = &buffer->chars[buffer->size];
+    if (negative) {
+        *chars++ = '-';
+    }
+    for (u32 i = 0; i < n; ++i) {
+        chars[i] = digits[n - 1 - i];
+    }
+    buffer->size += size;
+    if (size < width) {
+        memset(&buffer->chars[buffer->size], ' ', width - size);
+        buffer->size += width - size;
+    }
+}
+
+void put_u32(Buffer* buffer, u32 value) {
+    put_u32_pad(buffer, value, 0);
+}
+
+void put_i32(Buffer* buffer, i32 value) {
+    put_i32_pad(buffer, value, 0);
+}
+
+void put_u32_pad(Buffer* buffer, u32 value, u32 width) {
+    char digits[10];
+    u32  n = get_digits(digits, value);
+    put_digits(buffer, digits, n, FALSE, width);
+}
+
+void put_i32_pad(Buffer* buffer, i32 value, u32 width) {
+    char digits[10];
+    Bool negative = value < 0;
+    u32  n = get_digits(digits, negative ? -(u32)value : (u32)value);
+    put_digits(buffer, digits, n, negative, width);
+}
+
+void put_hex_pad(Buffer* buffer, u64 value, u32 width) {
+    char digits[16];
+    u32  n = 0;
+    do {
+        digits[n++] = "0123456789ABCDEF"[value & 0xF];
+        value >>= 4;
+    } while (value != 0);
+    put_digits(buffer, digits, n, FALSE, width);
+}
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef __BUFFER_H__
+#define __BUFFER_H__
+
+#include <string.h>
+#include <unistd.h>
+
+#include "prelude.h"
+
+#define SIZE_BUFFER (1 << 16)
+
+typedef struct {
+    char* chars;
+    u32   size;
+    u32   capacity;
+    i32   file;
+} Buffer;
+
+void set_buffer(Buffer*, i32);
+void flush_buffer(Buffer*);
+void free_buffer(Buffer*);
+void reserve_buffer(Buffer*, u32);
+
+void put_char(Buffer*, char);
+void put_chars(Buffer*, const char*, u32);
+void put_str(Buffer*, const char*);
+void put_spaces(Buffer*, u32);
+void put_str_pad(Buffer*, const char*, u32);
+
+u32  get_digits(char*, u32);
+void put_digits(Buffer*, const char*, u32, Bool, u32);
+void put_u32(Buffer*, u32);
+void put_i32(Buffer*, i32);
+void put_u32_pad(Buffer*, u32, u32);
+void put_i32_pad(Buffer*, i32, u32);
+void put_hex_pad(Buffer*, u64, u32);
+
+#endif
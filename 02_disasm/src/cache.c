@@ -0,0 +1,101 @@
+#ifndef __CACHE_C__
+#define __CACHE_C__
+
+#include "cache.h"
+
+/* NOTE: One file per entry, named by the 128-bit hash of the class bytes.
+ * The hash is seeded with everything else the output depends on (the
+ * view and the cache version), so changing a flag misses instead of
+ * serving the wrong text. */
+void set_cache(Cache* cache, const char* path, const char* view_key) {
+    if ((mkdir(path, 0755) < 0) && (errno != EEXIST)) {
+        fprintf(stderr, "[ERROR] Unable to create `%s`\n", path);
+        exit(EXIT_FAILURE);
+    }
+    cache->path = path;
+    cache->seed = get_hash128((const u8*)view_key, strlen(view_key), 0).low;
+}
+
+void set_cache_path(const Cache* cache,
+                    Hash128      hash,
+                    const char*  suffix,
+                    char*        path) {
+    i32 size = snprintf(path,
+                        SIZE_CACHE_PATH,
+                        "%s/%016lx%016lx%s",
+                        cache->path,
+                        hash.high,
+                        hash.low,
+                        suffix);
+    if ((size < 0) || (SIZE_CACHE_PATH <= size)) {
+        fprintf(stderr, "[ERROR] Cache path is too long\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/* NOTE: Appends the entry to `buffer`; a missing or unreadable entry is a
+ * miss and leaves `buffer` as it was. */
+Bool get_cache_entry(const Cache* cache, Hash128 hash, Buffer* buffer) {
+    char path[SIZE_CACHE_PATH];
+    set_cache_path(cache, hash, "", path);
+    i32 file = open(path, O_RDONLY);
+    if (file < 0) {
+        return FALSE;
+    }
+    struct stat file_stat;
+    if ((fstat(file, &file_stat) < 0) ||
+        ((off_t)UINT32_MAX < file_stat.st_size))
+    {
+        close(file);
+        return FALSE;
+    }
+    u32 size = (u32)file_stat.st_size;
+    u32 start = buffer->size;
+    reserve_buffer(buffer, size);
+    for (u32 i = 0; i < size;) {
+        ssize_t n = read(file, &buffer->chars[start + i], size - i);
+        if (n <= 0) {
+            close(file);
+            return FALSE;
+        }
+        i += (u32)n;
+    }
+    close(file);
+    buffer->size = start + size;
+    return TRUE;
+}
+
+/* NOTE: Written under a per-worker temporary name and renamed into place,
+ * so concurrent workers and readers only ever see whole entries. Failing
+ * to write is not an error; the next run just misses again. */
+void put_cache_entry(const Cache* cache,
+                     Hash128      hash,
+                     const char*  chars,
+                     u32          size,
+                     u32          worker_index) {
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), ".%u.tmp", worker_index);
+    char temp_path[SIZE_CACHE_PATH];
+    set_cache_path(cache, hash, suffix, temp_path);
+    i32 file = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (file < 0) {
+        return;
+    }
+    for (u32 i = 0; i < size;) {
+        ssize_t n = write(file, &chars[i], size - i);
+        if (n <= 0) {
+            close(file);
+            unlink(temp_path);
+            return;
+        }
+        i += (u32)n;
+    }
+    close(file);
+    char path[SIZE_CACHE_PATH];
+    set_cache_path(cache, hash, "", path);
+    if (rename(temp_path, path) < 0) {
+        unlink(temp_path);
+    }
+}
+
+#endif
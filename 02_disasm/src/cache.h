@@ -0,0 +1,24 @@
+#ifndef __CACHE_H__
+#define __CACHE_H__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "buffer.c"
+#include "hash.c"
+
+#define SIZE_CACHE_PATH 4096
+
+typedef struct {
+    const char* path;
+    u64         seed;
+} Cache;
+
+void set_cache(Cache*, const char*, const char*);
+void set_cache_path(const Cache*, Hash128, const char*, char*);
+Bool get_cache_entry(const Cache*, Hash128, Buffer*);
+void put_cache_entry(const Cache*, Hash128, const char*, u32, u32);
+
+#endif
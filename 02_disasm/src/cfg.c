@@ -0,0 +1,392 @@
+#ifndef __CFG_C__
+#define __CFG_C__
+
+#include "cfg.h"
+
+/* NOTE: Three linear passes over the code: mark instruction starts and
+ * block leaders, number the blocks, then walk the block terminators for
+ * edges. The edge walk runs twice, once to count and once to fill, so every
+ * array is allocated exactly once at its final size. Handler edges are
+ * built apart, per distinct exception range rather than per block. */
+
+_Noreturn void set_cfg_error(CfgBuilder*    builder,
+                             u32            pc,
+                             ParseErrorCode code) {
+    set_parse_error_at(builder->memory, builder->code->bytes, pc, code);
+}
+
+/* NOTE: `edge_marks` remembers, per target block, the last terminator
+ * that pushed a branch edge to it, so the many cases of a switch that
+ * share a target give one edge. Fall-through edges are never merged: a
+ * branch to the next instruction still needs its own edge. */
+void push_cfg_edge(CfgBuilder* builder,
+                   u32         pc,
+                   u32         block_index,
+                   EdgeTag     tag) {
+    Cfg* cfg = builder->cfg;
+    if (tag == EDGE_BRANCH) {
+        if (builder->edge_marks[block_index] == (pc + 1)) {
+            return;
+        }
+        builder->edge_marks[block_index] = pc + 1;
+    }
+    Block* block = &cfg->blocks[cfg->block_indices[pc]];
+    if (cfg->edges != NULL) {
+        Edge* edge = &cfg->edges[block->edge_index + block->edge_count];
+        edge->block_index = block_index;
+        edge->exception_index = CFG_NO_EXCEPTION;
+        edge->tag = tag;
+    }
+    ++block->edge_count;
+    ++cfg->edge_count;
+}
+
+/* NOTE: Before the blocks are numbered this only marks the target as a
+ * leader; afterwards it pushes the edge. */
+void push_branch_target(CfgBuilder* builder, u32 pc, i64 offset) {
+    i64 target = (i64)pc + offset;
+    if ((target < 0) || ((i64)builder->code->byte_count <= target)) {
+        set_cfg_error(builder, pc, PARSE_BAD_CODE_OFFSET);
+    }
+    Cfg* cfg = builder->cfg;
+    if (cfg->block_indices == NULL) {
+        builder->pc_flags[target] |= PC_LEADER;
+    } else {
+        push_cfg_edge(builder,
+                      pc,
+                      cfg->block_indices[target],
+                      EDGE_BRANCH);
+    }
+}
+
+void push_branch_targets(CfgBuilder* builder, u32 pc) {
+    Memory*           memory = builder->memory;
+    const u8*         bytes = builder->code->bytes;
+    u32               byte_count = builder->code->byte_count;
+    OpCode            op_code = bytes[pc];
+    const OpCodeInfo* info = &OP_CODES[op_code];
+    u32               i = pc + 1;
+    if (info->layout == OPERAND_TABLE_SWITCH) {
+        i += get_switch_padding(pc);
+        push_branch_target(builder,
+                           pc,
+                           (i32)pop_u32_at(memory, bytes, &i, byte_count));
+        i32 low = (i32)pop_u32_at(memory, bytes, &i, byte_count);
+        i32 high = (i32)pop_u32_at(memory, bytes, &i, byte_count);
+        for (i64 key = low; key <= high; ++key) {
+            push_branch_target(builder,
+                               pc,
+                               (i32)pop_u32_at(memory, bytes, &i, byte_count));
+        }
+    } else if (info->layout == OPERAND_LOOKUP_SWITCH) {
+        i += get_switch_padding(pc);
+        push_branch_target(builder,
+                           pc,
+                           (i32)pop_u32_at(memory, bytes, &i, byte_count));
+        u32 pair_count = pop_u32_at(memory, bytes, &i, byte_count);
+        for (u32 j = 0; j < pair_count; ++j) {
+            i += 4;
+            push_branch_target(builder,
+                               pc,
+                               (i32)pop_u32_at(memory, bytes, &i, byte_count));
+        }
+    } else if (is_branch_op_code(op_code)) {
+        if (info->layout == OPERAND_I32) {
+            push_branch_target(builder,
+                               pc,
+                               (i32)pop_u32_at(memory, bytes, &i, byte_count));
+        } else {
+            push_branch_target(builder,
+                               pc,
+                               (i16)pop_u16_at(memory, bytes, &i, byte_count));
+        }
+    }
+}
+
+/* NOTE: `pc_flags` has one extra slot so an exception range may end at
+ * `byte_count`. */
+void set_pc_flags(CfgBuilder* builder) {
+    const Code* code = builder->code;
+    u32         byte_count = code->byte_count;
+    u8*         pc_flags =
+        alloc_memory_bytes(builder->memory, (u64)byte_count + 1, 1);
+    memset(pc_flags, 0, (u64)byte_count + 1);
+    builder->pc_flags = pc_flags;
+    if (byte_count != 0) {
+        pc_flags[0] = PC_LEADER;
+    }
+    for (u32 pc = 0; pc < byte_count;) {
+        u32 size = get_op_code_size(code->bytes, pc, byte_count);
+        if (size == 0) {
+            set_cfg_error(builder, pc, PARSE_BAD_INSTRUCTION);
+        }
+        pc_flags[pc] |= PC_INSTRUCTION;
+        push_branch_targets(builder, pc);
+        OpCode op_code = code->bytes[pc];
+        if (is_branch_op_code(op_code) || !is_fall_through_op_code(op_code))
+        {
+            pc_flags[pc + size] |= PC_LEADER;
+        }
+        pc += size;
+    }
+    for (u16 i = 0; i < code->exception_table_count; ++i) {
+        ExceptionTable exception = code->exception_table[i];
+        if ((exception.pc_end <= exception.pc_start) ||
+            (byte_count < exception.pc_end) ||
+            (byte_count <= exception.pc_handler))
+        {
+            set_cfg_error(builder, byte_count, PARSE_BAD_CODE_OFFSET);
+        }
+        pc_flags[exception.pc_start] |= PC_LEADER;
+        pc_flags[exception.pc_end] |= PC_LEADER;
+        pc_flags[exception.pc_handler] |= PC_LEADER;
+    }
+    for (u32 pc = 0; pc < byte_count; ++pc) {
+        if (pc_flags[pc] == PC_LEADER) {
+            set_cfg_error(builder, pc, PARSE_BAD_CODE_OFFSET);
+        }
+    }
+}
+
+void set_cfg_blocks(CfgBuilder* builder) {
+    Memory* memory = builder->memory;
+    Cfg*    cfg = builder->cfg;
+    u32     byte_count = builder->code->byte_count;
+    u32     block_count = 0;
+    for (u32 pc = 0; pc < byte_count; ++pc) {
+        if (builder->pc_flags[pc] & PC_LEADER) {
+            ++block_count;
+        }
+    }
+    Block* blocks = alloc_memory_bytes(memory,
+                                       sizeof(Block) * (u64)block_count,
+                                       _Alignof(Block));
+    u32*   block_indices = alloc_memory_bytes(memory,
+                                            sizeof(u32) * (u64)byte_count,
+                                            _Alignof(u32));
+    u32    block_index = 0;
+    for (u32 pc = 0; pc < byte_count; ++pc) {
+        if ((builder->pc_flags[pc] & PC_LEADER) && (pc != 0)) {
+            blocks[block_index++].pc_end = pc;
+        }
+        if (builder->pc_flags[pc] & PC_LEADER) {
+            blocks[block_index].pc_start = pc;
+            blocks[block_index].edge_index = 0;
+            blocks[block_index].edge_count = 0;
+        }
+        block_indices[pc] = block_index;
+    }
+    if (block_count != 0) {
+        blocks[block_count - 1].pc_end = byte_count;
+    }
+    builder->edge_marks = alloc_memory_bytes(memory,
+                                             sizeof(u32) * (u64)block_count,
+                                             _Alignof(u32));
+    cfg->blocks = blocks;
+    cfg->block_indices = block_indices;
+    cfg->block_count = block_count;
+}
+
+void set_cfg_edges(CfgBuilder* builder) {
+    const Code* code = builder->code;
+    Cfg*        cfg = builder->cfg;
+    u32         byte_count = code->byte_count;
+    memset(builder->edge_marks, 0, sizeof(u32) * (u64)cfg->block_count);
+    for (u32 pc = 0; pc < byte_count;) {
+        u32 next_pc = pc + get_op_code_size(code->bytes, pc, byte_count);
+        if ((next_pc != byte_count) &&
+            (cfg->block_indices[next_pc] == cfg->block_indices[pc]))
+        {
+            pc = next_pc;
+            continue;
+        }
+        if (is_fall_through_op_code(code->bytes[pc])) {
+            if (next_pc == byte_count) {
+                set_cfg_error(builder, pc, PARSE_BAD_CODE_OFFSET);
+            }
+            push_cfg_edge(builder,
+                          pc,
+                          cfg->block_indices[next_pc],
+                          EDGE_FALL_THROUGH);
+        }
+        push_branch_targets(builder, pc);
+        pc = next_pc;
+    }
+}
+
+u32 push_cfg_handler(CfgBuilder* builder, u16 exception_index, u32 next) {
+    const Code* code = builder->code;
+    Cfg*        cfg = builder->cfg;
+    if (cfg->handlers != NULL) {
+        Handler* handler = &cfg->handlers[cfg->handler_count];
+        handler->edge.block_index =
+            cfg->block_indices[code->exception_table[exception_index]
+                                   .pc_handler];
+        handler->edge.exception_index = exception_index;
+        handler->edge.tag = EDGE_HANDLER;
+        handler->next_handler = next;
+    }
+    return ++cfg->handler_count;
+}
+
+/* NOTE: Sorts exception entries by start block, then outermost first, then
+ * in reverse table order, so that entries with the same range come out of
+ * the stack below in table order. */
+u64 get_cfg_handler_key(const Cfg* cfg, ExceptionTable exception, u16 i) {
+    u64 start = cfg->block_indices[exception.pc_start];
+    u64 end = cfg->block_indices[exception.pc_end - 1] + 1;
+    return (start << 40) | ((0xFFFFF - end) << 20) | (0xFFFF - (u64)i);
+}
+
+i32 compare_cfg_handler_keys(const void* a, const void* b) {
+    u64 key_a = *(const u64*)a;
+    u64 key_b = *(const u64*)b;
+    return (key_a > key_b) - (key_a < key_b);
+}
+
+/* NOTE: Sweeps the blocks with a stack of the exception entries covering
+ * the current one, innermost on top. Each stack level holds a handler
+ * node whose `next_handler` is the level below, and a block points at the
+ * node on top, so blocks under the same entries share one chain. With
+ * nested ranges, which is what compilers emit, entries only ever leave
+ * from the top and each gets exactly one node; an entry leaving from
+ * further down has the levels above it pushed again. Like the edge walk,
+ * this runs once to count and once to fill. */
+void set_cfg_handlers(CfgBuilder* builder) {
+    Memory*     memory = builder->memory;
+    const Code* code = builder->code;
+    Cfg*        cfg = builder->cfg;
+    u32         block_count = cfg->block_count;
+    u16         entry_count = code->exception_table_count;
+    if (entry_count == 0) {
+        for (u32 i = 0; i < block_count; ++i) {
+            cfg->blocks[i].handler = 0;
+        }
+        return;
+    }
+    u64* keys = alloc_memory_bytes(memory,
+                                   sizeof(u64) * (u64)entry_count,
+                                   _Alignof(u64));
+    u32* end_blocks = alloc_memory_bytes(memory,
+                                         sizeof(u32) * (u64)entry_count,
+                                         _Alignof(u32));
+    u32* end_counts = alloc_memory_bytes(memory,
+                                         sizeof(u32) * ((u64)block_count + 1),
+                                         _Alignof(u32));
+    u16* stack = alloc_memory_bytes(memory,
+                                    sizeof(u16) * (u64)entry_count,
+                                    _Alignof(u16));
+    u32* nodes = alloc_memory_bytes(memory,
+                                    sizeof(u32) * (u64)entry_count,
+                                    _Alignof(u32));
+    memset(end_counts, 0, sizeof(u32) * ((u64)block_count + 1));
+    for (u16 i = 0; i < entry_count; ++i) {
+        ExceptionTable exception = code->exception_table[i];
+        keys[i] = get_cfg_handler_key(cfg, exception, i);
+        end_blocks[i] = cfg->block_indices[exception.pc_end - 1] + 1;
+        ++end_counts[end_blocks[i]];
+    }
+    qsort(keys, entry_count, sizeof(u64), compare_cfg_handler_keys);
+    for (;;) {
+        u32 top = 0;
+        u16 next_key = 0;
+        cfg->handler_count = 0;
+        for (u32 i = 0; i < block_count; ++i) {
+            if (end_counts[i] != 0) {
+                u32 low = top;
+                for (u32 seen = 0; seen < end_counts[i];) {
+                    --low;
+                    if (end_blocks[stack[low]] == i) {
+                        ++seen;
+                    }
+                }
+                u32 old_top = top;
+                top = low;
+                for (u32 j = low; j < old_top; ++j) {
+                    u16 entry = stack[j];
+                    if (end_blocks[entry] == i) {
+                        continue;
+                    }
+                    nodes[top] = push_cfg_handler(builder,
+                                                  entry,
+                                                  top == 0 ? 0
+                                                           : nodes[top - 1]);
+                    stack[top++] = entry;
+                }
+            }
+            while ((next_key < entry_count) &&
+                   ((keys[next_key] >> 40) == i))
+            {
+                u16 entry = (u16)(0xFFFF - (keys[next_key++] & 0xFFFF));
+                nodes[top] = push_cfg_handler(builder,
+                                              entry,
+                                              top == 0 ? 0 : nodes[top - 1]);
+                stack[top++] = entry;
+            }
+            cfg->blocks[i].handler = top == 0 ? 0 : nodes[top - 1];
+        }
+        if (cfg->handlers != NULL) {
+            return;
+        }
+        cfg->handlers =
+            alloc_memory_bytes(memory,
+                               sizeof(Handler) * (u64)cfg->handler_count,
+                               _Alignof(Handler));
+    }
+}
+
+void set_cfg(Memory* memory, Cfg* cfg, const Code* code) {
+    CfgBuilder builder = {.memory = memory, .code = code, .cfg = cfg};
+    cfg->blocks = NULL;
+    cfg->edges = NULL;
+    cfg->handlers = NULL;
+    cfg->block_indices = NULL;
+    cfg->pc_flags = NULL;
+    cfg->block_count = 0;
+    cfg->edge_count = 0;
+    cfg->handler_count = 0;
+    set_pc_flags(&builder);
+    cfg->pc_flags = builder.pc_flags;
+    set_cfg_blocks(&builder);
+    set_cfg_edges(&builder);
+    u32 edge_count = 0;
+    for (u32 i = 0; i < cfg->block_count; ++i) {
+        cfg->blocks[i].edge_index = edge_count;
+        edge_count += cfg->blocks[i].edge_count;
+        cfg->blocks[i].edge_count = 0;
+    }
+    cfg->edges = alloc_memory_bytes(memory,
+                                    sizeof(Edge) * (u64)edge_count,
+                                    _Alignof(Edge));
+    cfg->edge_count = 0;
+    set_cfg_edges(&builder);
+    set_cfg_handlers(&builder);
+}
+
+const Code* get_method_code(const Memory* memory, const Method* method) {
+    for (u32 i = method->attributes; i != 0;
+         i = get_attribute_at(memory, i)->next_attribute)
+    {
+        const Attribute* attribute = get_attribute_at(memory, i);
+        if (attribute->tag == ATTRIB_CODE) {
+            return &attribute->code;
+        }
+    }
+    return NULL;
+}
+
+ParseError parse_cfg(Memory* memory, Cfg* cfg, const Code* code) {
+    jmp_buf on_error;
+    u32     byte_index = memory->byte_index;
+    memory->error.code = PARSE_OK;
+    memory->error.offset = 0;
+    memory->on_error = &on_error;
+    if (setjmp(on_error) == 0) {
+        set_cfg(memory, cfg, code);
+    }
+    memory->on_error = NULL;
+    memory->byte_index = byte_index;
+    return memory->error;
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef __CFG_H__
+#define __CFG_H__
+
+#include "op_codes.c"
+
+#define CFG_NO_EXCEPTION 0xFFFF
+
+typedef enum {
+    PC_INSTRUCTION = 1 << 0,
+    PC_LEADER = 1 << 1,
+} PcFlag;
+
+typedef enum {
+    EDGE_FALL_THROUGH,
+    EDGE_BRANCH,
+    EDGE_HANDLER,
+} EdgeTag;
+
+/* NOTE: `exception_index` points into the method's exception table for
+ * handler edges, so the catch type is one load away. */
+typedef struct {
+    u32     block_index;
+    u16     exception_index;
+    EdgeTag tag;
+} Edge;
+
+typedef struct {
+    u32 pc_start;
+    u32 pc_end;
+    u32 edge_index;
+    u32 edge_count;
+    u32 handler;
+} Block;
+
+/* NOTE: One link of a chain of handler edges; `next_handler` is the index
+ * of the next link plus one, or zero at the end of the chain. */
+typedef struct {
+    Edge edge;
+    u32  next_handler;
+} Handler;
+
+/* NOTE: Blocks are numbered in pc order and their edges sit contiguously
+ * in `edges`; `block_indices` maps every pc of the code to the block
+ * holding it, and `pc_flags` tells which pcs start an instruction. Handler
+ * edges live apart in `handlers`: a block's `handler` is the index plus one
+ * of its chain, innermost exception entry first, and blocks covered by the
+ * same entries share one. */
+typedef struct {
+    Block*   blocks;
+    Edge*    edges;
+    Handler* handlers;
+    u32*     block_indices;
+    u8*      pc_flags;
+    u32      block_count;
+    u32      edge_count;
+    u32      handler_count;
+} Cfg;
+
+typedef struct {
+    Memory*     memory;
+    const Code* code;
+    Cfg*        cfg;
+    u8*         pc_flags;
+    u32*        edge_marks;
+} CfgBuilder;
+
+_Noreturn void set_cfg_error(CfgBuilder*, u32, ParseErrorCode);
+
+void push_cfg_edge(CfgBuilder*, u32, u32, EdgeTag);
+void push_branch_target(CfgBuilder*, u32, i64);
+void push_branch_targets(CfgBuilder*, u32);
+void set_pc_flags(CfgBuilder*);
+void set_cfg_blocks(CfgBuilder*);
+void set_cfg_edges(CfgBuilder*);
+u32  push_cfg_handler(CfgBuilder*, u16, u32);
+u64  get_cfg_handler_key(const Cfg*, ExceptionTable, u16);
+i32  compare_cfg_handler_keys(const void*, const void*);
+void set_cfg_handlers(CfgBuilder*);
+void set_cfg(Memory*, Cfg*, const Code*);
+
+const Code* get_method_code(const Memory*, const Method*);
+ParseError  parse_cfg(Memory*, Cfg*, const Code*);
+
+#endif
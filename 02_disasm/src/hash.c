@@ -0,0 +1,84 @@
+#ifndef __HASH_C__
+#define __HASH_C__
+
+#include "hash.h"
+
+/* NOTE: MurmurHash3, x64 128-bit variant. Not cryptographic; it only has
+ * to tell apart files that actually differ, and runs at memory speed. */
+
+u64 get_hash_rotl(u64 x, u32 r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+u64 get_hash_mix(u64 x) {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCD;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53;
+    x ^= x >> 33;
+    return x;
+}
+
+u64 get_hash_u64(const u8* bytes) {
+    u64 x;
+    memcpy(&x, bytes, sizeof(x));
+    return x;
+}
+
+Hash128 get_hash128(const u8* bytes, u64 size, u64 seed) {
+    const u64 c1 = 0x87C37B91114253D5;
+    const u64 c2 = 0x4CF5AD432745937F;
+    u64       h1 = seed;
+    u64       h2 = seed;
+    u64       block_count = size / 16;
+    for (u64 i = 0; i < block_count; ++i) {
+        u64 k1 = get_hash_u64(&bytes[i * 16]);
+        u64 k2 = get_hash_u64(&bytes[(i * 16) + 8]);
+        k1 *= c1;
+        k1 = get_hash_rotl(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+        h1 = get_hash_rotl(h1, 27);
+        h1 += h2;
+        h1 = (h1 * 5) + 0x52DCE729;
+        k2 *= c2;
+        k2 = get_hash_rotl(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+        h2 = get_hash_rotl(h2, 31);
+        h2 += h1;
+        h2 = (h2 * 5) + 0x38495AB5;
+    }
+    const u8* tail = &bytes[block_count * 16];
+    u64       k1 = 0;
+    u64       k2 = 0;
+    for (u64 i = size & 15; 8 < i; --i) {
+        k2 |= (u64)tail[i - 1] << ((i - 9) * 8);
+    }
+    for (u64 i = (size & 15) < 8 ? (size & 15) : 8; 0 < i; --i) {
+        k1 |= (u64)tail[i - 1] << ((i - 1) * 8);
+    }
+    if (8 < (size & 15)) {
+        k2 *= c2;
+        k2 = get_hash_rotl(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+    }
+    if ((size & 15) != 0) {
+        k1 *= c1;
+        k1 = get_hash_rotl(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+    }
+    h1 ^= size;
+    h2 ^= size;
+    h1 += h2;
+    h2 += h1;
+    h1 = get_hash_mix(h1);
+    h2 = get_hash_mix(h2);
+    h1 += h2;
+    h2 += h1;
+    return (Hash128){.low = h1, .high = h2};
+}
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef __HASH_H__
+#define __HASH_H__
+
+#include <string.h>
+
+#include "prelude.h"
+
+typedef struct {
+    u64 low;
+    u64 high;
+} Hash128;
+
+u64     get_hash_rotl(u64, u32);
+u64     get_hash_mix(u64);
+u64     get_hash_u64(const u8*);
+Hash128 get_hash128(const u8*, u64, u64);
+
+#endif
@@ -0,0 +1,752 @@
+#ifndef __INDEX_C__
+#define __INDEX_C__
+
+#include "index.h"
+
+#define INDEX_ERROR(message)                             \
+    {                                                    \
+        fprintf(stderr, "[ERROR] Index: %s\n", message); \
+        exit(EXIT_FAILURE);                              \
+    }
+
+/* NOTE: FNV-1a. Builder and reader hash the same UTF-8 bytes, so the bloom
+ * bits a query probes are the ones the builder set. */
+u64 get_index_hash(const char* chars, u32 size) {
+    u64 hash = 0xCBF29CE484222325;
+    for (u32 i = 0; i < size; ++i) {
+        hash ^= (u8)chars[i];
+        hash *= 0x100000001B3;
+    }
+    return hash;
+}
+
+/* NOTE: Double hashing off the one 64-bit hash; `word_count` is a power
+ * of two. */
+void set_index_bloom(u64* words, u32 word_count, u64 hash) {
+    u64 mask = ((u64)word_count * 64) - 1;
+    u64 step = (hash >> 32) | 1;
+    for (u32 i = 0; i < COUNT_INDEX_BLOOM_HASHES; ++i) {
+        u64 bit = (hash + (i * step)) & mask;
+        words[bit / 64] |= (u64)1 << (bit % 64);
+    }
+}
+
+Bool is_index_bloom_set(const u64* words, u32 word_count, u64 hash) {
+    u64 mask = ((u64)word_count * 64) - 1;
+    u64 step = (hash >> 32) | 1;
+    for (u32 i = 0; i < COUNT_INDEX_BLOOM_HASHES; ++i) {
+        u64 bit = (hash + (i * step)) & mask;
+        if (!(words[bit / 64] & ((u64)1 << (bit % 64)))) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+void* push_index_item(void** items, u32* count, u32* capacity, u64 size) {
+    if (*capacity <= *count) {
+        if (*capacity == 0x80000000) {
+            INDEX_ERROR("Too many items");
+        }
+        u32   new_capacity = *capacity == 0 ? COUNT_INDEX_ITEMS
+                                            : *capacity * 2;
+        void* new_items = realloc(*items, size * new_capacity);
+        if (new_items == NULL) {
+            fprintf(stderr, "[ERROR] `realloc` failed\n");
+            exit(EXIT_FAILURE);
+        }
+        *items = new_items;
+        *capacity = new_capacity;
+    }
+    return &((u8*)*items)[size * (*count)++];
+}
+
+/* NOTE: Interned strings outlive the class they came from, so they are
+ * copied out of the class arena into the builder's own. */
+u32 push_index_string(IndexBuilder* builder, const char* chars, u32 size) {
+    if (builder->slot_capacity <= ((builder->string_count + 1) * 2)) {
+        u32  slot_capacity = builder->slot_capacity == 0
+                                 ? COUNT_INDEX_ITEMS
+                                 : builder->slot_capacity * 2;
+        u32* slots = calloc(slot_capacity, sizeof(u32));
+        if (slots == NULL) {
+            fprintf(stderr, "[ERROR] `calloc` failed\n");
+            exit(EXIT_FAILURE);
+        }
+        for (u32 i = 0; i < builder->string_count; ++i) {
+            u64 j = builder->strings[i].hash & (slot_capacity - 1);
+            while (slots[j] != 0) {
+                j = (j + 1) & (slot_capacity - 1);
+            }
+            slots[j] = i + 1;
+        }
+        free(builder->string_slots);
+        builder->string_slots = slots;
+        builder->slot_capacity = slot_capacity;
+    }
+    u64 hash = get_index_hash(chars, size);
+    u64 j = hash & (builder->slot_capacity - 1);
+    for (; builder->string_slots[j] != 0;
+         j = (j + 1) & (builder->slot_capacity - 1))
+    {
+        const IndexString* string =
+            &builder->strings[builder->string_slots[j] - 1];
+        if ((string->hash == hash) && (string->size == size) &&
+            (memcmp(string->chars, chars, size) == 0))
+        {
+            return builder->string_slots[j] - 1;
+        }
+    }
+    char* copy = alloc_bytes(&builder->arena, size, 1);
+    if (copy == NULL) {
+        fprintf(stderr, "[ERROR] `malloc` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(copy, chars, size);
+    IndexString* string = push_index_item((void**)&builder->strings,
+                                          &builder->string_count,
+                                          &builder->string_capacity,
+                                          sizeof(IndexString));
+    string->chars = copy;
+    string->size = size;
+    string->hash = hash;
+    builder->string_slots[j] = builder->string_count;
+    return builder->string_count - 1;
+}
+
+void push_index_class(void* context, const ClassHeader* header) {
+    IndexBuilder* builder = context;
+    Memory*       memory = builder->memory;
+    if (get_constant_tag(memory, header->this_class) != CONSTANT_TAG_CLASS) {
+        set_parse_error(memory, PARSE_BAD_CONSTANT_INDEX);
+    }
+    set_resolver(memory, &builder->resolver);
+    builder->symbol_indices =
+        alloc_memory_bytes(memory,
+                           sizeof(u32) * (u64)memory->constant_count,
+                           _Alignof(u32));
+    memset(builder->symbol_indices,
+           0,
+           sizeof(u32) * (u64)memory->constant_count);
+    Resolved    name = get_resolved(&builder->resolver, header->this_class);
+    IndexClass* class_ = push_index_item((void**)&builder->classes,
+                                         &builder->class_count,
+                                         &builder->class_capacity,
+                                         sizeof(IndexClass));
+    class_->string_index = push_index_string(builder, name.chars, name.size);
+    class_->method_index = builder->method_count;
+    class_->method_count = 0;
+    class_->bloom_index = 0;
+    class_->bloom_word_count = 0;
+}
+
+void push_index_method(void* context, const Method* method) {
+    IndexBuilder* builder = context;
+    Resolved      name = get_resolved_join(
+        &builder->resolver,
+        get_resolved_utf8(&builder->resolver, method->name_index),
+        ':',
+        get_resolved_utf8(&builder->resolver, method->descriptor_index));
+    IndexMethod* index_method = push_index_item((void**)&builder->methods,
+                                                &builder->method_count,
+                                                &builder->method_capacity,
+                                                sizeof(IndexMethod));
+    index_method->class_index = builder->class_count - 1;
+    index_method->string_index =
+        push_index_string(builder, name.chars, name.size);
+    ++builder->classes[builder->class_count - 1].method_count;
+}
+
+/* NOTE: Member references plus the class operands of `new`, the casts
+ * and `ldc`, so a class query also finds code that only names the class.
+ * Repeats within a method are dropped here when adjacent and in
+ * `write_index` otherwise. */
+void push_index_use(void* context, const Instruction* instruction) {
+    IndexBuilder* builder = context;
+    Memory*       memory = builder->memory;
+    const u8*     bytes = instruction->bytes;
+    OpCode        op_code = instruction->op_code;
+    u16           index;
+    if (op_code == OP_LDC) {
+        index = bytes[1];
+    } else if ((op_code == OP_LDC_W) ||
+               ((OP_GETSTATIC <= op_code) &&
+                (op_code <= OP_INVOKEINTERFACE)) ||
+               (op_code == OP_NEW) || (op_code == OP_ANEWARRAY) ||
+               (op_code == OP_CHECKCAST) || (op_code == OP_INSTANCEOF) ||
+               (op_code == OP_MULTIANEWARRAY))
+    {
+        index = (u16)((bytes[1] << 8) | bytes[2]);
+    } else {
+        return;
+    }
+    ConstantTag tag = get_constant_tag(memory, index);
+    if ((tag != CONSTANT_TAG_FIELD_REF) && (tag != CONSTANT_TAG_METHOD_REF) &&
+        (tag != CONSTANT_TAG_INTERFACE_METHOD_REF) &&
+        (tag != CONSTANT_TAG_CLASS))
+    {
+        return;
+    }
+    if (builder->symbol_indices[index] == 0) {
+        Resolved symbol = get_resolved(&builder->resolver, index);
+        builder->symbol_indices[index] =
+            push_index_string(builder, symbol.chars, symbol.size) + 1;
+    }
+    u32 symbol_index = builder->symbol_indices[index] - 1;
+    u32 method_index = builder->method_count - 1;
+    if ((builder->use_count != 0) &&
+        (builder->uses[builder->use_count - 1].symbol_index ==
+         symbol_index) &&
+        (builder->uses[builder->use_count - 1].method_index == method_index))
+    {
+        return;
+    }
+    IndexUse* use = push_index_item((void**)&builder->uses,
+                                    &builder->use_count,
+                                    &builder->use_capacity,
+                                    sizeof(IndexUse));
+    use->symbol_index = symbol_index;
+    use->method_index = method_index;
+}
+
+i32 compare_index_strings(const void* a, const void* b) {
+    const IndexSortString* x = a;
+    const IndexSortString* y = b;
+    i32                    order =
+        memcmp(x->chars, y->chars, x->size < y->size ? x->size : y->size);
+    if (order != 0) {
+        return order;
+    }
+    return (x->size > y->size) - (x->size < y->size);
+}
+
+i32 compare_index_uses(const void* a, const void* b) {
+    const IndexUse* x = a;
+    const IndexUse* y = b;
+    if (x->symbol_index != y->symbol_index) {
+        return x->symbol_index < y->symbol_index ? -1 : 1;
+    }
+    return (x->method_index > y->method_index) -
+           (x->method_index < y->method_index);
+}
+
+i32 compare_u32s(const void* a, const void* b) {
+    u32 x = *(const u32*)a;
+    u32 y = *(const u32*)b;
+    return (x > y) - (x < y);
+}
+
+/* NOTE: Strings are renumbered in sorted order first, so every later table
+ * sorts and searches on plain indices. The file is written next to its
+ * final path and renamed over it, so a reader never maps half an index. */
+void write_index(IndexBuilder* builder, const char* path) {
+    u32              string_count = builder->string_count;
+    IndexSortString* sorted = malloc(sizeof(IndexSortString) * string_count);
+    u32*             ranks = malloc(sizeof(u32) * string_count);
+    if ((string_count != 0) && ((sorted == NULL) || (ranks == NULL))) {
+        fprintf(stderr, "[ERROR] `malloc` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (u32 i = 0; i < string_count; ++i) {
+        sorted[i].chars = builder->strings[i].chars;
+        sorted[i].size = builder->strings[i].size;
+        sorted[i].index = i;
+    }
+    if (string_count != 0) {
+        qsort(sorted,
+              string_count,
+              sizeof(IndexSortString),
+              compare_index_strings);
+    }
+    u64 string_size = 0;
+    for (u32 i = 0; i < string_count; ++i) {
+        ranks[sorted[i].index] = i;
+        string_size += sorted[i].size;
+    }
+    for (u32 i = 0; i < builder->use_count; ++i) {
+        builder->uses[i].symbol_index = ranks[builder->uses[i].symbol_index];
+    }
+    if (builder->use_count != 0) {
+        qsort(builder->uses,
+              builder->use_count,
+              sizeof(IndexUse),
+              compare_index_uses);
+    }
+    u32 use_count = 0;
+    u32 symbol_count = 0;
+    for (u32 i = 0; i < builder->use_count; ++i) {
+        IndexUse use = builder->uses[i];
+        if ((use_count != 0) &&
+            (builder->uses[use_count - 1].symbol_index == use.symbol_index))
+        {
+            if (builder->uses[use_count - 1].method_index ==
+                use.method_index)
+            {
+                continue;
+            }
+        } else {
+            ++symbol_count;
+        }
+        builder->uses[use_count++] = use;
+    }
+    for (u32 i = 0; i < builder->class_count; ++i) {
+        builder->classes[i].string_index =
+            ranks[builder->classes[i].string_index];
+    }
+    for (u32 i = 0; i < builder->method_count; ++i) {
+        builder->methods[i].string_index =
+            ranks[builder->methods[i].string_index];
+    }
+    /* NOTE: About `SIZE_INDEX_BLOOM_BITS` bits per use, rounded up to a
+     * power of two words; three hashes keep false positives near 2%. */
+    for (u32 i = 0; i < use_count; ++i) {
+        IndexMethod method = builder->methods[builder->uses[i].method_index];
+        ++builder->classes[method.class_index].bloom_word_count;
+    }
+    u64 bloom_word_count = 0;
+    for (u32 i = 0; i < builder->class_count; ++i) {
+        IndexClass* class_ = &builder->classes[i];
+        u64 bit_count = (u64)class_->bloom_word_count * SIZE_INDEX_BLOOM_BITS;
+        u32 word_count = 1;
+        while (((u64)word_count * 64) < bit_count) {
+            word_count *= 2;
+        }
+        class_->bloom_index = (u32)bloom_word_count;
+        class_->bloom_word_count = word_count;
+        bloom_word_count += word_count;
+    }
+    IndexHeader header = {
+        .magic = INDEX_MAGIC,
+        .version = INDEX_VERSION,
+        .string_count = string_count,
+        .symbol_count = symbol_count,
+        .posting_count = use_count,
+        .class_count = builder->class_count,
+        .method_count = builder->method_count,
+    };
+    u64 size = sizeof(IndexHeader);
+    header.string_offsets = (u32)size;
+    size += sizeof(u32) * ((u64)string_count + 1);
+    header.string_bytes = (u32)size;
+    size += string_size;
+    size = (size + 3) & ~(u64)3;
+    header.symbols = (u32)size;
+    size += sizeof(IndexSymbol) * (u64)symbol_count;
+    header.postings = (u32)size;
+    size += sizeof(u32) * (u64)use_count;
+    header.classes = (u32)size;
+    size += sizeof(IndexClass) * (u64)builder->class_count;
+    header.methods = (u32)size;
+    size += sizeof(IndexMethod) * (u64)builder->method_count;
+    size = (size + 7) & ~(u64)7;
+    header.blooms = (u32)size;
+    size += sizeof(u64) * bloom_word_count;
+    if (((u64)UINT32_MAX < size) || ((u64)UINT32_MAX < bloom_word_count)) {
+        INDEX_ERROR("Index is too large");
+    }
+    header.bloom_word_count = (u32)bloom_word_count;
+    header.size = (u32)size;
+    u8* bytes = calloc(1, size);
+    if (bytes == NULL) {
+        fprintf(stderr, "[ERROR] `calloc` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(bytes, &header, sizeof(IndexHeader));
+    u32* string_offsets = (u32*)(void*)&bytes[header.string_offsets];
+    u32  string_offset = 0;
+    for (u32 i = 0; i < string_count; ++i) {
+        string_offsets[i] = string_offset;
+        memcpy(&bytes[header.string_bytes + string_offset],
+               sorted[i].chars,
+               sorted[i].size);
+        string_offset += sorted[i].size;
+    }
+    string_offsets[string_count] = string_offset;
+    IndexSymbol* symbols = (IndexSymbol*)(void*)&bytes[header.symbols];
+    u32*         postings = (u32*)(void*)&bytes[header.postings];
+    u64*         blooms = (u64*)(void*)&bytes[header.blooms];
+    u32          symbol_index = 0;
+    for (u32 i = 0; i < use_count; ++i) {
+        IndexUse use = builder->uses[i];
+        if ((i == 0) ||
+            (builder->uses[i - 1].symbol_index != use.symbol_index))
+        {
+            symbols[symbol_index].string_index = use.symbol_index;
+            symbols[symbol_index].posting_index = i;
+            symbols[symbol_index].posting_count = 0;
+            ++symbol_index;
+        }
+        ++symbols[symbol_index - 1].posting_count;
+        postings[i] = use.method_index;
+        const IndexClass* class_ =
+            &builder->classes[builder->methods[use.method_index].class_index];
+        set_index_bloom(&blooms[class_->bloom_index],
+                        class_->bloom_word_count,
+                        builder->strings[sorted[use.symbol_index].index].hash);
+    }
+    if (builder->class_count != 0) {
+        memcpy(&bytes[header.classes],
+               builder->classes,
+               sizeof(IndexClass) * (u64)builder->class_count);
+    }
+    if (builder->method_count != 0) {
+        memcpy(&bytes[header.methods],
+               builder->methods,
+               sizeof(IndexMethod) * (u64)builder->method_count);
+    }
+    u64   path_size = strlen(path) + 5;
+    char* temp_path = malloc(path_size);
+    if (temp_path == NULL) {
+        fprintf(stderr, "[ERROR] `malloc` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    snprintf(temp_path, path_size, "%s.tmp", path);
+    i32 file = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (file < 0) {
+        fprintf(stderr, "[ERROR] Unable to open `%s`\n", temp_path);
+        exit(EXIT_FAILURE);
+    }
+    for (u64 written = 0; written < size;) {
+        ssize_t n = write(file, &bytes[written], size - written);
+        if (n <= 0) {
+            fprintf(stderr, "[ERROR] `write` failed\n");
+            exit(EXIT_FAILURE);
+        }
+        written += (u64)n;
+    }
+    close(file);
+    if (rename(temp_path, path) < 0) {
+        fprintf(stderr, "[ERROR] Unable to rename `%s`\n", temp_path);
+        exit(EXIT_FAILURE);
+    }
+    printf("[INFO] %u classes, %u methods, %u symbols, %u use sites "
+           "(%u bytes)\n",
+           builder->class_count,
+           builder->method_count,
+           symbol_count,
+           use_count,
+           header.size);
+    free(temp_path);
+    free(bytes);
+    free(ranks);
+    free(sorted);
+}
+
+/* NOTE: Classes are read one after another on a single `Memory`; a
+ * malformed one is reported and its partial entries are dropped. */
+void run_index_build(const char* index_path, const char* path) {
+    Batch batch = {0};
+    if (is_jar_file(path)) {
+        set_batch_jar_jobs(&batch, path);
+    } else if (is_class_file(path)) {
+        push_batch_job(&batch, path);
+    } else {
+        set_batch_jobs(&batch, path);
+    }
+    if (batch.job_count != 0) {
+        qsort(batch.jobs,
+              batch.job_count,
+              sizeof(BatchJob),
+              compare_batch_jobs);
+    }
+    IndexBuilder builder = {0};
+    Memory*      memory = calloc(1, sizeof(Memory));
+    if (memory == NULL) {
+        fprintf(stderr, "[ERROR] `calloc` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    builder.memory = memory;
+    Visitor visitor = {
+        .context = &builder,
+        .on_class = push_index_class,
+        .on_method = push_index_method,
+        .on_instruction = push_index_use,
+    };
+    u8* buffer = NULL;
+    u32 buffer_capacity = 0;
+    for (u32 i = 0; i < batch.job_count; ++i) {
+        BatchJob* job = &batch.jobs[i];
+        const char* load_error;
+        if (job->entry.name == NULL) {
+            load_error = try_file_to_bytes(memory, job->path);
+        } else {
+            memory->file_size = job->entry.size;
+            load_error = try_jar_entry_bytes(&job->entry,
+                                             &buffer,
+                                             &buffer_capacity,
+                                             &memory->bytes);
+        }
+        if (load_error != NULL) {
+            fprintf(stderr, "[ERROR] %s: %s\n", job->path, load_error);
+            free(job->path);
+            continue;
+        }
+        u32        class_count = builder.class_count;
+        u32        method_count = builder.method_count;
+        u32        use_count = builder.use_count;
+        ParseError error =
+            visit_class(memory, memory->bytes, memory->file_size, &visitor);
+        if (error.code != PARSE_OK) {
+            fprintf(stderr,
+                    "[ERROR] %s: %s (byte %u)\n",
+                    job->path,
+                    get_parse_error_name(error.code),
+                    error.offset);
+            builder.class_count = class_count;
+            builder.method_count = method_count;
+            builder.use_count = use_count;
+        }
+        if (job->entry.name == NULL) {
+            unset_file_to_bytes(memory);
+        } else {
+            memory->bytes = NULL;
+            memory->file_size = 0;
+        }
+        free(job->path);
+    }
+    write_index(&builder, index_path);
+    free(buffer);
+    free_memory(memory);
+    free(memory);
+    free_arena(&builder.arena);
+    free(builder.strings);
+    free(builder.string_slots);
+    free(builder.uses);
+    free(builder.classes);
+    free(builder.methods);
+    free(batch.jobs);
+    if (batch.jar_bytes != NULL) {
+        unmap_file(batch.jar_bytes, batch.jar_size);
+    }
+}
+
+/* NOTE: Only the section bounds are checked up front; records are checked
+ * as a query reaches them, so opening a large index costs the same as a
+ * small one. */
+void set_index(Index* index, const char* path) {
+    index->bytes = map_file(path, &index->size);
+    if (index->size < sizeof(IndexHeader)) {
+        INDEX_ERROR("File is too small");
+    }
+    const IndexHeader* header = (const void*)index->bytes;
+    if (header->magic != INDEX_MAGIC) {
+        INDEX_ERROR("Incorrect magic constant");
+    }
+    if (header->version != INDEX_VERSION) {
+        INDEX_ERROR("Unsupported version");
+    }
+    u64 size = index->size;
+    if ((header->size != size) ||
+        (size < (header->string_offsets +
+                 (sizeof(u32) * ((u64)header->string_count + 1)))) ||
+        (size < header->string_bytes) ||
+        (size < (header->symbols +
+                 (sizeof(IndexSymbol) * (u64)header->symbol_count))) ||
+        (size <
+         (header->postings + (sizeof(u32) * (u64)header->posting_count))) ||
+        (size < (header->classes +
+                 (sizeof(IndexClass) * (u64)header->class_count))) ||
+        (size < (header->methods +
+                 (sizeof(IndexMethod) * (u64)header->method_count))) ||
+        (size <
+         (header->blooms + (sizeof(u64) * (u64)header->bloom_word_count))) ||
+        ((header->string_offsets | header->symbols | header->postings |
+          header->classes | header->methods) &
+         3) ||
+        (header->blooms & 7))
+    {
+        INDEX_ERROR("Corrupt section table");
+    }
+    index->header = header;
+    index->string_offsets =
+        (const void*)&index->bytes[header->string_offsets];
+    index->string_bytes = (const char*)&index->bytes[header->string_bytes];
+    index->symbols = (const void*)&index->bytes[header->symbols];
+    index->postings = (const void*)&index->bytes[header->postings];
+    index->classes = (const void*)&index->bytes[header->classes];
+    index->methods = (const void*)&index->bytes[header->methods];
+    index->blooms = (const void*)&index->bytes[header->blooms];
+}
+
+const char* get_index_string(const Index* index, u32 i, u32* size) {
+    if (index->header->string_count <= i) {
+        INDEX_ERROR("Corrupt string index");
+    }
+    u32 start = index->string_offsets[i];
+    u32 end = index->string_offsets[i + 1];
+    if ((end < start) ||
+        ((index->size - index->header->string_bytes) < end))
+    {
+        INDEX_ERROR("Corrupt string table");
+    }
+    *size = end - start;
+    return &index->string_bytes[start];
+}
+
+i32 compare_index_string(const Index* index,
+                         u32          i,
+                         const char*  chars,
+                         u32          size) {
+    u32         string_size;
+    const char* string = get_index_string(index, i, &string_size);
+    i32 order = memcmp(string, chars, string_size < size ? string_size : size);
+    if (order != 0) {
+        return order;
+    }
+    return (string_size > size) - (string_size < size);
+}
+
+/* NOTE: Returns the first string not less than `chars`. */
+u32 find_index_string(const Index* index, const char* chars, u32 size) {
+    u32 low = 0;
+    u32 high = index->header->string_count;
+    while (low < high) {
+        u32 middle = low + ((high - low) / 2);
+        if (compare_index_string(index, middle, chars, size) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/* NOTE: `Owner` matches every member of `Owner`, `Owner.name` every
+ * overload of `name`, and a full `Owner.name:descriptor` just itself.
+ * Matches share the query as a prefix, so they sit in one run of the sorted
+ * symbol table. With `class_name`, a class whose bloom filter rules the
+ * symbol out is never looked at. */
+void run_index_query(const char* path,
+                     const char* query,
+                     const char* class_name) {
+    Index index;
+    set_index(&index, path);
+    const IndexHeader* header = index.header;
+    u32                size = (u32)strlen(query);
+    u32                first_string = find_index_string(&index, query, size);
+    u32*               class_indices = NULL;
+    u32                class_count = 0;
+    if (class_name != NULL) {
+        u32 class_size = (u32)strlen(class_name);
+        u32 string_index = find_index_string(&index, class_name, class_size);
+        class_indices = malloc(sizeof(u32) * ((u64)header->class_count + 1));
+        if (class_indices == NULL) {
+            fprintf(stderr, "[ERROR] `malloc` failed\n");
+            exit(EXIT_FAILURE);
+        }
+        if ((string_index < header->string_count) &&
+            (compare_index_string(&index,
+                                  string_index,
+                                  class_name,
+                                  class_size) == 0))
+        {
+            for (u32 i = 0; i < header->class_count; ++i) {
+                if (index.classes[i].string_index == string_index) {
+                    class_indices[class_count++] = i;
+                }
+            }
+        }
+    }
+    u32 low = 0;
+    u32 high = header->symbol_count;
+    while (low < high) {
+        u32 middle = low + ((high - low) / 2);
+        if (index.symbols[middle].string_index < first_string) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    u32* method_indices = NULL;
+    u32  method_count = 0;
+    u32  method_capacity = 0;
+    for (u32 i = low; i < header->symbol_count; ++i) {
+        const IndexSymbol* symbol = &index.symbols[i];
+        u32                string_size;
+        const char*        string =
+            get_index_string(&index, symbol->string_index, &string_size);
+        if ((string_size < size) || (memcmp(string, query, size) != 0)) {
+            break;
+        }
+        if ((size < string_size) && (string[size] != '.') &&
+            (string[size] != ':'))
+        {
+            continue;
+        }
+        if ((header->posting_count < symbol->posting_index) ||
+            ((header->posting_count - symbol->posting_index) <
+             symbol->posting_count))
+        {
+            INDEX_ERROR("Corrupt posting list");
+        }
+        u64 hash = get_index_hash(string, string_size);
+        for (u32 j = 0; j < symbol->posting_count; ++j) {
+            u32 method_index = index.postings[symbol->posting_index + j];
+            if (header->method_count <= method_index) {
+                INDEX_ERROR("Corrupt method index");
+            }
+            if (class_name != NULL) {
+                Bool is_match = FALSE;
+                for (u32 k = 0; k < class_count; ++k) {
+                    const IndexClass* class_ =
+                        &index.classes[class_indices[k]];
+                    if ((index.methods[method_index].class_index ==
+                         class_indices[k]) &&
+                        ((u64)class_->bloom_index +
+                             class_->bloom_word_count <=
+                         header->bloom_word_count) &&
+                        is_index_bloom_set(&index.blooms[class_->bloom_index],
+                                           class_->bloom_word_count,
+                                           hash))
+                    {
+                        is_match = TRUE;
+                    }
+                }
+                if (!is_match) {
+                    continue;
+                }
+            }
+            *(u32*)push_index_item((void**)&method_indices,
+                                   &method_count,
+                                   &method_capacity,
+                                   sizeof(u32)) = method_index;
+        }
+    }
+    if (method_count != 0) {
+        qsort(method_indices, method_count, sizeof(u32), compare_u32s);
+    }
+    Buffer buffer;
+    set_buffer(&buffer, STDOUT_FILENO);
+    u32 use_count = 0;
+    for (u32 i = 0; i < method_count; ++i) {
+        if ((i != 0) && (method_indices[i - 1] == method_indices[i])) {
+            continue;
+        }
+        const IndexMethod* method = &index.methods[method_indices[i]];
+        if (header->class_count <= method->class_index) {
+            INDEX_ERROR("Corrupt class index");
+        }
+        u32         class_size;
+        const char* class_chars =
+            get_index_string(&index,
+                             index.classes[method->class_index].string_index,
+                             &class_size);
+        u32         method_size;
+        const char* method_chars =
+            get_index_string(&index, method->string_index, &method_size);
+        put_chars(&buffer, class_chars, class_size);
+        put_char(&buffer, '.');
+        put_chars(&buffer, method_chars, method_size);
+        put_char(&buffer, '\n');
+        ++use_count;
+    }
+    put_str(&buffer, "\n[INFO] ");
+    put_u32(&buffer, use_count);
+    put_str(&buffer, " methods\n");
+    free_buffer(&buffer);
+    free(method_indices);
+    free(class_indices);
+    unmap_file(index.bytes, index.size);
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef __INDEX_H__
+#define __INDEX_H__
+
+#include "batch.c"
+
+#define INDEX_MAGIC   0x584D534A
+#define INDEX_VERSION 1
+
+#define COUNT_INDEX_ITEMS        1024
+#define COUNT_INDEX_BLOOM_HASHES 3
+#define SIZE_INDEX_BLOOM_BITS    10
+
+/* NOTE: The on-disk layout. Every section is an array of plain `u32` (or,
+ * for the bloom words, `u64`) records at an offset from the start of the
+ * file, so a mapped index is queried in place. Integers are host-endian;
+ * the magic doubles as the byte order check. */
+typedef struct {
+    u32 magic;
+    u32 version;
+    u32 string_count;
+    u32 symbol_count;
+    u32 posting_count;
+    u32 class_count;
+    u32 method_count;
+    u32 bloom_word_count;
+    u32 string_offsets;
+    u32 string_bytes;
+    u32 symbols;
+    u32 postings;
+    u32 classes;
+    u32 methods;
+    u32 blooms;
+    u32 size;
+} IndexHeader;
+
+/* NOTE: Symbols are `Owner.name:descriptor` for member references and the
+ * bare name for class operands. The table is sorted by string, and strings
+ * are numbered in sorted order, so both compare as plain `u32`s. */
+typedef struct {
+    u32 string_index;
+    u32 posting_index;
+    u32 posting_count;
+} IndexSymbol;
+
+typedef struct {
+    u32 string_index;
+    u32 method_index;
+    u32 method_count;
+    u32 bloom_index;
+    u32 bloom_word_count;
+} IndexClass;
+
+typedef struct {
+    u32 class_index;
+    u32 string_index;
+} IndexMethod;
+
+typedef struct {
+    const u8*          bytes;
+    u32                size;
+    const IndexHeader* header;
+    const u32*         string_offsets;
+    const char*        string_bytes;
+    const IndexSymbol* symbols;
+    const u32*         postings;
+    const IndexClass*  classes;
+    const IndexMethod* methods;
+    const u64*         blooms;
+} Index;
+
+typedef struct {
+    const char* chars;
+    u64         hash;
+    u32         size;
+} IndexString;
+
+typedef struct {
+    u32 symbol_index;
+    u32 method_index;
+} IndexUse;
+
+/* NOTE: `string_slots` is an open addressing table of string index plus
+ * one. `symbol_indices` is per class, one slot per pool index, so a
+ * constant used many times is interned once. */
+typedef struct {
+    Arena        arena;
+    Memory*      memory;
+    Resolver     resolver;
+    IndexString* strings;
+    u32          string_count;
+    u32          string_capacity;
+    u32*         string_slots;
+    u32          slot_capacity;
+    IndexUse*    uses;
+    u32          use_count;
+    u32          use_capacity;
+    IndexClass*  classes;
+    u32          class_count;
+    u32          class_capacity;
+    IndexMethod* methods;
+    u32          method_count;
+    u32          method_capacity;
+    u32*         symbol_indices;
+} IndexBuilder;
+
+typedef struct {
+    const char* chars;
+    u32         index;
+    u32         size;
+} IndexSortString;
+
+u64  get_index_hash(const char*, u32);
+void set_index_bloom(u64*, u32, u64);
+Bool is_index_bloom_set(const u64*, u32, u64);
+
+void* push_index_item(void**, u32*, u32*, u64);
+u32   push_index_string(IndexBuilder*, const char*, u32);
+
+void push_index_class(void*, const ClassHeader*);
+void push_index_method(void*, const Method*);
+void push_index_use(void*, const Instruction*);
+
+i32  compare_index_strings(const void*, const void*);
+i32  compare_index_uses(const void*, const void*);
+i32  compare_u32s(const void*, const void*);
+void write_index(IndexBuilder*, const char*);
+void run_index_build(const char*, const char*);
+
+void        set_index(Index*, const char*);
+const char* get_index_string(const Index*, u32, u32*);
+i32         compare_index_string(const Index*, u32, const char*, u32);
+u32         find_index_string(const Index*, const char*, u32);
+void        run_index_query(const char*, const char*, const char*);
+
+#endif
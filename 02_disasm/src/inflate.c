@@ -0,0 +1,328 @@
+#ifndef __INFLATE_C__
+#define __INFLATE_C__
+
+#include "inflate.h"
+
+/* NOTE: See `https://www.rfc-editor.org/rfc/rfc1951`. Codes up to
+ * `INFLATE_FAST_BITS` long resolve with a single table load; longer ones fall
+ * back to a canonical-code walk. */
+
+static const u16 LENGTH_BASES[29] = {
+    3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+    31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+};
+
+static const u8 LENGTH_EXTRA_BITS[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+    2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0,
+};
+
+static const u16 DISTANCE_BASES[30] = {
+    1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+    33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+    1025, 1537, 2049, 3073, 4097, 6145,  8193,  12289, 16385, 24577,
+};
+
+static const u8 DISTANCE_EXTRA_BITS[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+    6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13,
+};
+
+static const u8 CODE_LENGTH_ORDER[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15,
+};
+
+u16 get_bit_reverse(u16 code, u32 bit_count) {
+    code = (u16)(((code & 0xAAAA) >> 1) | ((code & 0x5555) << 1));
+    code = (u16)(((code & 0xCCCC) >> 2) | ((code & 0x3333) << 2));
+    code = (u16)(((code & 0xF0F0) >> 4) | ((code & 0x0F0F) << 4));
+    code = (u16)(((code & 0xFF00) >> 8) | ((code & 0x00FF) << 8));
+    return (u16)(code >> (16 - bit_count));
+}
+
+Bool set_huffman(Huffman* huffman, const u8* sizes, u32 count) {
+    i32 size_counts[17] = {0};
+    i32 next_codes[16];
+    for (u32 i = 0; i < (1 << INFLATE_FAST_BITS); ++i) {
+        huffman->fast[i] = 0;
+    }
+    for (u32 i = 0; i < count; ++i) {
+        ++size_counts[sizes[i]];
+    }
+    size_counts[0] = 0;
+    i32 code = 0;
+    i32 symbol = 0;
+    for (u32 i = 1; i < 16; ++i) {
+        if ((1 << i) < size_counts[i]) {
+            return FALSE;
+        }
+        next_codes[i] = code;
+        huffman->first_code[i] = (u16)code;
+        huffman->first_symbol[i] = (u16)symbol;
+        code += size_counts[i];
+        if ((size_counts[i] != 0) && ((1 << i) <= (code - 1))) {
+            return FALSE;
+        }
+        huffman->max_code[i] = code << (16 - i);
+        code <<= 1;
+        symbol += size_counts[i];
+    }
+    huffman->max_code[16] = 0x10000;
+    for (u32 i = 0; i < count; ++i) {
+        u32 size = sizes[i];
+        if (size == 0) {
+            continue;
+        }
+        i32 j = next_codes[size] - huffman->first_code[size] +
+                huffman->first_symbol[size];
+        huffman->sizes[j] = (u8)size;
+        huffman->values[j] = (u16)i;
+        if (size <= INFLATE_FAST_BITS) {
+            u16 fast = (u16)((size << INFLATE_FAST_BITS) | i);
+            for (u32 k = get_bit_reverse((u16)next_codes[size], size);
+                 k < (1 << INFLATE_FAST_BITS);
+                 k += (1u << size))
+            {
+                huffman->fast[k] = fast;
+            }
+        }
+        ++next_codes[size];
+    }
+    return TRUE;
+}
+
+void set_inflate_bits(Inflate* inflate) {
+    while (inflate->bit_count <= 56) {
+        u64 byte = 0;
+        if (inflate->in_index < inflate->in_size) {
+            byte = inflate->in[inflate->in_index];
+        }
+        ++inflate->in_index;
+        inflate->bits |= byte << inflate->bit_count;
+        inflate->bit_count += 8;
+    }
+}
+
+u32 pop_inflate_bits(Inflate* inflate, u32 bit_count) {
+    if (inflate->bit_count < bit_count) {
+        set_inflate_bits(inflate);
+    }
+    u32 bits = (u32)(inflate->bits & ((1ull << bit_count) - 1));
+    inflate->bits >>= bit_count;
+    inflate->bit_count -= bit_count;
+    return bits;
+}
+
+i32 pop_inflate_symbol(Inflate* inflate, const Huffman* huffman) {
+    if (inflate->bit_count < 16) {
+        set_inflate_bits(inflate);
+    }
+    u16 fast = huffman->fast[inflate->bits & INFLATE_FAST_MASK];
+    if (fast != 0) {
+        u32 size = (u32)(fast >> INFLATE_FAST_BITS);
+        inflate->bits >>= size;
+        inflate->bit_count -= size;
+        return fast & INFLATE_FAST_MASK;
+    }
+    i32 code = get_bit_reverse((u16)inflate->bits, 16);
+    u32 size = INFLATE_FAST_BITS + 1;
+    for (; size < 16; ++size) {
+        if (code < huffman->max_code[size]) {
+            break;
+        }
+    }
+    if (16 <= size) {
+        return -1;
+    }
+    i32 i = (code >> (16 - size)) - huffman->first_code[size] +
+            huffman->first_symbol[size];
+    if ((COUNT_INFLATE_SYMBOLS <= i) || (huffman->sizes[i] != size)) {
+        return -1;
+    }
+    inflate->bits >>= size;
+    inflate->bit_count -= size;
+    return huffman->values[i];
+}
+
+Bool set_inflate_stored(Inflate* inflate) {
+    pop_inflate_bits(inflate, inflate->bit_count & 7);
+    u32 size = pop_inflate_bits(inflate, 16);
+    u32 complement = pop_inflate_bits(inflate, 16);
+    if ((size ^ 0xFFFF) != complement) {
+        return FALSE;
+    }
+    /* NOTE: Whole bytes still sitting in the bit buffer were read ahead from
+     * the input; hand them back before copying straight from `in`. */
+    inflate->in_index -= inflate->bit_count / 8;
+    inflate->bits = 0;
+    inflate->bit_count = 0;
+    if ((inflate->in_size < (inflate->in_index + size)) ||
+        (inflate->out_size < (inflate->out_index + size)))
+    {
+        return FALSE;
+    }
+    for (u32 i = 0; i < size; ++i) {
+        inflate->out[inflate->out_index++] = inflate->in[inflate->in_index++];
+    }
+    return TRUE;
+}
+
+Bool set_inflate_codes(Inflate* inflate) {
+    for (;;) {
+        i32 symbol = pop_inflate_symbol(inflate, &inflate->lengths);
+        if (symbol < 0) {
+            return FALSE;
+        }
+        if (symbol < 256) {
+            if (inflate->out_size <= inflate->out_index) {
+                return FALSE;
+            }
+            inflate->out[inflate->out_index++] = (u8)symbol;
+            continue;
+        }
+        if (symbol == 256) {
+            return (inflate->in_index - (inflate->bit_count / 8)) <=
+                   inflate->in_size;
+        }
+        symbol -= 257;
+        if (29 <= symbol) {
+            return FALSE;
+        }
+        u32 length = LENGTH_BASES[symbol] +
+                     pop_inflate_bits(inflate, LENGTH_EXTRA_BITS[symbol]);
+        symbol = pop_inflate_symbol(inflate, &inflate->distances);
+        if ((symbol < 0) || (30 <= symbol)) {
+            return FALSE;
+        }
+        u32 distance = DISTANCE_BASES[symbol] +
+                       pop_inflate_bits(inflate, DISTANCE_EXTRA_BITS[symbol]);
+        if ((inflate->out_index < distance) ||
+            (inflate->out_size < (inflate->out_index + length)))
+        {
+            return FALSE;
+        }
+        u8*       out = &inflate->out[inflate->out_index];
+        const u8* from = out - distance;
+        for (u32 i = 0; i < length; ++i) {
+            out[i] = from[i];
+        }
+        inflate->out_index += length;
+    }
+}
+
+Bool set_inflate_fixed(Inflate* inflate) {
+    u8 sizes[COUNT_INFLATE_SYMBOLS];
+    u32 i = 0;
+    for (; i < 144; ++i) {
+        sizes[i] = 8;
+    }
+    for (; i < 256; ++i) {
+        sizes[i] = 9;
+    }
+    for (; i < 280; ++i) {
+        sizes[i] = 7;
+    }
+    for (; i < 288; ++i) {
+        sizes[i] = 8;
+    }
+    if (!set_huffman(&inflate->lengths, sizes, 288)) {
+        return FALSE;
+    }
+    for (i = 0; i < 30; ++i) {
+        sizes[i] = 5;
+    }
+    if (!set_huffman(&inflate->distances, sizes, 30)) {
+        return FALSE;
+    }
+    return set_inflate_codes(inflate);
+}
+
+Bool set_inflate_dynamic(Inflate* inflate) {
+    u32 length_count = pop_inflate_bits(inflate, 5) + 257;
+    u32 distance_count = pop_inflate_bits(inflate, 5) + 1;
+    u32 code_length_count = pop_inflate_bits(inflate, 4) + 4;
+    u8  code_length_sizes[19] = {0};
+    for (u32 i = 0; i < code_length_count; ++i) {
+        code_length_sizes[CODE_LENGTH_ORDER[i]] =
+            (u8)pop_inflate_bits(inflate, 3);
+    }
+    Huffman code_lengths;
+    if (!set_huffman(&code_lengths, code_length_sizes, 19)) {
+        return FALSE;
+    }
+    u8  sizes[COUNT_INFLATE_SYMBOLS + 32];
+    u32 count = length_count + distance_count;
+    for (u32 i = 0; i < count;) {
+        i32 symbol = pop_inflate_symbol(inflate, &code_lengths);
+        if ((symbol < 0) || (19 <= symbol)) {
+            return FALSE;
+        }
+        if (symbol < 16) {
+            sizes[i++] = (u8)symbol;
+            continue;
+        }
+        u8  size = 0;
+        u32 repeat;
+        if (symbol == 16) {
+            if (i == 0) {
+                return FALSE;
+            }
+            size = sizes[i - 1];
+            repeat = pop_inflate_bits(inflate, 2) + 3;
+        } else if (symbol == 17) {
+            repeat = pop_inflate_bits(inflate, 3) + 3;
+        } else {
+            repeat = pop_inflate_bits(inflate, 7) + 11;
+        }
+        if (count < (i + repeat)) {
+            return FALSE;
+        }
+        for (u32 j = 0; j < repeat; ++j) {
+            sizes[i++] = size;
+        }
+    }
+    if (!set_huffman(&inflate->lengths, sizes, length_count) ||
+        !set_huffman(&inflate->distances,
+                     &sizes[length_count],
+                     distance_count))
+    {
+        return FALSE;
+    }
+    return set_inflate_codes(inflate);
+}
+
+Bool set_inflate_block(Inflate* inflate) {
+    switch (pop_inflate_bits(inflate, 2)) {
+    case 0: {
+        return set_inflate_stored(inflate);
+    }
+    case 1: {
+        return set_inflate_fixed(inflate);
+    }
+    case 2: {
+        return set_inflate_dynamic(inflate);
+    }
+    default: {
+        return FALSE;
+    }
+    }
+}
+
+Bool inflate_bytes(const u8* in, u32 in_size, u8* out, u32 out_size) {
+    Inflate inflate = {
+        .in = in,
+        .in_size = in_size,
+        .out = out,
+        .out_size = out_size,
+    };
+    Bool last_block = FALSE;
+    while (!last_block) {
+        last_block = pop_inflate_bits(&inflate, 1) == 1;
+        if (!set_inflate_block(&inflate)) {
+            return FALSE;
+        }
+    }
+    return inflate.out_index == out_size;
+}
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef __INFLATE_H__
+#define __INFLATE_H__
+
+#include "prelude.h"
+
+#define INFLATE_FAST_BITS 9
+#define INFLATE_FAST_MASK ((1 << INFLATE_FAST_BITS) - 1)
+
+#define COUNT_INFLATE_SYMBOLS 288
+
+typedef struct {
+    u16 fast[1 << INFLATE_FAST_BITS];
+    u16 first_code[16];
+    i32 max_code[17];
+    u16 first_symbol[16];
+    u8  sizes[COUNT_INFLATE_SYMBOLS];
+    u16 values[COUNT_INFLATE_SYMBOLS];
+} Huffman;
+
+typedef struct {
+    const u8* in;
+    u32       in_size;
+    u32       in_index;
+    u64       bits;
+    u32       bit_count;
+    u8*       out;
+    u32       out_size;
+    u32       out_index;
+    Huffman   lengths;
+    Huffman   distances;
+} Inflate;
+
+u16  get_bit_reverse(u16, u32);
+Bool set_huffman(Huffman*, const u8*, u32);
+
+void set_inflate_bits(Inflate*);
+u32  pop_inflate_bits(Inflate*, u32);
+i32  pop_inflate_symbol(Inflate*, const Huffman*);
+
+Bool set_inflate_stored(Inflate*);
+Bool set_inflate_codes(Inflate*);
+Bool set_inflate_fixed(Inflate*);
+Bool set_inflate_dynamic(Inflate*);
+Bool set_inflate_block(Inflate*);
+
+Bool inflate_bytes(const u8*, u32, u8*, u32);
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef __JAR_C__
+#define __JAR_C__
+
+#include "jar.h"
+
+/* NOTE: See
+ * `https://pkware.cachefly.net/webdocs/casestudies/APPNOTE.TXT`. Only the
+ * central directory is trusted for names and sizes; local headers are read
+ * just far enough to find where each entry's data starts. */
+
+u16 get_u16_le(const u8* bytes) {
+    return (u16)(bytes[0] | (bytes[1] << 8));
+}
+
+u32 get_u32_le(const u8* bytes) {
+    return (u32)bytes[0] | ((u32)bytes[1] << 8) | ((u32)bytes[2] << 16) |
+           ((u32)bytes[3] << 24);
+}
+
+Bool is_class_name(const char* name, u32 size) {
+    return (6 < size) && (memcmp(&name[size - 6], ".class", 6) == 0);
+}
+
+void set_jar_reader(JarReader* reader, const u8* bytes, u32 size) {
+    if (size < SIZE_ZIP_END) {
+        JAR_ERROR("File too small");
+    }
+    u32 end = size - SIZE_ZIP_END;
+    u32 end_min = SIZE_ZIP_COMMENT < end ? end - SIZE_ZIP_COMMENT : 0;
+    for (;; --end) {
+        if (get_u32_le(&bytes[end]) == ZIP_END_SIGNATURE) {
+            break;
+        }
+        if (end == end_min) {
+            JAR_ERROR("End of central directory not found");
+        }
+    }
+    u32 central_size = get_u32_le(&bytes[end + 12]);
+    u32 central_index = get_u32_le(&bytes[end + 16]);
+    if ((end < central_index) || ((end - central_index) < central_size)) {
+        JAR_ERROR("Central directory out of bounds");
+    }
+    reader->bytes = bytes;
+    reader->size = size;
+    reader->central_index = central_index;
+    reader->entry_count = get_u16_le(&bytes[end + 10]);
+    reader->entry_index = 0;
+}
+
+Bool pop_jar_entry(JarReader* reader, JarEntry* entry) {
+    if (reader->entry_count <= reader->entry_index) {
+        return FALSE;
+    }
+    const u8* bytes = reader->bytes;
+    u32       i = reader->central_index;
+    if ((reader->size < (i + SIZE_ZIP_CENTRAL)) ||
+        (get_u32_le(&bytes[i]) != ZIP_CENTRAL_SIGNATURE))
+    {
+        JAR_ERROR("Bad central directory entry");
+    }
+    entry->method = (ZipMethod)get_u16_le(&bytes[i + 10]);
+    entry->compressed_size = get_u32_le(&bytes[i + 20]);
+    entry->size = get_u32_le(&bytes[i + 24]);
+    entry->name_size = get_u16_le(&bytes[i + 28]);
+    u16 extra_size = get_u16_le(&bytes[i + 30]);
+    u16 comment_size = get_u16_le(&bytes[i + 32]);
+    u32 local_index = get_u32_le(&bytes[i + 42]);
+    if (reader->size < (i + SIZE_ZIP_CENTRAL + entry->name_size)) {
+        JAR_ERROR("Entry name out of bounds");
+    }
+    entry->name = (const char*)&bytes[i + SIZE_ZIP_CENTRAL];
+    entry->bytes = NULL;
+    entry->error = NULL;
+    reader->central_index =
+        i + SIZE_ZIP_CENTRAL + entry->name_size + extra_size + comment_size;
+    ++reader->entry_index;
+    /* NOTE: Past this point only the entry itself is broken, so the reader
+     * keeps going and the error is left for whoever opens the entry. */
+    if ((entry->compressed_size == 0xFFFFFFFF) ||
+        (entry->size == 0xFFFFFFFF) || (local_index == 0xFFFFFFFF))
+    {
+        entry->error = "Zip64 entries unimplemented";
+        return TRUE;
+    }
+    if ((reader->size < SIZE_ZIP_LOCAL) ||
+        ((reader->size - SIZE_ZIP_LOCAL) < local_index) ||
+        (get_u32_le(&bytes[local_index]) != ZIP_LOCAL_SIGNATURE))
+    {
+        entry->error = "Bad local header";
+        return TRUE;
+    }
+    u32 data_index = local_index + SIZE_ZIP_LOCAL +
+                     get_u16_le(&bytes[local_index + 26]) +
+                     get_u16_le(&bytes[local_index + 28]);
+    if ((reader->size < data_index) ||
+        ((reader->size - data_index) < entry->compressed_size))
+    {
+        entry->error = "Entry data out of bounds";
+        return TRUE;
+    }
+    entry->bytes = &bytes[data_index];
+    return TRUE;
+}
+
+/* NOTE: Returns `NULL`, or why the entry could not be read. Stored entries
+ * are handed back as a view into the mapping; deflated ones are inflated
+ * into `buffer`, which grows to fit and is kept by the caller for the next
+ * entry. */
+const char* try_jar_entry_bytes(const JarEntry* entry,
+                                u8**            buffer,
+                                u32*            buffer_capacity,
+                                const u8**      bytes) {
+    *bytes = NULL;
+    if (entry->error != NULL) {
+        return entry->error;
+    }
+    switch (entry->method) {
+    case ZIP_STORED: {
+        if (entry->compressed_size != entry->size) {
+            return "Stored entry size mismatch";
+        }
+        *bytes = entry->bytes;
+        return NULL;
+    }
+    case ZIP_DEFLATED: {
+        if (*buffer_capacity < entry->size) {
+            u8* new_buffer = realloc(*buffer, entry->size);
+            if (new_buffer == NULL) {
+                fprintf(stderr, "[ERROR] `realloc` failed\n");
+                exit(EXIT_FAILURE);
+            }
+            *buffer = new_buffer;
+            *buffer_capacity = entry->size;
+        }
+        if (!inflate_bytes(entry->bytes,
+                           entry->compressed_size,
+                           *buffer,
+                           entry->size))
+        {
+            return "Unable to inflate entry";
+        }
+        *bytes = *buffer;
+        return NULL;
+    }
+    default: {
+        return "Compression method unimplemented";
+    }
+    }
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef __JAR_H__
+#define __JAR_H__
+
+#include <string.h>
+
+#include "inflate.c"
+#include "memory.c"
+
+#define ZIP_END_SIGNATURE     0x06054B50
+#define ZIP_CENTRAL_SIGNATURE 0x02014B50
+#define ZIP_LOCAL_SIGNATURE   0x04034B50
+
+#define SIZE_ZIP_END     22
+#define SIZE_ZIP_CENTRAL 46
+#define SIZE_ZIP_LOCAL   30
+#define SIZE_ZIP_COMMENT 0xFFFF
+
+typedef enum {
+    ZIP_STORED = 0,
+    ZIP_DEFLATED = 8,
+} ZipMethod;
+
+typedef struct {
+    const char* name;
+    const u8*   bytes;
+    const char* error;
+    u32         compressed_size;
+    u32         size;
+    u16         name_size;
+    ZipMethod   method;
+} JarEntry;
+
+typedef struct {
+    const u8* bytes;
+    u32       size;
+    u32       central_index;
+    u16       entry_count;
+    u16       entry_index;
+} JarReader;
+
+#define JAR_ERROR(message)                             \
+    {                                                  \
+        fprintf(stderr, "[ERROR] Jar: %s\n", message); \
+        exit(EXIT_FAILURE);                            \
+    }
+
+u16 get_u16_le(const u8*);
+u32 get_u32_le(const u8*);
+
+Bool is_class_name(const char*, u32);
+
+void        set_jar_reader(JarReader*, const u8*, u32);
+Bool        pop_jar_entry(JarReader*, JarEntry*);
+const char* try_jar_entry_bytes(const JarEntry*, u8**, u32*, const u8**);
+
+#endif
@@ -0,0 +1,109 @@
+#include "jsmr.h"
+#include "memory.c"
+
+struct JsmrContext {
+    Memory memory;
+};
+
+__attribute__((constructor)) void set_jsmr_dispatch(void) {
+    set_mutf8_dispatch();
+}
+
+JsmrContext* alloc_jsmr_context(void) {
+    return calloc(1, sizeof(JsmrContext));
+}
+
+void free_jsmr_context(JsmrContext* context) {
+    if (context == NULL) {
+        return;
+    }
+    free_memory(&context->memory);
+    free(context);
+}
+
+/* NOTE: `bytes` must outlive every lookup made against this parse; UTF8
+ * results point straight into it. */
+ParseError parse_jsmr_class(JsmrContext*   context,
+                            const uint8_t* bytes,
+                            uint32_t       size) {
+    return parse_class(&context->memory, bytes, size);
+}
+
+ParseError parse_jsmr_methods(JsmrContext* context) {
+    Memory*    memory = &context->memory;
+    ParseError error = {0};
+    for (u16 i = 0; i < memory->method_count; ++i) {
+        error = parse_method(memory, &memory->methods[i]);
+        if (error.code != PARSE_OK) {
+            break;
+        }
+    }
+    return error;
+}
+
+const char* get_jsmr_error_name(uint32_t code) {
+    return get_parse_error_name(code);
+}
+
+/* NOTE: Strings come back as Modified UTF-8 views with their size in
+ * `size`; they are not NUL-terminated. */
+const char* get_jsmr_class_name(JsmrContext* context, uint16_t* size) {
+    ConstantUtf8 utf8 =
+        get_class_name(&context->memory, context->memory.this_class);
+    *size = utf8.size;
+    return (const char*)utf8.bytes;
+}
+
+uint16_t get_jsmr_method_count(JsmrContext* context) {
+    return context->memory.method_count;
+}
+
+const char* get_jsmr_method_name(JsmrContext* context,
+                                 uint16_t     index,
+                                 uint16_t*    size) {
+    Memory* memory = &context->memory;
+    if (memory->method_count <= index) {
+        *size = 0;
+        return NULL;
+    }
+    ConstantUtf8 utf8 = get_utf8(memory, memory->methods[index].name_index);
+    *size = utf8.size;
+    return (const char*)utf8.bytes;
+}
+
+const char* get_jsmr_method_descriptor(JsmrContext* context,
+                                       uint16_t     index,
+                                       uint16_t*    size) {
+    Memory* memory = &context->memory;
+    if (memory->method_count <= index) {
+        *size = 0;
+        return NULL;
+    }
+    ConstantUtf8 utf8 =
+        get_utf8(memory, memory->methods[index].descriptor_index);
+    *size = utf8.size;
+    return (const char*)utf8.bytes;
+}
+
+void set_jsmr_lazy_methods(JsmrContext* context, int lazy_methods) {
+    context->memory.lazy_methods = lazy_methods ? TRUE : FALSE;
+}
+
+/* NOTE: With more than one thread, `parse_jsmr_class` decodes the method
+ * bodies of large classes up front, across that many threads. */
+void set_jsmr_method_threads(JsmrContext* context, uint32_t thread_count) {
+    context->memory.method_thread_count = thread_count;
+}
+
+/* NOTE: Takes the same comma-separated names as `--skip-attributes`; those
+ * attributes are stepped over by size and kept only as byte ranges.
+ * Returns 0, leaving the mask as it was, if a name is not one that is
+ * decoded. */
+int set_jsmr_skip_attributes(JsmrContext* context, const char* names) {
+    u32 mask;
+    if (!get_attribute_mask(names, &mask)) {
+        return 0;
+    }
+    context->memory.attribute_skip_mask = mask;
+    return 1;
+}
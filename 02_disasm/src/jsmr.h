@@ -0,0 +1,40 @@
+#ifndef __JSMR_H__
+#define __JSMR_H__
+
+#include <stdint.h>
+
+#include "parse_error.h"
+
+/* NOTE: Public interface of `libjsmr.a`. A context owns an arena that is
+ * reset, not freed, between classes, so after the first few parses a
+ * context allocates nothing. Nothing here exits the process: a malformed
+ * class comes back as a `ParseError` with the byte offset it failed at.
+ * Contexts are not shared between threads; use one per thread. */
+
+typedef struct JsmrContext JsmrContext;
+
+/* NOTE: The archive is built with `-fvisibility=hidden` and its hidden
+ * symbols made local, so the functions marked here are all it exports;
+ * the parser's own names cannot clash with the caller's. */
+#define JSMR_API __attribute__((visibility("default")))
+
+JSMR_API JsmrContext* alloc_jsmr_context(void);
+JSMR_API void         free_jsmr_context(JsmrContext*);
+
+JSMR_API ParseError parse_jsmr_class(JsmrContext*, const uint8_t*, uint32_t);
+JSMR_API ParseError parse_jsmr_methods(JsmrContext*);
+
+JSMR_API const char* get_jsmr_error_name(uint32_t);
+JSMR_API const char* get_jsmr_class_name(JsmrContext*, uint16_t*);
+JSMR_API uint16_t    get_jsmr_method_count(JsmrContext*);
+JSMR_API const char* get_jsmr_method_name(JsmrContext*, uint16_t, uint16_t*);
+JSMR_API const char* get_jsmr_method_descriptor(JsmrContext*,
+                                                uint16_t,
+                                                uint16_t*);
+
+JSMR_API void set_jsmr_lazy_methods(JsmrContext*, int);
+JSMR_API void set_jsmr_method_threads(JsmrContext*, uint32_t);
+JSMR_API int  set_jsmr_skip_attributes(JsmrContext*, const char*);
+JSMR_API void set_jsmr_dispatch(void);
+
+#endif
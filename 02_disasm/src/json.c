@@ -0,0 +1,931 @@
+#ifndef __JSON_C__
+#define __JSON_C__
+
+#include "json.h"
+
+/* NOTE: One JSON object per line, written straight into the `Buffer` as the
+ * tokens are walked; nothing is collected first. Records come out in class
+ * file order: a `constant` per pool entry, the `class` header once the
+ * method count is known, then each `method` followed by its `instruction`s,
+ * then an `attribute` per class attribute. Every record names its class,
+ * so lines from a batch run can be split or shuffled freely. */
+
+u32 get_json_plain_prefix(const u8* bytes, u32 size) {
+    u32 i = 0;
+    for (; (i + 8) <= size; i += 8) {
+        u64 word;
+        memcpy(&word, &bytes[i], sizeof(u64));
+        /* NOTE: High bit set in any byte below 0x20, equal to `"` or equal
+         * to `\`. Neither of those two has its own high bit set, so `~word`
+         * masks out bytes above 0x7F for all three tests. */
+        u64 quote = word ^ 0x2222222222222222;
+        u64 slash = word ^ 0x5C5C5C5C5C5C5C5C;
+        u64 flags = ((word - 0x2020202020202020) |
+                     (quote - 0x0101010101010101) |
+                     (slash - 0x0101010101010101)) &
+                    ~word & 0x8080808080808080;
+        if (flags != 0) {
+            break;
+        }
+    }
+    for (; i < size; ++i) {
+        if ((bytes[i] < 0x20) || (bytes[i] == '"') || (bytes[i] == '\\')) {
+            break;
+        }
+    }
+    return i;
+}
+
+/* NOTE: Names, descriptors and resolved constants almost never need
+ * escaping, so the common case is one scan and one copy. Input is already
+ * UTF-8 (see `set_mutf8_to_utf8`), which JSON takes as is. `out` needs
+ * `(size * SIZE_JSON_ESCAPE) + 2` bytes in the worst case. */
+u32 set_json_chars(const char* chars, u32 size, char* out) {
+    const u8* bytes = (const u8*)chars;
+    u32       i = get_json_plain_prefix(bytes, size);
+    u32       n = 0;
+    out[n++] = '"';
+    memcpy(&out[n], bytes, i);
+    n += i;
+    while (i < size) {
+        u8 x = bytes[i++];
+        out[n++] = '\\';
+        switch (x) {
+        case '"':
+        case '\\': {
+            out[n++] = (char)x;
+            break;
+        }
+        case '\b': {
+            out[n++] = 'b';
+            break;
+        }
+        case '\f': {
+            out[n++] = 'f';
+            break;
+        }
+        case '\n': {
+            out[n++] = 'n';
+            break;
+        }
+        case '\r': {
+            out[n++] = 'r';
+            break;
+        }
+        case '\t': {
+            out[n++] = 't';
+            break;
+        }
+        default: {
+            out[n++] = 'u';
+            out[n++] = '0';
+            out[n++] = '0';
+            out[n++] = "0123456789abcdef"[x >> 4];
+            out[n++] = "0123456789abcdef"[x & 0xF];
+        }
+        }
+        u32 plain = get_json_plain_prefix(&bytes[i], size - i);
+        memcpy(&out[n], &bytes[i], plain);
+        n += plain;
+        i += plain;
+    }
+    out[n++] = '"';
+    return n;
+}
+
+void put_json_chars(Buffer* buffer, const char* chars, u32 size) {
+    reserve_buffer(buffer, (size * SIZE_JSON_ESCAPE) + 2);
+    buffer->size +=
+        set_json_chars(chars, size, &buffer->chars[buffer->size]);
+}
+
+/* NOTE: Called for nearly every field, so it reserves once rather than
+ * going through `put_str` three times. */
+void put_json_key(Buffer* buffer, const char* key) {
+    u32 size = (u32)strlen(key);
+    reserve_buffer(buffer, size + 4);
+    char* out = &buffer->chars[buffer->size];
+    out[0] = ',';
+    out[1] = '"';
+    memcpy(&out[2], key, size);
+    out[size + 2] = '"';
+    out[size + 3] = ':';
+    buffer->size += size + 4;
+}
+
+void put_json_u32(Buffer* buffer, const char* key, u32 value) {
+    put_json_key(buffer, key);
+    put_u32(buffer, value);
+}
+
+void put_json_i32(Buffer* buffer, const char* key, i32 value) {
+    put_json_key(buffer, key);
+    put_i32(buffer, value);
+}
+
+void put_json_string(Buffer* buffer, const char* key, const char* string) {
+    put_json_key(buffer, key);
+    if (string == NULL) {
+        put_str(buffer, "null");
+        return;
+    }
+    put_json_chars(buffer, string, (u32)strlen(string));
+}
+
+/* NOTE: Pool index zero means "none" wherever it is allowed (a missing
+ * super class, a catch-all handler), so it comes out as `null`. */
+void put_json_resolved(Buffer*     buffer,
+                       const char* key,
+                       Resolver*   resolver,
+                       u16         index) {
+    put_json_key(buffer, key);
+    if (index == 0) {
+        put_str(buffer, "null");
+        return;
+    }
+    Resolved resolved = get_resolved(resolver, index);
+    put_json_chars(buffer, resolved.chars, resolved.size);
+}
+
+/* NOTE: `class_name` is already escaped and quoted; it goes on every
+ * record, so `print_json_class` escapes it once up front. */
+void put_json_record(Buffer* buffer, const char* type, Resolved class_name) {
+    put_str(buffer, "{\"type\":\"");
+    put_str(buffer, type);
+    put_str(buffer, "\",\"class\":");
+    put_chars(buffer, class_name.chars, class_name.size);
+}
+
+const char* get_json_constant_tag_name(ConstantTag tag) {
+    switch (tag) {
+    case CONSTANT_TAG_UTF8: {
+        return "Utf8";
+    }
+    case CONSTANT_TAG_INTEGER: {
+        return "Integer";
+    }
+    case CONSTANT_TAG_FLOAT: {
+        return "Float";
+    }
+    case CONSTANT_TAG_LONG: {
+        return "Long";
+    }
+    case CONSTANT_TAG_DOUBLE: {
+        return "Double";
+    }
+    case CONSTANT_TAG_CLASS: {
+        return "Class";
+    }
+    case CONSTANT_TAG_STRING: {
+        return "String";
+    }
+    case CONSTANT_TAG_FIELD_REF: {
+        return "FieldRef";
+    }
+    case CONSTANT_TAG_METHOD_REF: {
+        return "MethodRef";
+    }
+    case CONSTANT_TAG_INTERFACE_METHOD_REF: {
+        return "InterfaceMethodRef";
+    }
+    case CONSTANT_TAG_NAME_AND_TYPE: {
+        return "NameAndType";
+    }
+    case CONSTANT_TAG_METHOD_HANDLE: {
+        return "MethodHandle";
+    }
+    case CONSTANT_TAG_METHOD_TYPE: {
+        return "MethodType";
+    }
+    case CONSTANT_TAG_DYNAMIC: {
+        return "Dynamic";
+    }
+    case CONSTANT_TAG_INVOKE_DYNAMIC: {
+        return "InvokeDynamic";
+    }
+    case CONSTANT_TAG_MODULE: {
+        return "Module";
+    }
+    case CONSTANT_TAG_PACKAGE: {
+        return "Package";
+    }
+    }
+    return NULL;
+}
+
+const char* get_json_verification_type_name(VerificationTypeTag tag) {
+    switch (tag) {
+    case VERI_TOP: {
+        return "Top";
+    }
+    case VERI_INTEGER: {
+        return "Integer";
+    }
+    case VERI_FLOAT: {
+        return "Float";
+    }
+    case VERI_DOUBLE: {
+        return "Double";
+    }
+    case VERI_LONG: {
+        return "Long";
+    }
+    case VERI_NULL: {
+        return "Null";
+    }
+    case VERI_UNINIT_THIS: {
+        return "UninitThis";
+    }
+    case VERI_OBJECT: {
+        return "Object";
+    }
+    case VERI_UNINIT: {
+        return "Uninit";
+    }
+    }
+    return NULL;
+}
+
+const char* get_json_stack_map_frame_name(StackMapTag tag) {
+    switch (tag) {
+    case STACK_MAP_SAME_FRAME: {
+        return "SameFrame";
+    }
+    case STACK_MAP_SAME_LOCALS_1_STACK_ITEM_FRAME: {
+        return "SameLocals1StackItemFrame";
+    }
+    case STACK_MAP_SAME_LOCALS_1_STACK_ITEM_FRAME_EXTENDED: {
+        return "SameLocals1StackItemFrameExtended";
+    }
+    case STACK_MAP_CHOP_FRAME: {
+        return "ChopFrame";
+    }
+    case STACK_MAP_SAME_FRAME_EXTENDED: {
+        return "SameFrameExtended";
+    }
+    case STACK_MAP_APPEND_FRAME: {
+        return "AppendFrame";
+    }
+    case STACK_MAP_FULL_FRAME: {
+        return "FullFrame";
+    }
+    }
+    return NULL;
+}
+
+const char* get_json_attribute_name(AttributeTag tag) {
+    switch (tag) {
+    case ATTRIB_CODE: {
+        return "Code";
+    }
+    case ATTRIB_LINE_NUMBER_TABLE: {
+        return "LineNumberTable";
+    }
+    case ATTRIB_STACK_MAP_TABLE: {
+        return "StackMapTable";
+    }
+    case ATTRIB_SOURCE_FILE: {
+        return "SourceFile";
+    }
+    case ATTRIB_NEST_MEMBER: {
+        return "NestMembers";
+    }
+    case ATTRIB_INNER_CLASSES: {
+        return "InnerClasses";
+    }
+    case ATTRIB_UNKNOWN: {
+        return "Unknown";
+    }
+    }
+    return NULL;
+}
+
+/* NOTE: The raw fields mirror `Constant`; `value` is the same text the
+ * `--resolve` comments show. */
+void print_json_constant(Buffer*         buffer,
+                         Resolver*       resolver,
+                         Resolved        class_name,
+                         const Constant* constant) {
+    put_json_record(buffer, "constant", class_name);
+    put_json_u32(buffer, "index", constant->index);
+    put_json_string(buffer, "tag", get_json_constant_tag_name(constant->tag));
+    switch (constant->tag) {
+    case CONSTANT_TAG_UTF8: {
+        put_json_u32(buffer, "size", constant->utf8.size);
+        break;
+    }
+    case CONSTANT_TAG_INTEGER:
+    case CONSTANT_TAG_FLOAT: {
+        put_json_u32(buffer, "bytes", constant->u32);
+        break;
+    }
+    case CONSTANT_TAG_LONG:
+    case CONSTANT_TAG_DOUBLE: {
+        put_json_u32(buffer, "high_bytes", constant->wide.high_bytes);
+        put_json_u32(buffer, "low_bytes", constant->wide.low_bytes);
+        break;
+    }
+    case CONSTANT_TAG_CLASS: {
+        put_json_u32(buffer, "name_index", constant->class_.name_index);
+        break;
+    }
+    case CONSTANT_TAG_STRING: {
+        put_json_u32(buffer, "string_index", constant->string.string_index);
+        break;
+    }
+    case CONSTANT_TAG_FIELD_REF:
+    case CONSTANT_TAG_METHOD_REF:
+    case CONSTANT_TAG_INTERFACE_METHOD_REF: {
+        put_json_u32(buffer, "class_index", constant->ref.class_index);
+        put_json_u32(buffer,
+                     "name_and_type_index",
+                     constant->ref.name_and_type_index);
+        break;
+    }
+    case CONSTANT_TAG_NAME_AND_TYPE: {
+        put_json_u32(buffer,
+                     "name_index",
+                     constant->name_and_type.name_index);
+        put_json_u32(buffer,
+                     "descriptor_index",
+                     constant->name_and_type.descriptor_index);
+        break;
+    }
+    case CONSTANT_TAG_METHOD_HANDLE: {
+        put_json_u32(buffer,
+                     "reference_kind",
+                     constant->method_handle.reference_kind);
+        put_json_u32(buffer,
+                     "reference_index",
+                     constant->method_handle.reference_index);
+        break;
+    }
+    case CONSTANT_TAG_METHOD_TYPE: {
+        put_json_u32(buffer, "descriptor_index", constant->u16);
+        break;
+    }
+    case CONSTANT_TAG_DYNAMIC:
+    case CONSTANT_TAG_INVOKE_DYNAMIC: {
+        put_json_u32(buffer,
+                     "bootstrap_method_attr_index",
+                     constant->dynamic.bootstrap_method_attr_index);
+        put_json_u32(buffer,
+                     "name_and_type_index",
+                     constant->dynamic.name_and_type_index);
+        break;
+    }
+    case CONSTANT_TAG_MODULE:
+    case CONSTANT_TAG_PACKAGE: {
+        put_json_u32(buffer, "name_index", constant->u16);
+        break;
+    }
+    }
+    put_json_resolved(buffer, "value", resolver, constant->index);
+    put_str(buffer, "}\n");
+}
+
+void print_json_verification_types(Buffer*                 buffer,
+                                   Resolver*               resolver,
+                                   const char*             key,
+                                   const VerificationType* types,
+                                   u16                     count) {
+    put_json_key(buffer, key);
+    put_char(buffer, '[');
+    for (u16 i = 0; i < count; ++i) {
+        if (i != 0) {
+            put_char(buffer, ',');
+        }
+        put_str(buffer, "{\"tag\":\"");
+        put_str(buffer, get_json_verification_type_name(types[i].tag));
+        put_char(buffer, '"');
+        switch (types[i].tag) {
+        case VERI_OBJECT: {
+            put_json_u32(buffer,
+                         "constant_pool_index",
+                         types[i].constant_pool_index);
+            put_json_resolved(buffer,
+                              "class_name",
+                              resolver,
+                              types[i].constant_pool_index);
+            break;
+        }
+        case VERI_UNINIT: {
+            put_json_u32(buffer, "offset", types[i].offset);
+            break;
+        }
+        case VERI_TOP:
+        case VERI_INTEGER:
+        case VERI_FLOAT:
+        case VERI_DOUBLE:
+        case VERI_LONG:
+        case VERI_NULL:
+        case VERI_UNINIT_THIS: {
+            break;
+        }
+        }
+        put_char(buffer, '}');
+    }
+    put_char(buffer, ']');
+}
+
+void print_json_attribute(Buffer*          buffer,
+                          Resolver*        resolver,
+                          const Attribute* attribute) {
+    Memory*  memory = resolver->memory;
+    Resolved name = get_resolved_utf8(resolver, attribute->name_index);
+    put_str(buffer, "{\"name\":");
+    put_json_chars(buffer, name.chars, name.size);
+    put_json_u32(buffer, "name_index", attribute->name_index);
+    put_json_u32(buffer, "size", attribute->size);
+    put_json_string(buffer, "kind", get_json_attribute_name(attribute->tag));
+    switch (attribute->tag) {
+    case ATTRIB_CODE: {
+        const Code* code = &attribute->code;
+        put_json_u32(buffer, "max_stack", code->max_stack);
+        put_json_u32(buffer, "max_locals", code->max_local);
+        put_json_u32(buffer, "code_size", code->byte_count);
+        put_json_key(buffer, "exception_table");
+        put_char(buffer, '[');
+        for (u16 i = 0; i < code->exception_table_count; ++i) {
+            ExceptionTable exception = code->exception_table[i];
+            if (i != 0) {
+                put_char(buffer, ',');
+            }
+            put_str(buffer, "{\"start_pc\":");
+            put_u32(buffer, exception.pc_start);
+            put_json_u32(buffer, "end_pc", exception.pc_end);
+            put_json_u32(buffer, "handler_pc", exception.pc_handler);
+            put_json_u32(buffer, "catch_type", exception.catch_type);
+            put_json_resolved(buffer,
+                              "catch_class",
+                              resolver,
+                              exception.catch_type);
+            put_char(buffer, '}');
+        }
+        put_char(buffer, ']');
+        put_json_key(buffer, "attributes");
+        put_char(buffer, '[');
+        for (u32 i = code->attributes; i != 0;
+             i = get_attribute_at(memory, i)->next_attribute)
+        {
+            if (i != code->attributes) {
+                put_char(buffer, ',');
+            }
+            print_json_attribute(buffer,
+                                 resolver,
+                                 get_attribute_at(memory, i));
+        }
+        put_char(buffer, ']');
+        break;
+    }
+    case ATTRIB_LINE_NUMBER_TABLE: {
+        put_json_key(buffer, "entries");
+        put_char(buffer, '[');
+        for (u16 i = 0; i < attribute->line_number_table.count; ++i) {
+            LineNumberEntry entry = attribute->line_number_table.entries[i];
+            if (i != 0) {
+                put_char(buffer, ',');
+            }
+            put_str(buffer, "{\"start_pc\":");
+            put_u32(buffer, entry.pc_start);
+            put_json_u32(buffer, "line_number", entry.line_number);
+            put_char(buffer, '}');
+        }
+        put_char(buffer, ']');
+        break;
+    }
+    case ATTRIB_STACK_MAP_TABLE: {
+        put_json_key(buffer, "entries");
+        put_char(buffer, '[');
+        for (u16 i = 0; i < attribute->stack_map_table.count; ++i) {
+            const StackMapEntry* entry =
+                &attribute->stack_map_table.entries[i];
+            if (i != 0) {
+                put_char(buffer, ',');
+            }
+            put_str(buffer, "{\"frame_type\":");
+            put_u32(buffer, entry->bit_tag);
+            put_json_string(buffer,
+                            "kind",
+                            get_json_stack_map_frame_name(entry->tag));
+            put_json_u32(buffer, "offset_delta", entry->offset_delta);
+            print_json_verification_types(buffer,
+                                          resolver,
+                                          "locals",
+                                          entry->local_items,
+                                          entry->local_item_count);
+            print_json_verification_types(buffer,
+                                          resolver,
+                                          "stack",
+                                          entry->stack_items,
+                                          entry->stack_item_count);
+            put_char(buffer, '}');
+        }
+        put_char(buffer, ']');
+        break;
+    }
+    case ATTRIB_SOURCE_FILE: {
+        put_json_u32(buffer, "source_file_index", attribute->u16);
+        put_json_resolved(buffer, "source_file", resolver, attribute->u16);
+        break;
+    }
+    case ATTRIB_NEST_MEMBER: {
+        put_json_key(buffer, "classes");
+        put_char(buffer, '[');
+        for (u16 i = 0; i < attribute->nest_member.count; ++i) {
+            if (i != 0) {
+                put_char(buffer, ',');
+            }
+            put_u32(buffer, attribute->nest_member.classes[i]);
+        }
+        put_char(buffer, ']');
+        break;
+    }
+    case ATTRIB_INNER_CLASSES: {
+        put_json_key(buffer, "entries");
+        put_char(buffer, '[');
+        for (u16 i = 0; i < attribute->inner_classes.count; ++i) {
+            InnerClassEntry entry = attribute->inner_classes.entries[i];
+            if (i != 0) {
+                put_char(buffer, ',');
+            }
+            put_str(buffer, "{\"inner_class_info_index\":");
+            put_u32(buffer, entry.inner_class_info_index);
+            put_json_u32(buffer,
+                         "outer_class_info_index",
+                         entry.outer_class_info_index);
+            put_json_u32(buffer, "inner_name_index", entry.inner_name_index);
+            put_json_u32(buffer,
+                         "inner_class_access_flags",
+                         entry.inner_class_access_flags);
+            put_json_resolved(buffer,
+                              "inner_class",
+                              resolver,
+                              entry.inner_class_info_index);
+            put_json_resolved(buffer,
+                              "outer_class",
+                              resolver,
+                              entry.outer_class_info_index);
+            put_json_resolved(buffer,
+                              "inner_name",
+                              resolver,
+                              entry.inner_name_index);
+            put_char(buffer, '}');
+        }
+        put_char(buffer, ']');
+        break;
+    }
+    case ATTRIB_UNKNOWN: {
+        break;
+    }
+    }
+    put_char(buffer, '}');
+}
+
+void print_json_switch(Buffer*   buffer,
+                       Memory*   memory,
+                       const u8* bytes,
+                       u32       pc,
+                       u32       byte_count,
+                       OpCode    op_code) {
+    u32 i = pc + 1 + get_switch_padding(pc);
+    put_json_i32(buffer,
+                 "default",
+                 (i32)pop_u32_at(memory, bytes, &i, byte_count));
+    if (op_code == OP_TABLESWITCH) {
+        i32 low = (i32)pop_u32_at(memory, bytes, &i, byte_count);
+        i32 high = (i32)pop_u32_at(memory, bytes, &i, byte_count);
+        put_json_i32(buffer, "low", low);
+        put_json_i32(buffer, "high", high);
+        put_json_key(buffer, "offsets");
+        put_char(buffer, '[');
+        for (i64 key = low; key <= high; ++key) {
+            if (key != low) {
+                put_char(buffer, ',');
+            }
+            put_i32(buffer, (i32)pop_u32_at(memory, bytes, &i, byte_count));
+        }
+        put_char(buffer, ']');
+        return;
+    }
+    u32 pair_count = pop_u32_at(memory, bytes, &i, byte_count);
+    put_json_key(buffer, "pairs");
+    put_char(buffer, '[');
+    for (u32 j = 0; j < pair_count; ++j) {
+        put_str(buffer, j == 0 ? "[" : ",[");
+        put_i32(buffer, (i32)pop_u32_at(memory, bytes, &i, byte_count));
+        put_char(buffer, ',');
+        put_i32(buffer, (i32)pop_u32_at(memory, bytes, &i, byte_count));
+        put_char(buffer, ']');
+    }
+    put_char(buffer, ']');
+}
+
+/* NOTE: Expects `get_op_code_size` to have accepted the instruction, so
+ * every operand read below is in range. Branches also get their absolute
+ * `target`, which is what most consumers want the offset for. */
+void print_json_instruction(Buffer*   buffer,
+                            Resolver* resolver,
+                            const u8* bytes,
+                            u32       pc,
+                            u32       byte_count) {
+    Memory*           memory = resolver->memory;
+    OpCode            op_code = bytes[pc];
+    const OpCodeInfo* info = &OP_CODES[op_code];
+    u32               i = pc + 1;
+    put_json_u32(buffer, "pc", pc);
+    put_json_u32(buffer, "opcode", (u8)op_code);
+    put_json_string(buffer, "mnemonic", info->mnemonic);
+    switch (info->layout) {
+    case OPERAND_NONE: {
+        break;
+    }
+    case OPERAND_U8: {
+        u8 operand = pop_u8_at(memory, bytes, &i, byte_count);
+        put_json_key(buffer, "operands");
+        put_char(buffer, '[');
+        put_u32(buffer, operand);
+        put_char(buffer, ']');
+        if (op_code == OP_LDC) {
+            put_json_resolved(buffer, "constant", resolver, operand);
+        }
+        break;
+    }
+    case OPERAND_I8: {
+        put_json_key(buffer, "operands");
+        put_char(buffer, '[');
+        put_i32(buffer, (i8)pop_u8_at(memory, bytes, &i, byte_count));
+        put_char(buffer, ']');
+        break;
+    }
+    case OPERAND_U16: {
+        u16 index = pop_u16_at(memory, bytes, &i, byte_count);
+        put_json_key(buffer, "operands");
+        put_char(buffer, '[');
+        put_u32(buffer, index);
+        put_char(buffer, ']');
+        put_json_resolved(buffer, "constant", resolver, index);
+        break;
+    }
+    case OPERAND_I16:
+    case OPERAND_I32: {
+        i32 offset = info->layout == OPERAND_I16
+                         ? (i16)pop_u16_at(memory, bytes, &i, byte_count)
+                         : (i32)pop_u32_at(memory, bytes, &i, byte_count);
+        put_json_key(buffer, "operands");
+        put_char(buffer, '[');
+        put_i32(buffer, offset);
+        put_char(buffer, ']');
+        if (is_branch_op_code(op_code)) {
+            put_json_i32(buffer, "target", (i32)((i64)pc + offset));
+        }
+        break;
+    }
+    case OPERAND_U8_I8: {
+        u8 index = pop_u8_at(memory, bytes, &i, byte_count);
+        i8 constant = (i8)pop_u8_at(memory, bytes, &i, byte_count);
+        put_json_key(buffer, "operands");
+        put_char(buffer, '[');
+        put_u32(buffer, index);
+        put_char(buffer, ',');
+        put_i32(buffer, constant);
+        put_char(buffer, ']');
+        break;
+    }
+    case OPERAND_U16_U8:
+    case OPERAND_U16_U8_U8: {
+        u16 index = pop_u16_at(memory, bytes, &i, byte_count);
+        u8  count = pop_u8_at(memory, bytes, &i, byte_count);
+        put_json_key(buffer, "operands");
+        put_char(buffer, '[');
+        put_u32(buffer, index);
+        put_char(buffer, ',');
+        put_u32(buffer, count);
+        put_char(buffer, ']');
+        put_json_resolved(buffer, "constant", resolver, index);
+        break;
+    }
+    case OPERAND_U16_U16: {
+        u16 index = pop_u16_at(memory, bytes, &i, byte_count);
+        put_json_key(buffer, "operands");
+        put_char(buffer, '[');
+        put_u32(buffer, index);
+        put_char(buffer, ']');
+        put_json_resolved(buffer, "constant", resolver, index);
+        break;
+    }
+    case OPERAND_TABLE_SWITCH:
+    case OPERAND_LOOKUP_SWITCH: {
+        print_json_switch(buffer, memory, bytes, pc, byte_count, op_code);
+        break;
+    }
+    case OPERAND_WIDE: {
+        OpCode modified = pop_u8_at(memory, bytes, &i, byte_count);
+        put_json_string(buffer, "modified", OP_CODES[modified].mnemonic);
+        put_json_key(buffer, "operands");
+        put_char(buffer, '[');
+        put_u32(buffer, pop_u16_at(memory, bytes, &i, byte_count));
+        if (modified == OP_IINC) {
+            put_char(buffer, ',');
+            put_i32(buffer, (i16)pop_u16_at(memory, bytes, &i, byte_count));
+        }
+        put_char(buffer, ']');
+        break;
+    }
+    }
+}
+
+ParseError print_json_method(Buffer*   buffer,
+                             Resolver* resolver,
+                             Resolved  class_name,
+                             u16       index,
+                             Method*   method) {
+    Memory*    memory = resolver->memory;
+    ParseError error = parse_method(memory, method);
+    if (error.code != PARSE_OK) {
+        return error;
+    }
+    put_json_record(buffer, "method", class_name);
+    put_json_u32(buffer, "index", index);
+    put_json_u32(buffer, "access_flags", method->access_flags);
+    put_json_u32(buffer, "name_index", method->name_index);
+    put_json_u32(buffer, "descriptor_index", method->descriptor_index);
+    put_json_resolved(buffer, "name", resolver, method->name_index);
+    put_json_resolved(buffer,
+                      "descriptor",
+                      resolver,
+                      method->descriptor_index);
+    put_json_key(buffer, "attributes");
+    put_char(buffer, '[');
+    for (u32 i = method->attributes; i != 0;
+         i = get_attribute_at(memory, i)->next_attribute)
+    {
+        if (i != method->attributes) {
+            put_char(buffer, ',');
+        }
+        print_json_attribute(buffer, resolver, get_attribute_at(memory, i));
+    }
+    put_str(buffer, "]}\n");
+    const Code* code = get_method_code(memory, method);
+    if (code == NULL) {
+        return error;
+    }
+    for (u32 pc = 0; pc < code->byte_count;) {
+        u32 size = get_op_code_size(code->bytes, pc, code->byte_count);
+        if (size == 0) {
+            error.code = PARSE_BAD_INSTRUCTION;
+            error.offset = (u32)(code->bytes - memory->bytes) + pc;
+            return error;
+        }
+        put_json_record(buffer, "instruction", class_name);
+        put_json_u32(buffer, "method", index);
+        print_json_instruction(buffer,
+                               resolver,
+                               code->bytes,
+                               pc,
+                               code->byte_count);
+        put_str(buffer, "}\n");
+        pc += size;
+    }
+    return error;
+}
+
+/* NOTE: Always resolves, whatever `--resolve` says; names are the point of
+ * feeding this to other tools, and the resolver only converts a constant
+ * the first time it is asked for. */
+ParseError print_json_class(Buffer* buffer, Memory* memory) {
+    Resolver resolver;
+    set_resolver(memory, &resolver);
+    Resolved name = get_resolved(&resolver, memory->this_class);
+    char*    chars = alloc_chars(memory, (name.size * SIZE_JSON_ESCAPE) + 2);
+    Resolved class_name = {
+        .chars = chars,
+        .size = set_json_chars(name.chars, name.size, chars),
+    };
+    u32 magic = 0;
+    u16 minor_version = 0;
+    u16 major_version = 0;
+    u16 constant_pool_count = 0;
+    u16 access_flags = 0;
+    u16 super_class = 0;
+    u16 interface_count = 0;
+    u16 field_count = 0;
+    for (TokenBlock* block = memory->first_token_block; block != NULL;
+         block = block->next_block)
+    {
+        for (u32 i = 0; i < block->count; ++i) {
+            Token* token = &block->tokens[i];
+            switch (token->tag) {
+            case MAGIC: {
+                magic = token->u32;
+                break;
+            }
+            case MINOR_VERSION: {
+                minor_version = token->u16;
+                break;
+            }
+            case MAJOR_VERSION: {
+                major_version = token->u16;
+                break;
+            }
+            case CONSTANT_POOL_COUNT: {
+                constant_pool_count = token->u16;
+                break;
+            }
+            case CONSTANT: {
+                Constant constant = get_constant(memory, token->u16);
+                print_json_constant(buffer, &resolver, class_name, &constant);
+                break;
+            }
+            case ACCESS_FLAGS: {
+                access_flags = token->u16;
+                break;
+            }
+            case THIS_CLASS: {
+                break;
+            }
+            case SUPER_CLASS: {
+                super_class = token->u16;
+                break;
+            }
+            case INTERFACE_COUNT: {
+                interface_count = token->u16;
+                break;
+            }
+            case FIELD_COUNT: {
+                field_count = token->u16;
+                break;
+            }
+            case METHOD_COUNT: {
+                put_json_record(buffer, "class", class_name);
+                put_json_u32(buffer, "magic", magic);
+                put_json_u32(buffer, "minor_version", minor_version);
+                put_json_u32(buffer, "major_version", major_version);
+                put_json_u32(buffer,
+                             "constant_pool_count",
+                             constant_pool_count);
+                put_json_u32(buffer, "access_flags", access_flags);
+                put_json_u32(buffer, "this_class", memory->this_class);
+                put_json_u32(buffer, "super_class", super_class);
+                put_json_resolved(buffer,
+                                  "super_class_name",
+                                  &resolver,
+                                  super_class);
+                put_json_u32(buffer, "interface_count", interface_count);
+                put_json_u32(buffer, "field_count", field_count);
+                put_json_u32(buffer, "method_count", token->u16);
+                put_str(buffer, "}\n");
+                break;
+            }
+            case METHOD: {
+                ParseError error =
+                    print_json_method(buffer,
+                                      &resolver,
+                                      class_name,
+                                      token->u16,
+                                      &memory->methods[token->u16]);
+                if (error.code != PARSE_OK) {
+                    return error;
+                }
+                break;
+            }
+            case ATTRIBUTE_COUNT: {
+                break;
+            }
+            case ATTRIBUTE: {
+                put_json_record(buffer, "attribute", class_name);
+                put_json_key(buffer, "attribute");
+                print_json_attribute(buffer,
+                                     &resolver,
+                                     get_attribute_at(memory, token->u32));
+                put_str(buffer, "}\n");
+                break;
+            }
+            }
+        }
+    }
+    return memory->error;
+}
+
+void print_json_file(Buffer* buffer, const char* path) {
+    put_str(buffer, "{\"type\":\"file\",\"path\":");
+    put_json_chars(buffer, path, (u32)strlen(path));
+    put_str(buffer, "}\n");
+}
+
+/* NOTE: A file that could not be read at all has no offset to give. */
+void print_json_load_error(Buffer* buffer, const char* error) {
+    put_str(buffer, "{\"type\":\"error\",\"error\":");
+    put_json_chars(buffer, error, (u32)strlen(error));
+    put_str(buffer, "}\n");
+}
+
+void print_json_error(Buffer* buffer, ParseError error) {
+    put_str(buffer, "{\"type\":\"error\",\"error\":\"");
+    put_str(buffer, get_parse_error_name(error.code));
+    put_str(buffer, "\"");
+    put_json_u32(buffer, "offset", error.offset);
+    put_str(buffer, "}\n");
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef __JSON_H__
+#define __JSON_H__
+
+#include "buffer.c"
+#include "cfg.c"
+#include "resolve.c"
+
+/* NOTE: Worst case for one input byte is `\u00XX`. */
+#define SIZE_JSON_ESCAPE 6
+
+u32  get_json_plain_prefix(const u8*, u32);
+u32  set_json_chars(const char*, u32, char*);
+void put_json_chars(Buffer*, const char*, u32);
+void put_json_key(Buffer*, const char*);
+void put_json_u32(Buffer*, const char*, u32);
+void put_json_i32(Buffer*, const char*, i32);
+void put_json_string(Buffer*, const char*, const char*);
+void put_json_resolved(Buffer*, const char*, Resolver*, u16);
+void put_json_record(Buffer*, const char*, Resolved);
+
+const char* get_json_constant_tag_name(ConstantTag);
+const char* get_json_verification_type_name(VerificationTypeTag);
+const char* get_json_stack_map_frame_name(StackMapTag);
+const char* get_json_attribute_name(AttributeTag);
+
+void print_json_constant(Buffer*, Resolver*, Resolved, const Constant*);
+void print_json_verification_types(Buffer*,
+                                   Resolver*,
+                                   const char*,
+                                   const VerificationType*,
+                                   u16);
+void print_json_attribute(Buffer*, Resolver*, const Attribute*);
+void print_json_switch(Buffer*, Memory*, const u8*, u32, u32, OpCode);
+void print_json_instruction(Buffer*, Resolver*, const u8*, u32, u32);
+
+ParseError print_json_method(Buffer*, Resolver*, Resolved, u16, Method*);
+ParseError print_json_class(Buffer*, Memory*);
+void       print_json_file(Buffer*, const char*);
+void       print_json_load_error(Buffer*, const char*);
+void       print_json_error(Buffer*, ParseError);
+
+#endif
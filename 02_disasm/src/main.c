@@ -1,39 +1,188 @@
-#include "print.c"
+#include "watch.c"
 
 i32 main(i32 n, const char** args) {
-    printf("sizeof(Constant)         : %zu\n"
-           "sizeof(Attribute)        : %zu\n"
-           "sizeof(Code)             : %zu\n"
-           "sizeof(VerificationType) : %zu\n"
-           "sizeof(StackMapEntry)    : %zu\n"
-           "sizeof(StackMapTable)    : %zu\n"
-           "sizeof(Method)           : %zu\n"
-           "sizeof(Token)            : %zu\n"
-           "sizeof(Memory)           : %zu\n"
-           "\n",
-           sizeof(Constant),
-           sizeof(Attribute),
-           sizeof(Code),
-           sizeof(VerificationType),
-           sizeof(StackMapEntry),
-           sizeof(StackMapTable),
-           sizeof(Method),
-           sizeof(Token),
-           sizeof(Memory));
-    if (n < 2) {
+    set_mutf8_dispatch();
+    View        view = {0};
+    StatsReport report = {0};
+    const char* cache_path = NULL;
+    u32         method_thread_count = 0;
+    i32         i = 1;
+    for (; i < n; ++i) {
+        if (get_eq(args[i], "--summary")) {
+            view.tag = VIEW_SUMMARY;
+        } else if (get_eq(args[i], "--op-counts")) {
+            view.tag = VIEW_OP_COUNTS;
+        } else if (get_eq(args[i], "--class-refs")) {
+            view.tag = VIEW_CLASS_REFS;
+        } else if (get_eq(args[i], "--cfg")) {
+            view.tag = VIEW_CFG;
+        } else if (get_eq(args[i], "--verify")) {
+            view.tag = VIEW_VERIFY;
+        } else if (get_eq(args[i], "--json")) {
+            view.tag = VIEW_JSON;
+        } else if (get_eq(args[i], "--resolve")) {
+            view.resolve = TRUE;
+        } else if (get_eq(args[i], "--stats")) {
+            report.text = TRUE;
+        } else if (get_eq(args[i], "--stats-trace")) {
+            if (n <= (i + 1)) {
+                fprintf(stderr, "[ERROR] No trace file provided\n");
+                exit(EXIT_FAILURE);
+            }
+            report.trace_path = args[++i];
+        } else if (get_eq(args[i], "--cache")) {
+            if (n <= (i + 1)) {
+                fprintf(stderr, "[ERROR] No cache directory provided\n");
+                exit(EXIT_FAILURE);
+            }
+            cache_path = args[++i];
+        } else if (get_eq(args[i], "--method-threads")) {
+            if (n <= (i + 1)) {
+                fprintf(stderr, "[ERROR] No thread count provided\n");
+                exit(EXIT_FAILURE);
+            }
+            method_thread_count = (u32)strtoul(args[++i], NULL, 10);
+        } else if (get_eq(args[i], "--skip-attributes")) {
+            if (n <= (i + 1)) {
+                fprintf(stderr, "[ERROR] No attribute names provided\n");
+                exit(EXIT_FAILURE);
+            }
+            if (!get_attribute_mask(args[++i], &view.attribute_skip_mask)) {
+                fprintf(stderr,
+                        "[ERROR] `%s` names an attribute that is never "
+                        "decoded\n",
+                        args[i]);
+                exit(EXIT_FAILURE);
+            }
+        } else if (get_eq(args[i], "--method")) {
+            if (n <= (i + 1)) {
+                fprintf(stderr, "[ERROR] No method name provided\n");
+                exit(EXIT_FAILURE);
+            }
+            view.tag = VIEW_METHOD;
+            view.method_name = args[++i];
+        } else {
+            break;
+        }
+    }
+    if (n <= i) {
         fprintf(stderr, "[ERROR] No file provided\n");
         exit(EXIT_FAILURE);
     }
+    set_stats_report(&report);
+    if (get_eq(args[i], "--batch")) {
+        if (n <= (i + 1)) {
+            fprintf(stderr, "[ERROR] No directory or jar provided\n");
+            exit(EXIT_FAILURE);
+        }
+        u32 worker_count = (i + 2) < n
+                               ? (u32)strtoul(args[i + 2], NULL, 10)
+                               : (u32)sysconf(_SC_NPROCESSORS_ONLN);
+        run_batch(args[i + 1], worker_count, view, cache_path, &report);
+        return EXIT_SUCCESS;
+    }
+    if (get_eq(args[i], "--watch")) {
+        if (n <= (i + 2)) {
+            fprintf(stderr, "[ERROR] No output or directory provided\n");
+            exit(EXIT_FAILURE);
+        }
+        run_watch(args[i + 1], &args[i + 2], (u32)(n - (i + 2)), view);
+        return EXIT_SUCCESS;
+    }
+    if (get_eq(args[i], "--index")) {
+        if (n <= (i + 2)) {
+            fprintf(stderr, "[ERROR] No index or directory provided\n");
+            exit(EXIT_FAILURE);
+        }
+        run_index_build(args[i + 1], args[i + 2]);
+        return EXIT_SUCCESS;
+    }
+    if (get_eq(args[i], "--query")) {
+        if (n <= (i + 2)) {
+            fprintf(stderr, "[ERROR] No index or symbol provided\n");
+            exit(EXIT_FAILURE);
+        }
+        run_index_query(args[i + 1],
+                        args[i + 2],
+                        (i + 3) < n ? args[i + 3] : NULL);
+        return EXIT_SUCCESS;
+    }
+    if (is_jar_file(args[i])) {
+        run_batch(args[i],
+                  (u32)sysconf(_SC_NPROCESSORS_ONLN),
+                  view,
+                  cache_path,
+                  &report);
+        return EXIT_SUCCESS;
+    }
+    /* NOTE: NDJSON output keeps stdout to records only. */
+    FILE* info = view.tag == VIEW_JSON ? stderr : stdout;
+    fprintf(info,
+            "sizeof(Constant)         : %zu\n"
+            "sizeof(Attribute)        : %zu\n"
+            "sizeof(Code)             : %zu\n"
+            "sizeof(VerificationType) : %zu\n"
+            "sizeof(StackMapEntry)    : %zu\n"
+            "sizeof(StackMapTable)    : %zu\n"
+            "sizeof(Method)           : %zu\n"
+            "sizeof(Token)            : %zu\n"
+            "sizeof(Memory)           : %zu\n"
+            "\n",
+            sizeof(Constant),
+            sizeof(Attribute),
+            sizeof(Code),
+            sizeof(VerificationType),
+            sizeof(StackMapEntry),
+            sizeof(StackMapTable),
+            sizeof(Method),
+            sizeof(Token),
+            sizeof(Memory));
     Memory* memory = calloc(1, sizeof(Memory));
     if (memory == NULL) {
         fprintf(stderr, "[ERROR] `calloc` failed\n");
         exit(EXIT_FAILURE);
     }
-    set_file_to_bytes(memory, args[1]);
-    set_tokens(memory);
-    print_tokens(memory);
-    printf("\n[INFO] %u bytes left!\n",
-           memory->file_size - memory->byte_index);
+    memory->lazy_methods = view.tag != VIEW_TOKENS;
+    memory->attribute_skip_mask = view.attribute_skip_mask;
+    /* NOTE: The summary never looks at a method body. */
+    if (view.tag != VIEW_SUMMARY) {
+        memory->method_thread_count = method_thread_count;
+    }
+    STATS_PUSH(memory, STATS_LOAD);
+    set_file_to_bytes(memory, args[i]);
+    STATS_POP(memory, STATS_LOAD);
+    fflush(stdout);
+    Buffer buffer;
+    set_buffer(&buffer, STDOUT_FILENO);
+    ParseError error = print_class(&buffer, memory, view);
+    STATS_CLASS(memory, &buffer);
+    free_buffer(&buffer);
+    if (error.code != PARSE_OK) {
+        fprintf(stderr,
+                "[ERROR] %s (byte %u)\n",
+                get_parse_error_name(error.code),
+                error.offset);
+        exit(EXIT_FAILURE);
+    }
+    fprintf(info,
+            "\n[INFO] %u bytes left!\n",
+            memory->file_size - memory->byte_index);
+    fprintf(info,
+            "[INFO] %lu bytes of arena used (%lu peak, %lu reserved)\n",
+            memory->arena.used,
+            memory->arena.high_water,
+            memory->arena.reserved);
+    fprintf(info,
+            "[INFO] %u attributes pooled (%zu bytes each, %u reserved)\n",
+            memory->attribute_count - 1,
+            sizeof(Attribute),
+            memory->attribute_capacity);
+#ifdef STATS
+    merge_stats(&report, memory, 0);
+#endif
+    print_stats_report(&report);
+    unset_file_to_bytes(memory);
+    free_memory(memory);
     free(memory);
     return EXIT_SUCCESS;
 }
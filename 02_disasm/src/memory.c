@@ -3,37 +3,206 @@
 
 #include "memory.h"
 
-void set_file_to_bytes(Memory* memory, const char* filename) {
-    File* file = fopen(filename, "rb");
-    if (file == NULL) {
-        fprintf(stderr, "[ERROR] Unable to open file\n");
-        exit(EXIT_FAILURE);
+static const AttributeName ATTRIBUTE_NAMES[] = {
+    {"Code", 4, ATTRIB_CODE},
+    {"LineNumberTable", 15, ATTRIB_LINE_NUMBER_TABLE},
+    {"StackMapTable", 13, ATTRIB_STACK_MAP_TABLE},
+    {"SourceFile", 10, ATTRIB_SOURCE_FILE},
+    {"NestMembers", 11, ATTRIB_NEST_MEMBER},
+    {"InnerClasses", 12, ATTRIB_INNER_CLASSES},
+};
+
+static const char* PARSE_ERROR_NAMES[COUNT_PARSE_ERRORS] = {
+    [PARSE_OK] = "No error",
+    [PARSE_OUT_OF_BOUNDS] = "Out of bounds",
+    [PARSE_OUT_OF_MEMORY] = "Out of memory",
+    [PARSE_BAD_MAGIC] = "Incorrect magic constant",
+    [PARSE_BAD_CONSTANT_TAG] = "Invalid constant tag",
+    [PARSE_BAD_CONSTANT_INDEX] = "Invalid constant pool index",
+    [PARSE_BAD_UTF8] = "Invalid Modified UTF-8",
+    [PARSE_BAD_VERIFICATION_TYPE] = "Invalid verification type",
+    [PARSE_BAD_STACK_MAP_FRAME] = "Invalid stack map frame",
+    [PARSE_BAD_METHOD_RANGE] = "Method attributes overrun their range",
+    [PARSE_BAD_INSTRUCTION] = "Invalid instruction",
+    [PARSE_BAD_CODE_OFFSET] = "Invalid code offset",
+    [PARSE_BAD_DESCRIPTOR] = "Invalid descriptor",
+    [PARSE_BAD_STACK] = "Operand stack overflow or underflow",
+    [PARSE_BAD_LOCAL] = "Invalid local variable",
+    [PARSE_BAD_TYPE] = "Incompatible operand type",
+    [PARSE_BAD_FRAME] = "Missing or incompatible stack map frame",
+};
+
+/* NOTE: Inside `parse_class` and the other `parse_*`, `visit_class` and
+ * `print_view` guards this unwinds straight back to the caller with the
+ * error recorded. Every parse path runs under one of them; the exit is
+ * only reached by a raise outside all of them. */
+_Noreturn void set_parse_error(Memory* memory, ParseErrorCode code) {
+    memory->error.code = code;
+    memory->error.offset = memory->byte_index;
+    if (memory->on_error != NULL) {
+        longjmp(*memory->on_error, 1);
+    }
+    fprintf(stderr,
+            "[ERROR] %s (byte %u)\n",
+            get_parse_error_name(code),
+            memory->byte_index);
+    exit(EXIT_FAILURE);
+}
+
+/* NOTE: For reads through a view into the file, such as a method's code;
+ * the error is reported at the file offset of `bytes[index]`. */
+_Noreturn void set_parse_error_at(Memory*        memory,
+                                  const u8*      bytes,
+                                  u32            index,
+                                  ParseErrorCode code) {
+    memory->byte_index = (u32)(bytes - memory->bytes) + index;
+    set_parse_error(memory, code);
+}
+
+const char* get_parse_error_name(u32 code) {
+    if (COUNT_PARSE_ERRORS <= code) {
+        return "?";
     }
-    fseek(file, 0, SEEK_END);
-    u32 file_size = (u32)ftell(file);
-    rewind(file);
-    if (COUNT_BYTES < file_size) {
-        fprintf(stderr, "[ERROR] File does not fit into memory\n");
+    return PARSE_ERROR_NAMES[code];
+}
+
+/* NOTE: Returns `NULL` once `*bytes` is mapped, or else why it could not
+ * be; the batch tools report that against the one file and carry on. */
+const char* try_map_file(const char* filename,
+                         const u8**  bytes,
+                         u32*        file_size) {
+    *bytes = NULL;
+    *file_size = 0;
+    i32 file = open(filename, O_RDONLY);
+    if (file < 0) {
+        return "Unable to open file";
+    }
+    struct stat file_stat;
+    if (fstat(file, &file_stat) < 0) {
+        close(file);
+        return "`fstat` failed";
+    }
+    if ((off_t)UINT32_MAX < file_stat.st_size) {
+        close(file);
+        return "File is too large";
+    }
+    if (file_stat.st_size == 0) {
+        close(file);
+        return "File is empty";
+    }
+    /* NOTE: The mapping is read-only and shared with the page cache, so
+     * nothing is copied and pages the parser never touches are never
+     * faulted in. */
+    void* mapping =
+        mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (mapping == MAP_FAILED) {
+        return "`mmap` failed";
+    }
+    *bytes = mapping;
+    *file_size = (u32)file_stat.st_size;
+    return NULL;
+}
+
+const u8* map_file(const char* filename, u32* file_size) {
+    const u8*   bytes;
+    const char* error = try_map_file(filename, &bytes, file_size);
+    if (error != NULL) {
+        fprintf(stderr, "[ERROR] %s\n", error);
         exit(EXIT_FAILURE);
     }
-    if (fread(&memory->bytes, sizeof(u8), file_size, file) != file_size) {
-        fprintf(stderr, "[ERROR] `fread` failed\n");
+    return bytes;
+}
+
+void unmap_file(const u8* bytes, u32 file_size) {
+    if (munmap((void*)(uintptr_t)bytes, file_size) < 0) {
+        fprintf(stderr, "[ERROR] `munmap` failed\n");
         exit(EXIT_FAILURE);
     }
-    memory->file_size = file_size;
-    fclose(file);
+}
+
+/* NOTE: The attribute pool is kept across classes like the arena blocks,
+ * so both go at once. */
+void free_memory(Memory* memory) {
+    for (u32 i = 0; i < memory->method_slice_count; ++i) {
+        free_memory(&memory->method_slices[i].memory);
+    }
+    free(memory->method_slices);
+    memory->method_slices = NULL;
+    memory->method_slice_count = 0;
+    free_arena(&memory->arena);
+    free(memory->attributes);
+    memory->attributes = NULL;
+    memory->attribute_count = 0;
+    memory->attribute_capacity = 0;
+}
+
+void set_file_to_bytes(Memory* memory, const char* filename) {
+    memory->bytes = map_file(filename, &memory->file_size);
+}
+
+const char* try_file_to_bytes(Memory* memory, const char* filename) {
+    return try_map_file(filename, &memory->bytes, &memory->file_size);
+}
+
+void unset_file_to_bytes(Memory* memory) {
+    if (memory->bytes == NULL) {
+        return;
+    }
+    unmap_file(memory->bytes, memory->file_size);
+    memory->bytes = NULL;
+    memory->file_size = 0;
+}
+
+u16 get_u16_be(const u8* bytes) {
+    u16 value;
+    memcpy(&value, bytes, sizeof(value));
+    return __builtin_bswap16(value);
+}
+
+u32 get_u32_be(const u8* bytes) {
+    u32 value;
+    memcpy(&value, bytes, sizeof(value));
+    return __builtin_bswap32(value);
+}
+
+/* NOTE: The one bounds check for a record of `size` bytes; a truncated
+ * record reports the offset it starts at. */
+Cursor pop_cursor(Memory* memory, u32 size) {
+    if ((memory->file_size - memory->byte_index) < size) {
+        set_parse_error(memory, PARSE_OUT_OF_BOUNDS);
+    }
+    Cursor cursor = {.bytes = &memory->bytes[memory->byte_index]};
+    memory->byte_index += size;
+    return cursor;
+}
+
+u8 pop_cursor_u8(Cursor* cursor) {
+    return *cursor->bytes++;
+}
+
+u16 pop_cursor_u16(Cursor* cursor) {
+    u16 value = get_u16_be(cursor->bytes);
+    cursor->bytes += 2;
+    return value;
+}
+
+u32 pop_cursor_u32(Cursor* cursor) {
+    u32 value = get_u32_be(cursor->bytes);
+    cursor->bytes += 4;
+    return value;
 }
 
 u8 pop_u8(Memory* memory) {
     if (memory->file_size <= memory->byte_index) {
-        OUT_OF_BOUNDS;
+        set_parse_error(memory, PARSE_OUT_OF_BOUNDS);
     }
     return memory->bytes[memory->byte_index++];
 }
 
-u8* pop_u8_ref(Memory* memory) {
+const u8* pop_u8_ref(Memory* memory) {
     if (memory->file_size <= memory->byte_index) {
-        OUT_OF_BOUNDS;
+        set_parse_error(memory, PARSE_OUT_OF_BOUNDS);
     }
     return &memory->bytes[memory->byte_index++];
 }
@@ -41,98 +210,159 @@ u8* pop_u8_ref(Memory* memory) {
 u16 pop_u16(Memory* memory) {
     u32 next_index = memory->byte_index + 2;
     if (memory->file_size < next_index) {
-        OUT_OF_BOUNDS;
+        set_parse_error(memory, PARSE_OUT_OF_BOUNDS);
     }
-    u32 i = memory->byte_index;
-    u16 bytes = (u16)((memory->bytes[i] << 8) | (memory->bytes[i + 1]));
+    u16 value = get_u16_be(&memory->bytes[memory->byte_index]);
     memory->byte_index = next_index;
-    return bytes;
+    return value;
 }
 
-u8 pop_u8_at(const u8* bytes, u32* index, u32 size) {
+u8 pop_u8_at(Memory* memory, const u8* bytes, u32* index, u32 size) {
     if (size < ((*index) + 1)) {
-        OUT_OF_BOUNDS;
+        set_parse_error_at(memory, bytes, *index, PARSE_OUT_OF_BOUNDS);
     }
     return bytes[(*index)++];
 }
 
-u16 pop_u16_at(const u8* bytes, u32* index, u32 size) {
+u16 pop_u16_at(Memory* memory, const u8* bytes, u32* index, u32 size) {
     if (size < ((*index) + 2)) {
-        OUT_OF_BOUNDS;
+        set_parse_error_at(memory, bytes, *index, PARSE_OUT_OF_BOUNDS);
+    }
+    u16 value = get_u16_be(&bytes[*index]);
+    *index += 2;
+    return value;
+}
+
+u32 pop_u32_at(Memory* memory, const u8* bytes, u32* index, u32 size) {
+    if (size < ((*index) + 4)) {
+        set_parse_error_at(memory, bytes, *index, PARSE_OUT_OF_BOUNDS);
     }
-    u8 byte1 = bytes[(*index)++];
-    u8 byte2 = bytes[(*index)++];
-    return (u16)((byte1 << 8) | byte2);
+    u32 value = get_u32_be(&bytes[*index]);
+    *index += 4;
+    return value;
 }
 
 u32 pop_u32(Memory* memory) {
     u32 next_index = memory->byte_index + 4;
     if (memory->file_size < next_index) {
-        OUT_OF_BOUNDS;
+        set_parse_error(memory, PARSE_OUT_OF_BOUNDS);
     }
-    u32 i = memory->byte_index;
-    u32 bytes = (u32)((memory->bytes[i] << 24) | (memory->bytes[i + 1] << 16) |
-                      (memory->bytes[i + 2] << 8) | memory->bytes[i + 3]);
+    u32 value = get_u32_be(&memory->bytes[memory->byte_index]);
     memory->byte_index = next_index;
+    return value;
+}
+
+void* alloc_memory_bytes(Memory* memory, u64 size, u64 align) {
+    void* bytes = alloc_bytes(&memory->arena, size, align);
+    if (bytes == NULL) {
+        set_parse_error(memory, PARSE_OUT_OF_MEMORY);
+    }
     return bytes;
 }
 
 Token* alloc_token(Memory* memory) {
-    if (COUNT_TOKENS <= memory->token_index) {
-        fprintf(stderr, "[ERROR] Unable to allocate new token\n");
-        exit(EXIT_FAILURE);
+    TokenBlock* block = memory->last_token_block;
+    if ((block == NULL) || (COUNT_TOKEN_BLOCK <= block->count)) {
+        TokenBlock* new_block =
+            alloc_memory_bytes(memory, sizeof(TokenBlock), _Alignof(Token));
+        new_block->next_block = NULL;
+        new_block->count = 0;
+        if (block == NULL) {
+            memory->first_token_block = new_block;
+        } else {
+            block->next_block = new_block;
+        }
+        memory->last_token_block = new_block;
+        block = new_block;
     }
-    return &memory->tokens[memory->token_index++];
+    ++memory->token_count;
+    return &block->tokens[block->count++];
 }
 
-Attribute* alloc_attribute(Memory* memory) {
-    if (COUNT_ATTRIBS <= memory->attribute_index) {
-        fprintf(stderr, "[ERROR] Unable to allocate new attribute\n");
-        exit(EXIT_FAILURE);
-    }
-    Attribute* attribute = &memory->attributes[memory->attribute_index++];
-    attribute->next_attribute = NULL;
-    return attribute;
+char* alloc_chars(Memory* memory, u32 count) {
+    return alloc_memory_bytes(memory, count, _Alignof(char));
 }
 
-LineNumberEntry* alloc_line_number_entry(Memory* memory) {
-    if (COUNT_LINE_NUMBER_ENTRIES <= memory->line_number_entry_index) {
-        fprintf(stderr, "[ERROR] Unable to allocate new line number entry\n");
-        exit(EXIT_FAILURE);
+AttributeTag* alloc_attribute_tags(Memory* memory, u16 count) {
+    AttributeTag* attribute_tags = alloc_memory_bytes(memory,
+                                               sizeof(AttributeTag) * count,
+                                               _Alignof(AttributeTag));
+    for (u16 i = 0; i < count; ++i) {
+        attribute_tags[i] = ATTRIB_UNKNOWN;
     }
-    return &memory->line_number_entries[memory->line_number_entry_index++];
+    return attribute_tags;
 }
 
-StackMapEntry* alloc_stack_map_entry(Memory* memory) {
-    if (COUNT_STACK_MAP_ENTRIES <= memory->stack_map_entry_index) {
-        fprintf(stderr, "[ERROR] Unable to allocate new stack map entry\n");
-        exit(EXIT_FAILURE);
-    }
-    return &memory->stack_map_entries[memory->stack_map_entry_index++];
+u8* alloc_constant_tags(Memory* memory, u16 count) {
+    u8* constant_tags = alloc_memory_bytes(memory, count, _Alignof(u8));
+    memset(constant_tags, 0, count);
+    return constant_tags;
 }
 
-VerificationType* alloc_verification_type(Memory* memory) {
-    if (COUNT_VERIFICATION_TYPES <= memory->verification_type_index) {
-        fprintf(stderr, "[ERROR] Unable to allocate new verification type\n");
-        exit(EXIT_FAILURE);
-    }
-    return &memory->verification_types[memory->verification_type_index++];
+u32* alloc_constant_values(Memory* memory, u16 count) {
+    return alloc_memory_bytes(memory, sizeof(u32) * count, _Alignof(u32));
 }
 
-u16* alloc_nest_member_class(Memory* memory) {
-    if (COUNT_NEST_MEMBER_CLASSES <= memory->nest_member_class_index) {
-        fprintf(stderr, "[ERROR] Unable to allocate new nest member class\n");
-        exit(EXIT_FAILURE);
-    }
-    return &memory->nest_member_classes[memory->nest_member_class_index++];
+Method* alloc_methods(Memory* memory, u16 count) {
+    return alloc_memory_bytes(memory,
+                              sizeof(Method) * count,
+                              _Alignof(Method));
 }
 
-InnerClassEntry* alloc_inner_class_entry(Memory* memory) {
-    if (COUNT_INNER_CLASS_ENTRIES <= memory->inner_class_entry_index) {
-        fprintf(stderr, "[ERROR] Unable to allocate new inner class entry\n");
-        exit(EXIT_FAILURE);
+/* NOTE: Growing the pool moves it, so callers hold on to the returned
+ * handle and only take a pointer with `get_attribute_at` once nothing else
+ * will be allocated in the meantime. */
+u32 alloc_attribute(Memory* memory) {
+    if (memory->attribute_capacity <= memory->attribute_count) {
+        u32 attribute_capacity = memory->attribute_capacity == 0
+                                     ? COUNT_ATTRIBUTES
+                                     : memory->attribute_capacity * 2;
+        Attribute* attributes =
+            realloc(memory->attributes,
+                    sizeof(Attribute) * (u64)attribute_capacity);
+        if (attributes == NULL) {
+            set_parse_error(memory, PARSE_OUT_OF_MEMORY);
+        }
+        memory->attributes = attributes;
+        memory->attribute_capacity = attribute_capacity;
     }
-    return &memory->inner_class_entries[memory->inner_class_entry_index++];
+    u32 handle = memory->attribute_count++;
+    memory->attributes[handle].next_attribute = 0;
+    return handle;
+}
+
+ExceptionTable* alloc_exception_table(Memory* memory, u16 count) {
+    return alloc_memory_bytes(memory,
+                       sizeof(ExceptionTable) * count,
+                       _Alignof(ExceptionTable));
+}
+
+LineNumberEntry* alloc_line_number_entries(Memory* memory, u16 count) {
+    return alloc_memory_bytes(memory,
+                       sizeof(LineNumberEntry) * count,
+                       _Alignof(LineNumberEntry));
+}
+
+StackMapEntry* alloc_stack_map_entries(Memory* memory, u16 count) {
+    return alloc_memory_bytes(memory,
+                       sizeof(StackMapEntry) * count,
+                       _Alignof(StackMapEntry));
+}
+
+VerificationType* alloc_verification_types(Memory* memory, u16 count) {
+    return alloc_memory_bytes(memory,
+                       sizeof(VerificationType) * count,
+                       _Alignof(VerificationType));
+}
+
+u16* alloc_nest_member_classes(Memory* memory, u16 count) {
+    return alloc_memory_bytes(memory, sizeof(u16) * count, _Alignof(u16));
+}
+
+InnerClassEntry* alloc_inner_class_entries(Memory* memory, u16 count) {
+    return alloc_memory_bytes(memory,
+                       sizeof(InnerClassEntry) * count,
+                       _Alignof(InnerClassEntry));
 }
 
 void push_tag_u16(Memory* memory, Tag tag, u16 value) {
@@ -141,11 +371,15 @@ void push_tag_u16(Memory* memory, Tag tag, u16 value) {
     token->u16 = value;
 }
 
-VerificationType* get_verification_type(Memory* memory) {
-    VerificationType* verification_type = alloc_verification_type(memory);
-    u8                bit_tag = pop_u8(memory);
+void set_verification_type(Memory*           memory,
+                           VerificationType* verification_type) {
+    u8 bit_tag = pop_u8(memory);
     verification_type->bit_tag = bit_tag;
+    if (VERI_UNINIT < bit_tag) {
+        set_parse_error(memory, PARSE_BAD_VERIFICATION_TYPE);
+    }
     VerificationTypeTag tag = (VerificationTypeTag)bit_tag;
+    verification_type->tag = tag;
     switch (tag) {
     case VERI_TOP:
     case VERI_INTEGER:
@@ -165,286 +399,750 @@ VerificationType* get_verification_type(Memory* memory) {
         break;
     }
     }
-    return verification_type;
 }
 
-Attribute* get_attribute(Memory* memory) {
-    Attribute* attribute = alloc_attribute(memory);
-    u16        attribute_name_index = pop_u16(memory);
-    u32        attribute_size = pop_u32(memory);
+/* NOTE: Runs once per UTF8 constant, so `get_attribute` can dispatch on the
+ * name index with a single table load. */
+AttributeTag get_attribute_tag(const u8* string, u16 size) {
+    for (u32 i = 0; i < (sizeof(ATTRIBUTE_NAMES) / sizeof(AttributeName));
+         ++i)
+    {
+        const AttributeName* attribute_name = &ATTRIBUTE_NAMES[i];
+        if ((attribute_name->size == size) &&
+            (memcmp(attribute_name->string, string, size) == 0))
+        {
+            return attribute_name->tag;
+        }
+    }
+    return ATTRIB_UNKNOWN;
+}
+
+/* NOTE: `names` is a comma-separated list such as
+ * `LineNumberTable,StackMapTable`; each sets the bit of its tag. Only names
+ * this decodes are taken, since every other attribute is already opaque. */
+Bool get_attribute_mask(const char* names, u32* mask) {
+    *mask = 0;
+    while (*names != '\0') {
+        const char* end = strchr(names, ',');
+        if (end == NULL) {
+            end = names + strlen(names);
+        }
+        AttributeTag tag =
+            get_attribute_tag((const u8*)names, (u16)(end - names));
+        if (tag == ATTRIB_UNKNOWN) {
+            return FALSE;
+        }
+        *mask |= 1u << tag;
+        names = *end == ',' ? end + 1 : end;
+    }
+    return TRUE;
+}
+
+AttributeTag get_masked_attribute_tag(const Memory* memory, u16 name_index) {
+    AttributeTag tag = memory->attribute_tags_by_index[name_index];
+    return (memory->attribute_skip_mask & (1u << tag)) != 0 ? ATTRIB_UNKNOWN
+                                                            : tag;
+}
+
+/* NOTE: A type is one byte, or three with an index. If three apiece fit
+ * before the end of the file the whole run is read off one cursor;
+ * otherwise, which only happens near the end, each one is checked. */
+VerificationType* get_verification_types(Memory* memory, u16 count) {
+    VerificationType* verification_types =
+        alloc_verification_types(memory, count);
+    if ((memory->file_size - memory->byte_index) < ((u32)count * 3)) {
+        for (u16 i = 0; i < count; ++i) {
+            set_verification_type(memory, &verification_types[i]);
+        }
+        return verification_types;
+    }
+    Cursor cursor = {.bytes = &memory->bytes[memory->byte_index]};
+    for (u16 i = 0; i < count; ++i) {
+        VerificationType* verification_type = &verification_types[i];
+        u8                bit_tag = pop_cursor_u8(&cursor);
+        verification_type->bit_tag = bit_tag;
+        verification_type->tag = (VerificationTypeTag)bit_tag;
+        if (VERI_UNINIT < bit_tag) {
+            memory->byte_index = (u32)(cursor.bytes - memory->bytes);
+            set_parse_error(memory, PARSE_BAD_VERIFICATION_TYPE);
+        }
+        if (bit_tag == VERI_OBJECT) {
+            verification_type->constant_pool_index = pop_cursor_u16(&cursor);
+        } else if (bit_tag == VERI_UNINIT) {
+            verification_type->offset = pop_cursor_u16(&cursor);
+        }
+    }
+    memory->byte_index = (u32)(cursor.bytes - memory->bytes);
+    return verification_types;
+}
+
+Attribute* get_attribute_at(const Memory* memory, u32 handle) {
+    return &memory->attributes[handle];
+}
+
+u32 get_attribute(Memory* memory) {
+    u32        handle = alloc_attribute(memory);
+    Attribute* attribute = get_attribute_at(memory, handle);
+    Cursor     cursor = pop_cursor(memory, 6);
+    u16        attribute_name_index = pop_cursor_u16(&cursor);
     attribute->name_index = attribute_name_index;
-    attribute->size = attribute_size;
-    attribute->next_attribute = NULL;
-    const char* attribute_name = memory->utf8s_by_index[attribute_name_index];
-    if (get_eq(attribute_name, "Code")) {
-        attribute->tag = ATTRIB_CODE;
-        attribute->code.max_stack = pop_u16(memory);
-        attribute->code.max_local = pop_u16(memory);
-        u32 byte_count = pop_u32(memory);
+    attribute->size = pop_cursor_u32(&cursor);
+    if (memory->constant_count <= attribute_name_index) {
+        set_parse_error(memory, PARSE_BAD_CONSTANT_INDEX);
+    }
+    AttributeTag tag = get_masked_attribute_tag(memory, attribute_name_index);
+    attribute->tag = tag;
+    STATS_COUNT_ATTRIBUTE(memory, tag);
+    switch (tag) {
+    case ATTRIB_CODE: {
+        cursor = pop_cursor(memory, 8);
+        attribute->code.max_stack = pop_cursor_u16(&cursor);
+        attribute->code.max_local = pop_cursor_u16(&cursor);
+        u32 byte_count = pop_cursor_u32(&cursor);
         attribute->code.byte_count = byte_count;
-        if (byte_count != 0) {
-            attribute->code.bytes = pop_u8_ref(memory);
-            memory->byte_index += (byte_count - 1);
+        if ((memory->file_size - memory->byte_index) < byte_count) {
+            set_parse_error(memory, PARSE_OUT_OF_BOUNDS);
         }
+        attribute->code.bytes = &memory->bytes[memory->byte_index];
+        memory->byte_index += byte_count;
         u16 exception_table_count = pop_u16(memory);
         attribute->code.exception_table_count = exception_table_count;
-        if (exception_table_count != 0) {
-            fprintf(stderr,
-                    "[ERROR] `{ ? exception_table }` unimplemented\n\n");
-            exit(EXIT_FAILURE);
+        ExceptionTable* exception_table =
+            alloc_exception_table(memory, exception_table_count);
+        attribute->code.exception_table = exception_table;
+        cursor = pop_cursor(memory, (u32)exception_table_count * 8);
+        for (u16 i = 0; i < exception_table_count; ++i) {
+            exception_table[i].pc_start = pop_cursor_u16(&cursor);
+            exception_table[i].pc_end = pop_cursor_u16(&cursor);
+            exception_table[i].pc_handler = pop_cursor_u16(&cursor);
+            exception_table[i].catch_type = pop_cursor_u16(&cursor);
         }
         u16 attribute_count = pop_u16(memory);
         attribute->code.attribute_count = attribute_count;
-        Attribute* code_attribute = NULL;
-        Attribute* code_prev_attribute = NULL;
-        for (u16 i = 0; i < attribute_count; ++i) {
-            code_attribute = get_attribute(memory);
-            if (i == 0) {
-                attribute->code.attributes = code_attribute;
-            }
-            if (code_prev_attribute != NULL) {
-                code_prev_attribute->next_attribute = code_attribute;
-            }
-            code_prev_attribute = code_attribute;
-        }
-    } else if (get_eq(attribute_name, "LineNumberTable")) {
-        attribute->tag = ATTRIB_LINE_NUMBER_TABLE;
+        u32 attributes = get_attributes(memory, attribute_count);
+        get_attribute_at(memory, handle)->code.attributes = attributes;
+        break;
+    }
+    case ATTRIB_LINE_NUMBER_TABLE: {
         u16 line_number_table_count = pop_u16(memory);
         attribute->line_number_table.count = line_number_table_count;
+        LineNumberEntry* line_number_entries =
+            alloc_line_number_entries(memory, line_number_table_count);
+        attribute->line_number_table.entries = line_number_entries;
+        cursor = pop_cursor(memory, (u32)line_number_table_count * 4);
         for (u16 i = 0; i < line_number_table_count; ++i) {
-            LineNumberEntry* line_number_entry =
-                alloc_line_number_entry(memory);
-            if (i == 0) {
-                attribute->line_number_table.entries = line_number_entry;
-            }
-            line_number_entry->pc_start = pop_u16(memory);
-            line_number_entry->line_number = pop_u16(memory);
+            line_number_entries[i].pc_start = pop_cursor_u16(&cursor);
+            line_number_entries[i].line_number = pop_cursor_u16(&cursor);
         }
-    } else if (get_eq(attribute_name, "StackMapTable")) {
-        attribute->tag = ATTRIB_STACK_MAP_TABLE;
+        break;
+    }
+    case ATTRIB_STACK_MAP_TABLE: {
         u16 stack_map_table_count = pop_u16(memory);
         attribute->stack_map_table.count = stack_map_table_count;
+        StackMapEntry* stack_map_entries =
+            alloc_stack_map_entries(memory, stack_map_table_count);
+        attribute->stack_map_table.entries = stack_map_entries;
+        /* NOTE: Each frame's tag, then the rest of its fixed prefix (the
+         * offset, and for a full frame the local count), is range-checked
+         * once; only a full frame's stack count is checked on its own,
+         * after the locals. */
         for (u16 i = 0; i < stack_map_table_count; ++i) {
-            StackMapEntry* stack_map_entry = alloc_stack_map_entry(memory);
-            if (i == 0) {
-                attribute->stack_map_table.entries = stack_map_entry;
-            }
-            u8 bit_tag = pop_u8(memory);
+            StackMapEntry* stack_map_entry = &stack_map_entries[i];
+            cursor = pop_cursor(memory, 1);
+            u8 bit_tag = pop_cursor_u8(&cursor);
             stack_map_entry->bit_tag = bit_tag;
+            stack_map_entry->local_items = NULL;
+            stack_map_entry->stack_items = NULL;
+            stack_map_entry->local_item_count = 0;
+            stack_map_entry->stack_item_count = 0;
             if (bit_tag < 64) {
                 stack_map_entry->tag = STACK_MAP_SAME_FRAME;
+                stack_map_entry->offset_delta = bit_tag;
             } else if (bit_tag < 128) {
                 stack_map_entry->tag =
                     STACK_MAP_SAME_LOCALS_1_STACK_ITEM_FRAME;
+                stack_map_entry->offset_delta = (u16)(bit_tag - 64);
+                stack_map_entry->stack_item_count = 1;
+                stack_map_entry->stack_items =
+                    get_verification_types(memory, 1);
+            } else if (bit_tag == 247) {
+                cursor = pop_cursor(memory, 2);
+                stack_map_entry->tag =
+                    STACK_MAP_SAME_LOCALS_1_STACK_ITEM_FRAME_EXTENDED;
+                stack_map_entry->offset_delta = pop_cursor_u16(&cursor);
                 stack_map_entry->stack_item_count = 1;
-                stack_map_entry->stack_items = get_verification_type(memory);
+                stack_map_entry->stack_items =
+                    get_verification_types(memory, 1);
+            } else if (bit_tag == 251) {
+                cursor = pop_cursor(memory, 2);
+                stack_map_entry->tag = STACK_MAP_SAME_FRAME_EXTENDED;
+                stack_map_entry->offset_delta = pop_cursor_u16(&cursor);
             } else if (bit_tag == 255) {
+                cursor = pop_cursor(memory, 4);
                 stack_map_entry->tag = STACK_MAP_FULL_FRAME;
-                stack_map_entry->offset_delta = pop_u16(memory);
-                u16 local_item_count = pop_u16(memory);
+                stack_map_entry->offset_delta = pop_cursor_u16(&cursor);
+                u16 local_item_count = pop_cursor_u16(&cursor);
                 stack_map_entry->local_item_count = local_item_count;
-                for (u16 j = 0; j < local_item_count; ++j) {
-                    VerificationType* verification_type =
-                        get_verification_type(memory);
-                    if (j == 0) {
-                        stack_map_entry->local_items = verification_type;
-                    }
-                }
+                stack_map_entry->local_items =
+                    get_verification_types(memory, local_item_count);
                 u16 stack_item_count = pop_u16(memory);
                 stack_map_entry->stack_item_count = stack_item_count;
-                for (u16 j = 0; j < stack_item_count; ++j) {
-                    VerificationType* verification_type =
-                        get_verification_type(memory);
-                    if (j == 0) {
-                        stack_map_entry->stack_items = verification_type;
-                    }
-                }
+                stack_map_entry->stack_items =
+                    get_verification_types(memory, stack_item_count);
             } else if ((248 <= bit_tag) && (bit_tag < 251)) {
+                cursor = pop_cursor(memory, 2);
                 stack_map_entry->tag = STACK_MAP_CHOP_FRAME;
-                stack_map_entry->offset_delta = pop_u16(memory);
+                stack_map_entry->offset_delta = pop_cursor_u16(&cursor);
             } else if ((252 <= bit_tag) && (bit_tag < 255)) {
+                cursor = pop_cursor(memory, 2);
                 stack_map_entry->tag = STACK_MAP_APPEND_FRAME;
-                stack_map_entry->offset_delta = pop_u16(memory);
+                stack_map_entry->offset_delta = pop_cursor_u16(&cursor);
                 u16 local_item_count = (u16)(bit_tag - 251);
                 stack_map_entry->local_item_count = local_item_count;
-                for (u16 j = 0; j < local_item_count; ++j) {
-                    VerificationType* verification_type =
-                        get_verification_type(memory);
-                    if (j == 0) {
-                        stack_map_entry->local_items = verification_type;
-                    }
-                }
+                stack_map_entry->local_items =
+                    get_verification_types(memory, local_item_count);
             } else {
-                fprintf(stderr,
-                        "[ERROR] `{ u8 stack_map_bit_tag (%hhu) }` "
-                        "unimplemented\n\n",
-                        bit_tag);
-                exit(EXIT_FAILURE);
+                set_parse_error(memory, PARSE_BAD_STACK_MAP_FRAME);
             }
         }
-    } else if (get_eq(attribute_name, "SourceFile")) {
-        attribute->tag = ATTRIB_SOURCE_FILE;
+        break;
+    }
+    case ATTRIB_SOURCE_FILE: {
         attribute->u16 = pop_u16(memory);
-    } else if (get_eq(attribute_name, "NestMembers")) {
-        attribute->tag = ATTRIB_NEST_MEMBER;
+        break;
+    }
+    case ATTRIB_NEST_MEMBER: {
         u16 nest_member_count = pop_u16(memory);
         attribute->nest_member.count = nest_member_count;
+        u16* nest_member_classes =
+            alloc_nest_member_classes(memory, nest_member_count);
+        attribute->nest_member.classes = nest_member_classes;
+        cursor = pop_cursor(memory, (u32)nest_member_count * 2);
         for (u16 i = 0; i < nest_member_count; ++i) {
-            u16* nest_member_class = alloc_nest_member_class(memory);
-            if (i == 0) {
-                attribute->nest_member.classes = nest_member_class;
-            }
-            *nest_member_class = pop_u16(memory);
+            nest_member_classes[i] = pop_cursor_u16(&cursor);
         }
-    } else if (get_eq(attribute_name, "InnerClasses")) {
-        attribute->tag = ATTRIB_INNER_CLASSES;
+        break;
+    }
+    case ATTRIB_INNER_CLASSES: {
         u16 inner_classes_count = pop_u16(memory);
         attribute->inner_classes.count = inner_classes_count;
+        InnerClassEntry* inner_class_entries =
+            alloc_inner_class_entries(memory, inner_classes_count);
+        attribute->inner_classes.entries = inner_class_entries;
+        cursor = pop_cursor(memory, (u32)inner_classes_count * 8);
         for (u16 i = 0; i < inner_classes_count; ++i) {
-            InnerClassEntry* inner_class_entry =
-                alloc_inner_class_entry(memory);
-            if (i == 0) {
-                attribute->inner_classes.entries = inner_class_entry;
-            }
-            inner_class_entry->inner_class_info_index = pop_u16(memory);
-            inner_class_entry->outer_class_info_index = pop_u16(memory);
-            inner_class_entry->inner_name_index = pop_u16(memory);
-            inner_class_entry->inner_class_access_flags = pop_u16(memory);
-        }
-    } else {
-        fprintf(stderr,
-                "[DEBUG] %hu\n[DEBUG] %s\n"
-                "[ERROR] `{ ? attribute }` unimplemented\n\n",
-                attribute_name_index,
-                attribute_name);
-        exit(EXIT_FAILURE);
+            InnerClassEntry* inner_class_entry = &inner_class_entries[i];
+            inner_class_entry->inner_class_info_index =
+                pop_cursor_u16(&cursor);
+            inner_class_entry->outer_class_info_index =
+                pop_cursor_u16(&cursor);
+            inner_class_entry->inner_name_index = pop_cursor_u16(&cursor);
+            inner_class_entry->inner_class_access_flags =
+                pop_cursor_u16(&cursor);
+        }
+        break;
+    }
+    case ATTRIB_UNKNOWN: {
+        if ((memory->file_size - memory->byte_index) < attribute->size) {
+            set_parse_error(memory, PARSE_OUT_OF_BOUNDS);
+        }
+        attribute->opaque.bytes = &memory->bytes[memory->byte_index];
+        memory->byte_index += attribute->size;
+        break;
+    }
+    }
+    return handle;
+}
+
+u32 get_attributes(Memory* memory, u16 count) {
+    u32 first_attribute = 0;
+    u32 prev_attribute = 0;
+    for (u16 i = 0; i < count; ++i) {
+        u32 attribute = get_attribute(memory);
+        if (prev_attribute == 0) {
+            first_attribute = attribute;
+        } else {
+            get_attribute_at(memory, prev_attribute)->next_attribute =
+                attribute;
+        }
+        prev_attribute = attribute;
+    }
+    return first_attribute;
+}
+
+/* NOTE: Walks `count` attributes using only their `u32 AttributeSize`
+ * headers, so a method body costs six bytes of reading per attribute no
+ * matter how large its `Code` is. */
+void skip_attributes(Memory* memory, u16 count) {
+    for (u16 i = 0; i < count; ++i) {
+        Cursor cursor = pop_cursor(memory, 6);
+        cursor.bytes += 2;
+        u32 attribute_size = pop_cursor_u32(&cursor);
+        if ((memory->file_size - memory->byte_index) < attribute_size) {
+            set_parse_error(memory, PARSE_OUT_OF_BOUNDS);
+        }
+        memory->byte_index += attribute_size;
+    }
+}
+
+/* NOTE: Nothing reads fields beyond their count, so each is stepped over
+ * by its header and attribute sizes, as `visit_members` does. */
+void skip_fields(Memory* memory, u16 count) {
+    for (u16 i = 0; i < count; ++i) {
+        Cursor cursor = pop_cursor(memory, 8);
+        cursor.bytes += 6;
+        skip_attributes(memory, pop_cursor_u16(&cursor));
+    }
+}
+
+void set_method_attributes(Memory* memory, Method* method) {
+    if ((method->attributes != 0) || (method->attribute_count == 0)) {
+        return;
+    }
+    u32 byte_index = memory->byte_index;
+    memory->byte_index = method->offset;
+    STATS_PUSH(memory, STATS_ATTRIBUTES);
+    u32 attributes = get_attributes(memory, method->attribute_count);
+    STATS_POP(memory, STATS_ATTRIBUTES);
+    if (memory->byte_index != (method->offset + method->size)) {
+        set_parse_error(memory, PARSE_BAD_METHOD_RANGE);
+    }
+    /* NOTE: Only a method that decoded cleanly is marked as decoded, so a
+     * slice thread's failure is raised again on the calling thread. */
+    method->attributes = attributes;
+    memory->byte_index = byte_index;
+}
+
+ConstantTag get_constant_tag(Memory* memory, u16 index) {
+    if (memory->constant_count <= index) {
+        return 0;
+    }
+    return (ConstantTag)memory->constant_tags[index];
+}
+
+/* NOTE: Unpacks the slot written by `set_constant`; see there for the
+ * layout of each tag. */
+Constant get_constant(Memory* memory, u16 index) {
+    Constant constant = {.index = index};
+    constant.tag = get_constant_tag(memory, index);
+    u32 value = constant.tag == 0 ? 0 : memory->constant_values[index];
+    switch (constant.tag) {
+    case CONSTANT_TAG_UTF8: {
+        constant.utf8 = get_utf8(memory, index);
+        break;
+    }
+    case CONSTANT_TAG_INTEGER:
+    case CONSTANT_TAG_FLOAT: {
+        constant.u32 = value;
+        break;
+    }
+    case CONSTANT_TAG_LONG:
+    case CONSTANT_TAG_DOUBLE: {
+        constant.wide.high_bytes = value;
+        constant.wide.low_bytes = memory->constant_values[index + 1];
+        break;
+    }
+    case CONSTANT_TAG_CLASS: {
+        constant.class_.name_index = (u16)value;
+        break;
+    }
+    case CONSTANT_TAG_STRING: {
+        constant.string.string_index = (u16)value;
+        break;
+    }
+    case CONSTANT_TAG_FIELD_REF:
+    case CONSTANT_TAG_METHOD_REF:
+    case CONSTANT_TAG_INTERFACE_METHOD_REF: {
+        constant.ref.class_index = (u16)(value >> 16);
+        constant.ref.name_and_type_index = (u16)value;
+        break;
+    }
+    case CONSTANT_TAG_NAME_AND_TYPE: {
+        constant.name_and_type.name_index = (u16)(value >> 16);
+        constant.name_and_type.descriptor_index = (u16)value;
+        break;
+    }
+    case CONSTANT_TAG_METHOD_HANDLE: {
+        constant.method_handle.reference_kind = (u8)(value >> 16);
+        constant.method_handle.reference_index = (u16)value;
+        break;
+    }
+    case CONSTANT_TAG_METHOD_TYPE:
+    case CONSTANT_TAG_MODULE:
+    case CONSTANT_TAG_PACKAGE: {
+        constant.u16 = (u16)value;
+        break;
+    }
+    case CONSTANT_TAG_DYNAMIC:
+    case CONSTANT_TAG_INVOKE_DYNAMIC: {
+        constant.dynamic.bootstrap_method_attr_index = (u16)(value >> 16);
+        constant.dynamic.name_and_type_index = (u16)value;
+        break;
+    }
+    }
+    return constant;
+}
+
+ConstantUtf8 get_utf8(Memory* memory, u16 index) {
+    if (get_constant_tag(memory, index) != CONSTANT_TAG_UTF8) {
+        return (ConstantUtf8){.bytes = (const u8*)"?", .size = 1};
+    }
+    u32 offset = memory->constant_values[index];
+    return (ConstantUtf8){
+        .bytes = &memory->bytes[offset + 2],
+        .size = get_u16_be(&memory->bytes[offset]),
+    };
+}
+
+ConstantUtf8 get_class_name(Memory* memory, u16 class_index) {
+    if (get_constant_tag(memory, class_index) != CONSTANT_TAG_CLASS) {
+        return (ConstantUtf8){.bytes = (const u8*)"?", .size = 1};
+    }
+    return get_utf8(memory, (u16)memory->constant_values[class_index]);
+}
+
+/* NOTE: Member references and both dynamic constants keep their
+ * `NameAndType` index in the low half of the slot. */
+ConstantNameAndType get_name_and_type(Memory* memory, u16 index) {
+    ConstantTag tag = get_constant_tag(memory, index);
+    if ((tag != CONSTANT_TAG_FIELD_REF) && (tag != CONSTANT_TAG_METHOD_REF) &&
+        (tag != CONSTANT_TAG_INTERFACE_METHOD_REF) &&
+        (tag != CONSTANT_TAG_DYNAMIC) && (tag != CONSTANT_TAG_INVOKE_DYNAMIC))
+    {
+        return (ConstantNameAndType){0};
+    }
+    index = (u16)memory->constant_values[index];
+    if (get_constant_tag(memory, index) != CONSTANT_TAG_NAME_AND_TYPE) {
+        return (ConstantNameAndType){0};
+    }
+    u32 value = memory->constant_values[index];
+    return (ConstantNameAndType){
+        .name_index = (u16)(value >> 16),
+        .descriptor_index = (u16)value,
+    };
+}
+
+Bool get_utf8_eq(ConstantUtf8 utf8, const char* string) {
+    return (strlen(string) == utf8.size) &&
+           (memcmp(utf8.bytes, string, utf8.size) == 0);
+}
+
+void set_constant_pool(Memory* memory, u16 count) {
+    memory->constant_tags = alloc_constant_tags(memory, count);
+    memory->constant_values = alloc_constant_values(memory, count);
+    memory->attribute_tags_by_index = alloc_attribute_tags(memory, count);
+    memory->constant_count = count;
+}
+
+Bool is_wide_constant(ConstantTag tag) {
+    return (tag == CONSTANT_TAG_LONG) || (tag == CONSTANT_TAG_DOUBLE);
+}
+
+/* NOTE: Every constant packs into the `u32` of its slot: UTF8 keeps the
+ * file offset of its length, two-index kinds put the first index in the
+ * high half, a method handle puts its kind there, and eight-byte constants
+ * spill their low word into the unusable slot after them. The tag is
+ * stored last, so a slot that failed to parse still reads as empty. */
+ConstantTag set_constant(Memory* memory, u16 index) {
+    u32*        value = &memory->constant_values[index];
+    ConstantTag tag = (ConstantTag)pop_u8(memory);
+    switch (tag) {
+    case CONSTANT_TAG_UTF8: {
+        *value = memory->byte_index;
+        u16 utf8_size = pop_u16(memory);
+        if ((memory->file_size - memory->byte_index) < utf8_size) {
+            set_parse_error(memory, PARSE_OUT_OF_BOUNDS);
+        }
+        const u8* utf8 = &memory->bytes[memory->byte_index];
+        if (!is_mutf8_valid(utf8, utf8_size)) {
+            set_parse_error(memory, PARSE_BAD_UTF8);
+        }
+        memory->byte_index += utf8_size;
+        memory->attribute_tags_by_index[index] =
+            get_attribute_tag(utf8, utf8_size);
+        break;
+    }
+    case CONSTANT_TAG_INTEGER:
+    case CONSTANT_TAG_FLOAT: {
+        Cursor cursor = pop_cursor(memory, 4);
+        *value = pop_cursor_u32(&cursor);
+        break;
+    }
+    case CONSTANT_TAG_LONG:
+    case CONSTANT_TAG_DOUBLE: {
+        Cursor cursor = pop_cursor(memory, 8);
+        u32    high_bytes = pop_cursor_u32(&cursor);
+        u32    low_bytes = pop_cursor_u32(&cursor);
+        /* NOTE: Eight-byte constants take up two slots; the second
+         * is unusable and keeps a zero tag. */
+        if (memory->constant_count <= (index + 1)) {
+            set_parse_error(memory, PARSE_BAD_CONSTANT_INDEX);
+        }
+        value[0] = high_bytes;
+        value[1] = low_bytes;
+        break;
+    }
+    case CONSTANT_TAG_CLASS:
+    case CONSTANT_TAG_STRING:
+    case CONSTANT_TAG_METHOD_TYPE:
+    case CONSTANT_TAG_MODULE:
+    case CONSTANT_TAG_PACKAGE: {
+        *value = pop_u16(memory);
+        break;
+    }
+    case CONSTANT_TAG_FIELD_REF:
+    case CONSTANT_TAG_METHOD_REF:
+    case CONSTANT_TAG_INTERFACE_METHOD_REF:
+    case CONSTANT_TAG_NAME_AND_TYPE:
+    case CONSTANT_TAG_DYNAMIC:
+    case CONSTANT_TAG_INVOKE_DYNAMIC: {
+        /* NOTE: Both indices, already in the order the slot keeps them. */
+        Cursor cursor = pop_cursor(memory, 4);
+        *value = pop_cursor_u32(&cursor);
+        break;
+    }
+    case CONSTANT_TAG_METHOD_HANDLE: {
+        Cursor cursor = pop_cursor(memory, 3);
+        *value = (u32)pop_cursor_u8(&cursor) << 16;
+        *value |= pop_cursor_u16(&cursor);
+        break;
+    }
+    default: {
+        set_parse_error(memory, PARSE_BAD_CONSTANT_TAG);
+    }
+    }
+    memory->constant_tags[index] = (u8)tag;
+    STATS_COUNT_CONSTANT(memory, tag);
+    return tag;
+}
+
+void* run_method_slice(void* context) {
+    MethodSlice* slice = context;
+    Memory*      memory = &slice->memory;
+    for (u16 i = slice->first_method; i < slice->method_end; ++i) {
+        /* NOTE: A method that fails is left undecoded; decoding it again
+         * on the calling thread raises the same error there. */
+        parse_method(memory, &memory->methods[i]);
+    }
+    return NULL;
+}
+
+void set_method_slice(const Memory* memory, MethodSlice* slice) {
+    Memory* slice_memory = &slice->memory;
+    reset_arena(&slice_memory->arena);
+    slice_memory->bytes = memory->bytes;
+    slice_memory->file_size = memory->file_size;
+    slice_memory->byte_index = 0;
+    slice_memory->constant_tags = memory->constant_tags;
+    slice_memory->constant_values = memory->constant_values;
+    slice_memory->attribute_tags_by_index = memory->attribute_tags_by_index;
+    slice_memory->constant_count = memory->constant_count;
+    slice_memory->this_class = memory->this_class;
+    slice_memory->major_version = memory->major_version;
+    slice_memory->methods = memory->methods;
+    slice_memory->method_count = memory->method_count;
+    slice_memory->attribute_count = 1;
+    slice_memory->attribute_skip_mask = memory->attribute_skip_mask;
+    slice_memory->lazy_methods = TRUE;
+    slice_memory->on_error = NULL;
+}
+
+/* NOTE: Appends the slice's attribute pool to the parent's. Handles are
+ * indices, so moving a pool is a copy plus one add per link. */
+void merge_method_slice(Memory* memory, MethodSlice* slice) {
+    Memory* slice_memory = &slice->memory;
+    u32     base = memory->attribute_count - 1;
+    for (u32 i = 1; i < slice_memory->attribute_count; ++i) {
+        Attribute* attribute =
+            get_attribute_at(memory, alloc_attribute(memory));
+        *attribute = slice_memory->attributes[i];
+        if (attribute->next_attribute != 0) {
+            attribute->next_attribute += base;
+        }
+        if ((attribute->tag == ATTRIB_CODE) &&
+            (attribute->code.attributes != 0))
+        {
+            attribute->code.attributes += base;
+        }
+    }
+    for (u16 i = slice->first_method; i < slice->method_end; ++i) {
+        if (memory->methods[i].attributes != 0) {
+            memory->methods[i].attributes += base;
+        }
+    }
+#ifdef STATS
+    Stats* stats = &slice_memory->stats;
+    for (u32 i = 0; i < COUNT_STATS_ATTRIBUTE_TAGS; ++i) {
+        memory->stats.attribute_tag_counts[i] +=
+            stats->attribute_tag_counts[i];
+    }
+    free_stats(stats);
+    *stats = (Stats){0};
+#endif
+}
+
+/* NOTE: Decodes the method bodies found by the framing pass in
+ * `set_tokens` on up to `method_thread_count` threads, splitting them into
+ * runs of about the same number of bytes. The calling thread takes the
+ * first run, and takes over any run whose thread fails to start. */
+void set_method_slices(Memory* memory) {
+    u64 byte_count = 0;
+    for (u16 i = 0; i < memory->method_count; ++i) {
+        byte_count += memory->methods[i].size;
+    }
+    u64 slice_count = byte_count / SIZE_METHOD_SLICE;
+    if (memory->method_thread_count < slice_count) {
+        slice_count = memory->method_thread_count;
+    }
+    if (memory->method_count < slice_count) {
+        slice_count = memory->method_count;
+    }
+    if (slice_count < 2) {
+        return;
+    }
+    if (memory->method_slice_count < slice_count) {
+        MethodSlice* method_slices =
+            realloc(memory->method_slices, sizeof(MethodSlice) * slice_count);
+        if (method_slices == NULL) {
+            set_parse_error(memory, PARSE_OUT_OF_MEMORY);
+        }
+        memset(&method_slices[memory->method_slice_count],
+               0,
+               sizeof(MethodSlice) *
+                   (slice_count - memory->method_slice_count));
+        memory->method_slices = method_slices;
+        memory->method_slice_count = (u32)slice_count;
+    }
+    u16 method_index = 0;
+    u64 slice_bytes = 0;
+    for (u32 i = 0; i < slice_count; ++i) {
+        MethodSlice* slice = &memory->method_slices[i];
+        u64          slice_end = (byte_count * (i + 1)) / slice_count;
+        set_method_slice(memory, slice);
+        slice->first_method = method_index;
+        while ((method_index < memory->method_count) &&
+               (slice_bytes < slice_end))
+        {
+            slice_bytes += memory->methods[method_index++].size;
+        }
+        slice->method_end = method_index;
+    }
+    for (u32 i = 1; i < slice_count; ++i) {
+        MethodSlice* slice = &memory->method_slices[i];
+        slice->spawned =
+            pthread_create(&slice->thread, NULL, run_method_slice, slice) ==
+            0;
+        if (!slice->spawned) {
+            run_method_slice(slice);
+        }
+    }
+    run_method_slice(&memory->method_slices[0]);
+    for (u32 i = 0; i < slice_count; ++i) {
+        MethodSlice* slice = &memory->method_slices[i];
+        if ((i != 0) && slice->spawned) {
+            pthread_join(slice->thread, NULL);
+        }
+        merge_method_slice(memory, slice);
     }
-    return attribute;
 }
 
 void set_tokens(Memory* memory) {
+    reset_arena(&memory->arena);
     memory->byte_index = 0;
-    memory->token_index = 0;
-    memory->char_index = 0;
-    memory->attribute_index = 0;
-    memory->line_number_entry_index = 0;
-    memory->stack_map_entry_index = 0;
-    memory->verification_type_index = 0;
+    memory->first_token_block = NULL;
+    memory->last_token_block = NULL;
+    memory->token_count = 0;
+    memory->constant_tags = NULL;
+    memory->constant_values = NULL;
+    memory->attribute_tags_by_index = NULL;
+    memory->constant_count = 0;
+    memory->this_class = 0;
+    memory->major_version = 0;
+    memory->methods = NULL;
+    memory->method_count = 0;
+    memory->attribute_count = 1;
     {
         u32 magic = pop_u32(memory);
         if (magic != 0xCAFEBABE) {
-            printf("[ERROR] Incorrect magic constant\n");
-            return;
+            set_parse_error(memory, PARSE_BAD_MAGIC);
         }
         Token* token = alloc_token(memory);
         token->tag = MAGIC;
         token->u32 = magic;
     }
     push_tag_u16(memory, MINOR_VERSION, pop_u16(memory));
-    push_tag_u16(memory, MAJOR_VERSION, pop_u16(memory));
+    memory->major_version = pop_u16(memory);
+    push_tag_u16(memory, MAJOR_VERSION, memory->major_version);
     {
         u16 constant_pool_count = pop_u16(memory);
         push_tag_u16(memory, CONSTANT_POOL_COUNT, constant_pool_count);
+        set_constant_pool(memory, constant_pool_count);
+        STATS_PUSH(memory, STATS_CONSTANT_POOL);
         for (u16 i = 1; i < constant_pool_count; ++i) {
-            ConstantTag tag = (ConstantTag)pop_u8(memory);
-            Token*      token = alloc_token(memory);
-            token->tag = CONSTANT;
-            token->constant.index = i;
-            token->constant.tag = tag;
-            switch (tag) {
-            case CONSTANT_TAG_UTF8: {
-                u16 utf8_size = pop_u16(memory);
-                if (COUNT_CHARS <= (memory->char_index + utf8_size + 1)) {
-                    fprintf(stderr, "[ERROR] Unable to allocate string\n");
-                    exit(EXIT_FAILURE);
-                }
-                if (COUNT_UTF8S <= i) {
-                    fprintf(stderr,
-                            "[ERROR] Unable to allocate UTF8 pointer\n");
-                    exit(EXIT_FAILURE);
-                }
-                token->constant.utf8.size = utf8_size;
-                const char* utf8 = &memory->chars[memory->char_index];
-                token->constant.utf8.string = utf8;
-                memory->utf8s_by_index[i] = utf8;
-                for (u16 j = 0; j < utf8_size; ++j) {
-                    memory->chars[memory->char_index++] = (char)pop_u8(memory);
-                }
-                memory->chars[memory->char_index++] = '\0';
-                break;
-            }
-            case CONSTANT_TAG_CLASS: {
-                token->constant.class_.name_index = pop_u16(memory);
-                break;
-            }
-            case CONSTANT_TAG_STRING: {
-                token->constant.string.string_index = pop_u16(memory);
-                break;
-            }
-            case CONSTANT_TAG_FIELD_REF:
-            case CONSTANT_TAG_METHOD_REF: {
-                token->constant.ref.class_index = pop_u16(memory);
-                token->constant.ref.name_and_type_index = pop_u16(memory);
-                break;
-            }
-            case CONSTANT_TAG_NAME_AND_TYPE: {
-                token->constant.name_and_type.name_index = pop_u16(memory);
-                token->constant.name_and_type.descriptor_index =
-                    pop_u16(memory);
-                break;
-            }
-            default: {
-                printf("[ERROR] `{ ConstantTag tag (%hhu) }` "
-                       "unimplemented\n\n",
-                       (u8)tag);
-                return;
-            }
+            push_tag_u16(memory, CONSTANT, i);
+            if (is_wide_constant(set_constant(memory, i))) {
+                ++i;
             }
         }
+        STATS_POP(memory, STATS_CONSTANT_POOL);
     }
     push_tag_u16(memory, ACCESS_FLAGS, pop_u16(memory));
-    push_tag_u16(memory, THIS_CLASS, pop_u16(memory));
+    memory->this_class = pop_u16(memory);
+    push_tag_u16(memory, THIS_CLASS, memory->this_class);
     push_tag_u16(memory, SUPER_CLASS, pop_u16(memory));
     {
         u16 interface_count = pop_u16(memory);
         push_tag_u16(memory, INTERFACE_COUNT, interface_count);
-        for (u16 i = 0; i < interface_count; ++i) {
-            printf("[ERROR] `{ u16 interface }` unimplemented\n\n");
-            return;
-        }
+        pop_cursor(memory, (u32)interface_count * 2);
     }
     {
         u16 field_count = pop_u16(memory);
         push_tag_u16(memory, FIELD_COUNT, field_count);
-        for (u16 i = 0; i < field_count; ++i) {
-            printf("[ERROR] `{ ? field }` unimplemented\n\n");
-            return;
-        }
+        skip_fields(memory, field_count);
     }
     {
         u16 method_count = pop_u16(memory);
         push_tag_u16(memory, METHOD_COUNT, method_count);
+        memory->methods = alloc_methods(memory, method_count);
+        STATS_PUSH(memory, STATS_METHODS);
         for (u16 i = 0; i < method_count; ++i) {
-            Token* token = alloc_token(memory);
-            token->tag = METHOD;
-            token->method.access_flags = pop_u16(memory);
-            token->method.name_index = pop_u16(memory);
-            token->method.descriptor_index = pop_u16(memory);
-            u16 method_attribute_count = pop_u16(memory);
-            token->method.attribute_count = method_attribute_count;
-            Attribute* attribute = NULL;
-            Attribute* prev_attribute = NULL;
-            for (u16 j = 0; j < method_attribute_count; ++j) {
-                attribute = get_attribute(memory);
-                if (j == 0) {
-                    token->method.attributes = attribute;
-                }
-                if (prev_attribute != NULL) {
-                    prev_attribute->next_attribute = attribute;
-                }
-                prev_attribute = attribute;
+            push_tag_u16(memory, METHOD, i);
+            Method* method = &memory->methods[i];
+            Cursor  cursor = pop_cursor(memory, 8);
+            method->access_flags = pop_cursor_u16(&cursor);
+            method->name_index = pop_cursor_u16(&cursor);
+            method->descriptor_index = pop_cursor_u16(&cursor);
+            u16 method_attribute_count = pop_cursor_u16(&cursor);
+            method->attribute_count = method_attribute_count;
+            method->offset = memory->byte_index;
+            if (memory->lazy_methods ||
+                (1 < memory->method_thread_count))
+            {
+                method->attributes = 0;
+                skip_attributes(memory, method_attribute_count);
+            } else {
+                STATS_PUSH(memory, STATS_ATTRIBUTES);
+                method->attributes =
+                    get_attributes(memory, method_attribute_count);
+                STATS_POP(memory, STATS_ATTRIBUTES);
             }
+            method->size = memory->byte_index - method->offset;
+        }
+        STATS_POP(memory, STATS_METHODS);
+        memory->method_count = method_count;
+    }
+    if (1 < memory->method_thread_count) {
+        STATS_PUSH(memory, STATS_ATTRIBUTES);
+        set_method_slices(memory);
+        /* NOTE: Whatever is still undecoded (a class too small to split,
+         * or a method that failed) is decoded here, in order, so errors
+         * come out as they would without threads. */
+        for (u16 i = 0; !memory->lazy_methods && (i < memory->method_count);
+             ++i)
+        {
+            set_method_attributes(memory, &memory->methods[i]);
         }
+        STATS_POP(memory, STATS_ATTRIBUTES);
     }
     {
         u16 attribute_count = pop_u16(memory);
@@ -453,12 +1151,53 @@ void set_tokens(Memory* memory) {
             token->tag = ATTRIBUTE_COUNT;
             token->u16 = attribute_count;
         }
+        STATS_PUSH(memory, STATS_ATTRIBUTES);
         for (u16 _ = 0; _ < attribute_count; ++_) {
+            u32    attribute = get_attribute(memory);
             Token* token = alloc_token(memory);
             token->tag = ATTRIBUTE;
-            token->attribute = get_attribute(memory);
+            token->u32 = attribute;
         }
+        STATS_POP(memory, STATS_ATTRIBUTES);
+    }
+}
+
+ParseError parse_class(Memory* memory, const u8* bytes, u32 size) {
+    jmp_buf on_error;
+    memory->bytes = bytes;
+    memory->file_size = size;
+    memory->error.code = PARSE_OK;
+    memory->error.offset = 0;
+    memory->on_error = &on_error;
+#ifdef STATS
+    u32 stats_depth = memory->stats.depth;
+#endif
+    if (setjmp(on_error) == 0) {
+        set_tokens(memory);
+    }
+#ifdef STATS
+    unwind_stats(&memory->stats, stats_depth);
+#endif
+    memory->on_error = NULL;
+    return memory->error;
+}
+
+ParseError parse_method(Memory* memory, Method* method) {
+    jmp_buf on_error;
+    memory->error.code = PARSE_OK;
+    memory->error.offset = 0;
+    memory->on_error = &on_error;
+#ifdef STATS
+    u32 stats_depth = memory->stats.depth;
+#endif
+    if (setjmp(on_error) == 0) {
+        set_method_attributes(memory, method);
     }
+#ifdef STATS
+    unwind_stats(&memory->stats, stats_depth);
+#endif
+    memory->on_error = NULL;
+    return memory->error;
 }
 
 #endif
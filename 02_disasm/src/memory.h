@@ -1,18 +1,25 @@
 #ifndef __MEMORY_H__
 #define __MEMORY_H__
 
-#include "prelude.h"
-
-#define COUNT_BYTES               1024
-#define COUNT_TOKENS              64
-#define COUNT_CHARS               512
-#define COUNT_UTF8S               64
-#define COUNT_ATTRIBS             64
-#define COUNT_LINE_NUMBER_ENTRIES 32
-#define COUNT_STACK_MAP_ENTRIES   8
-#define COUNT_VERIFICATION_TYPES  8
-#define COUNT_NEST_MEMBER_CLASSES 8
-#define COUNT_INNER_CLASS_ENTRIES 8
+#include <fcntl.h>
+#include <pthread.h>
+#include <setjmp.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string.h>
+
+#include "arena.c"
+#include "mutf8.c"
+#include "parse_error.h"
+#include "stats.c"
+
+#define COUNT_TOKEN_BLOCK 256
+#define COUNT_ATTRIBUTES  64
+/* NOTE: Below this many bytes of method bodies per thread, starting the
+ * thread costs more than decoding the bodies. */
+#define SIZE_METHOD_SLICE (1 << 14)
 
 typedef enum {
     MAGIC,
@@ -35,27 +42,28 @@ typedef enum {
 
 typedef enum {
     CONSTANT_TAG_UTF8 = 1,
-    // CONSTANT_TAG_INTEGER = 3,
-    // CONSTANT_TAG_FLOAT = 4,
-    // CONSTANT_TAG_LONG = 5,
-    // CONSTANT_TAG_DOUBLE = 6,
+    CONSTANT_TAG_INTEGER = 3,
+    CONSTANT_TAG_FLOAT = 4,
+    CONSTANT_TAG_LONG = 5,
+    CONSTANT_TAG_DOUBLE = 6,
     CONSTANT_TAG_CLASS = 7,
     CONSTANT_TAG_STRING = 8,
     CONSTANT_TAG_FIELD_REF = 9,
     CONSTANT_TAG_METHOD_REF = 10,
-    // CONSTANT_TAG_INTERFACE_METHOD_REF = 11,
+    CONSTANT_TAG_INTERFACE_METHOD_REF = 11,
     CONSTANT_TAG_NAME_AND_TYPE = 12,
-    // CONSTANT_TAG_METHOD_HANDLE = 15,
-    // CONSTANT_TAG_METHOD_TYPE = 16,
-    // CONSTANT_TAG_DYNAMIC = 17,
-    // CONSTANT_TAG_INVOKE_DYNAMIC = 18,
-    // CONSTANT_TAG_MODULE = 19,
-    // CONSTANT_TAG_PACKAGE = 20,
+    CONSTANT_TAG_METHOD_HANDLE = 15,
+    CONSTANT_TAG_METHOD_TYPE = 16,
+    CONSTANT_TAG_DYNAMIC = 17,
+    CONSTANT_TAG_INVOKE_DYNAMIC = 18,
+    CONSTANT_TAG_MODULE = 19,
+    CONSTANT_TAG_PACKAGE = 20,
 } ConstantTag;
 
+/* NOTE: A view into the class file bytes; not NUL-terminated. */
 typedef struct {
-    const char* string;
-    u16         size;
+    const u8* bytes;
+    u16       size;
 } ConstantUtf8;
 
 typedef struct {
@@ -66,6 +74,11 @@ typedef struct {
     u16 string_index;
 } ConstantString;
 
+typedef struct {
+    u32 high_bytes;
+    u32 low_bytes;
+} ConstantWide;
+
 typedef struct {
     u16 class_index;
     u16 name_and_type_index;
@@ -76,13 +89,30 @@ typedef struct {
     u16 descriptor_index;
 } ConstantNameAndType;
 
+typedef struct {
+    u16 reference_index;
+    u8  reference_kind;
+} ConstantMethodHandle;
+
+typedef struct {
+    u16 bootstrap_method_attr_index;
+    u16 name_and_type_index;
+} ConstantDynamic;
+
+/* NOTE: Decoded on demand by `get_constant`; the pool itself keeps only a
+ * tag byte and a packed `u32` per slot. */
 typedef struct {
     union {
-        ConstantUtf8        utf8;
-        ConstantString      string;
-        ConstantClass       class_;
-        ConstantRef         ref;
-        ConstantNameAndType name_and_type;
+        ConstantUtf8         utf8;
+        u32                  u32;
+        ConstantWide         wide;
+        ConstantString       string;
+        ConstantClass        class_;
+        ConstantRef          ref;
+        ConstantNameAndType  name_and_type;
+        ConstantMethodHandle method_handle;
+        ConstantDynamic      dynamic;
+        u16                  u16;
     };
     u16         index;
     ConstantTag tag;
@@ -122,66 +152,33 @@ typedef enum {
     ATTRIB_SOURCE_FILE,
     ATTRIB_NEST_MEMBER,
     ATTRIB_INNER_CLASSES,
+    ATTRIB_UNKNOWN,
 } AttributeTag;
 
-// typedef struct {
-//     u16 pc_start;
-//     u16 pc_end;
-//     u16 pc_handler;
-//     u16 catch_type;
-// } ExceptionTable;
+typedef struct {
+    const char*  string;
+    u16          size;
+    AttributeTag tag;
+} AttributeName;
 
-typedef struct Attribute Attribute;
+typedef struct {
+    u16 pc_start;
+    u16 pc_end;
+    u16 pc_handler;
+    u16 catch_type;
+} ExceptionTable;
 
 typedef struct {
-    Attribute* attributes;
-    const u8*  bytes;
-    u32        byte_count;
-    u16        max_stack;
-    u16        max_local;
-    u16        exception_table_count;
-    u16        attribute_count;
-    // ExceptionTable* exception_table;
+    const u8*       bytes;
+    ExceptionTable* exception_table;
+    u32             attributes;
+    u32             byte_count;
+    u16             max_stack;
+    u16             max_local;
+    u16             exception_table_count;
+    u16             attribute_count;
 } Code;
 
-typedef enum {
-    OP_ALOAD_0 = 42,
-    OP_INVOKESPECIAL = 183,
-    OP_RETURN = 177,
-    OP_GETFIELD = 180,
-    OP_IFNE = 154,
-    OP_IRETURN = 172,
-    OP_IF_ICMPNE = 160,
-    OP_ISTORE_1 = 60,
-    OP_ISTORE_2 = 61,
-    OP_ISTORE_3 = 62,
-    OP_ICONST_0 = 3,
-    OP_ICONST_1 = 4,
-    OP_ICONST_2 = 5,
-    OP_ICONST_3 = 6,
-    OP_ISTORE = 54,
-    OP_ILOAD = 21,
-    OP_IF_ICMPGE = 162,
-    OP_ILOAD_2 = 28,
-    OP_ILOAD_3 = 29,
-    OP_ILOAD_1 = 27,
-    OP_IADD = 96,
-    OP_ISUB = 100,
-    OP_IINC = 132,
-    OP_GOTO = 167,
-    OP_BIPUSH = 16,
-    OP_NEW = 187,
-    OP_DUP = 89,
-    OP_ASTORE_2 = 77,
-    OP_ALOAD_2 = 44,
-    OP_PUTFIELD = 181,
-    OP_GETSTATIC = 178,
-    OP_INVOKESTATIC = 184,
-    OP_INVOKEVIRTUAL = 182,
-    OP_LDC = 18,
-    OP_ILOAD_0 = 26,
-} OpCode;
-
 typedef struct {
     u16 pc_start;
     u16 line_number;
@@ -255,7 +252,15 @@ typedef struct {
     u16              count;
 } InnerClasses;
 
-struct Attribute {
+/* NOTE: An attribute left undecoded, either because its name is not one
+ * this knows or because it was masked off; its body is `size` bytes. */
+typedef struct {
+    const u8* bytes;
+} Opaque;
+
+/* NOTE: Attributes live in one growable pool in `Memory` and are named by
+ * their index in it. Index 0 is never handed out, so it ends a list. */
+typedef struct {
     union {
         u16             u16;
         Code            code;
@@ -263,84 +268,173 @@ struct Attribute {
         StackMapTable   stack_map_table;
         NestMember      nest_member;
         InnerClasses    inner_classes;
+        Opaque          opaque;
     };
-    Attribute*   next_attribute;
+    u32          next_attribute;
     u32          size;
     u16          name_index;
     AttributeTag tag;
-};
+} Attribute;
 
 typedef struct {
-    Attribute* attributes;
-    u16        access_flags;
-    u16        name_index;
-    u16        descriptor_index;
-    u16        attribute_count;
+    u32 attributes;
+    u32 offset;
+    u32 size;
+    u16 access_flags;
+    u16 name_index;
+    u16 descriptor_index;
+    u16 attribute_count;
 } Method;
 
+/* NOTE: `CONSTANT` and `METHOD` tokens hold an index into the pool or the
+ * method table and `ATTRIBUTE` tokens an attribute handle, so a token never
+ * has to be as large as the thing it stands for. */
 typedef struct {
     union {
-        u32        u32;
-        u16        u16;
-        Constant   constant;
-        Method     method;
-        Attribute* attribute;
+        u32 u32;
+        u16 u16;
     };
     Tag tag;
 } Token;
 
+typedef struct TokenBlock TokenBlock;
+
+struct TokenBlock {
+    TokenBlock* next_block;
+    u32         count;
+    Token       tokens[COUNT_TOKEN_BLOCK];
+};
+
+typedef struct MethodSlice MethodSlice;
+
 typedef struct {
-    u32              file_size;
-    u32              byte_index;
-    u8               bytes[COUNT_BYTES];
-    u32              token_index;
-    Token            tokens[COUNT_TOKENS];
-    u32              char_index;
-    char             chars[COUNT_CHARS];
-    const char*      utf8s_by_index[COUNT_UTF8S];
-    u32              attribute_index;
-    Attribute        attributes[COUNT_ATTRIBS];
-    u32              line_number_entry_index;
-    LineNumberEntry  line_number_entries[COUNT_LINE_NUMBER_ENTRIES];
-    u32              stack_map_entry_index;
-    StackMapEntry    stack_map_entries[COUNT_STACK_MAP_ENTRIES];
-    u32              verification_type_index;
-    VerificationType verification_types[COUNT_VERIFICATION_TYPES];
-    u32              nest_member_class_index;
-    u16              nest_member_classes[COUNT_NEST_MEMBER_CLASSES];
-    u32              inner_class_entry_index;
-    InnerClassEntry  inner_class_entries[COUNT_INNER_CLASS_ENTRIES];
+    Arena         arena;
+    const u8*     bytes;
+    u32           file_size;
+    u32           byte_index;
+    TokenBlock*   first_token_block;
+    TokenBlock*   last_token_block;
+    u32           token_count;
+    u8*           constant_tags;
+    u32*          constant_values;
+    AttributeTag* attribute_tags_by_index;
+    u16           constant_count;
+    u16           this_class;
+    u16           major_version;
+    Method*       methods;
+    u16           method_count;
+    Attribute*    attributes;
+    u32           attribute_count;
+    u32           attribute_capacity;
+    MethodSlice*  method_slices;
+    u32           method_slice_count;
+    u32           method_thread_count;
+    u32           attribute_skip_mask;
+    Bool          lazy_methods;
+    ParseError    error;
+    jmp_buf*      on_error;
+#ifdef STATS
+    Stats stats;
+#endif
 } Memory;
 
-#define OUT_OF_BOUNDS                               \
-    {                                               \
-        fprintf(stderr, "[ERROR] Out of bounds\n"); \
-        exit(EXIT_FAILURE);                         \
-    }
+/* NOTE: One thread's share of the method bodies of a class. Its `memory`
+ * shares the class bytes and the constant pool with the parent but has its
+ * own arena and attribute pool, and is kept for the next class. */
+struct MethodSlice {
+    Memory    memory;
+    pthread_t thread;
+    u16       first_method;
+    u16       method_end;
+    Bool      spawned;
+};
+
+/* NOTE: A fixed-shape record whose whole length `pop_cursor` has already
+ * checked against the end of the file, so its fields are read with no
+ * further checks. */
+typedef struct {
+    const u8* bytes;
+} Cursor;
+
+_Noreturn void set_parse_error(Memory*, ParseErrorCode);
+_Noreturn void set_parse_error_at(Memory*, const u8*, u32, ParseErrorCode);
+const char*   get_parse_error_name(u32);
+
+const char* try_map_file(const char*, const u8**, u32*);
+const u8*   map_file(const char*, u32*);
+void        unmap_file(const u8*, u32);
 
-void set_file_to_bytes(Memory*, const char*);
+void free_memory(Memory*);
 
-u8  pop_u8(Memory*);
-u8* pop_u8_ref(Memory*);
+void        set_file_to_bytes(Memory*, const char*);
+const char* try_file_to_bytes(Memory*, const char*);
+void        unset_file_to_bytes(Memory*);
+
+u16 get_u16_be(const u8*);
+u32 get_u32_be(const u8*);
+
+Cursor pop_cursor(Memory*, u32);
+u8     pop_cursor_u8(Cursor*);
+u16    pop_cursor_u16(Cursor*);
+u32    pop_cursor_u32(Cursor*);
+
+u8        pop_u8(Memory*);
+const u8* pop_u8_ref(Memory*);
 u16 pop_u16(Memory*);
 u32 pop_u32(Memory*);
 
-u8  pop_u8_at(const u8*, u32*, u32);
-u16 pop_u16_at(const u8*, u32*, u32);
+u8  pop_u8_at(Memory*, const u8*, u32*, u32);
+u16 pop_u16_at(Memory*, const u8*, u32*, u32);
+u32 pop_u32_at(Memory*, const u8*, u32*, u32);
 
+void*             alloc_memory_bytes(Memory*, u64, u64);
 Token*            alloc_token(Memory*);
-Attribute*        alloc_attribute(Memory*);
-LineNumberEntry*  alloc_line_number_entry(Memory*);
-StackMapEntry*    alloc_stack_map_entry(Memory*);
-VerificationType* alloc_verification_type(Memory*);
-u16*              alloc_nest_member_class(Memory*);
-InnerClassEntry*  alloc_inner_class_entry(Memory*);
+char*             alloc_chars(Memory*, u32);
+u8*               alloc_constant_tags(Memory*, u16);
+u32*              alloc_constant_values(Memory*, u16);
+AttributeTag*     alloc_attribute_tags(Memory*, u16);
+Method*           alloc_methods(Memory*, u16);
+u32               alloc_attribute(Memory*);
+ExceptionTable*   alloc_exception_table(Memory*, u16);
+LineNumberEntry*  alloc_line_number_entries(Memory*, u16);
+StackMapEntry*    alloc_stack_map_entries(Memory*, u16);
+VerificationType* alloc_verification_types(Memory*, u16);
+u16*              alloc_nest_member_classes(Memory*, u16);
+InnerClassEntry*  alloc_inner_class_entries(Memory*, u16);
 
 void push_tag_u16(Memory*, Tag, u16);
 
-VerificationType* get_verification_type(Memory*);
-Attribute*        get_attribute(Memory*);
-
-void set_tokens(Memory*);
+AttributeTag get_attribute_tag(const u8*, u16);
+Bool         get_attribute_mask(const char*, u32*);
+AttributeTag get_masked_attribute_tag(const Memory*, u16);
+
+void              set_verification_type(Memory*, VerificationType*);
+VerificationType* get_verification_types(Memory*, u16);
+u32               get_attribute(Memory*);
+u32               get_attributes(Memory*, u16);
+Attribute*        get_attribute_at(const Memory*, u32);
+
+void                skip_attributes(Memory*, u16);
+void                skip_fields(Memory*, u16);
+void                set_method_attributes(Memory*, Method*);
+ConstantTag         get_constant_tag(Memory*, u16);
+Constant            get_constant(Memory*, u16);
+ConstantUtf8        get_utf8(Memory*, u16);
+ConstantUtf8        get_class_name(Memory*, u16);
+ConstantNameAndType get_name_and_type(Memory*, u16);
+Bool                get_utf8_eq(ConstantUtf8, const char*);
+
+void set_constant_pool(Memory*, u16);
+Bool is_wide_constant(ConstantTag);
+ConstantTag set_constant(Memory*, u16);
+
+void* run_method_slice(void*);
+void  set_method_slice(const Memory*, MethodSlice*);
+void  merge_method_slice(Memory*, MethodSlice*);
+void  set_method_slices(Memory*);
+
+void       set_tokens(Memory*);
+ParseError parse_class(Memory*, const u8*, u32);
+ParseError parse_method(Memory*, Method*);
 
 #endif
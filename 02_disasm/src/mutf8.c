@@ -0,0 +1,189 @@
+#ifndef __MUTF8_C__
+#define __MUTF8_C__
+
+#include "mutf8.h"
+
+/* NOTE: Class files spell strings in Modified UTF-8 (JVMS 4.4.7): no raw
+ * NUL (it is written `C0 80`), no four-byte forms (supplementary characters
+ * are surrogate pairs, three bytes each). Nearly every pool string is
+ * plain ASCII, so the vector kernels only answer "how many leading bytes
+ * are in 0x01..0x7F"; anything else drops to the scalar decoder for one
+ * sequence and then returns to the fast path. */
+
+static GetAsciiPrefix GET_ASCII_PREFIX = get_ascii_prefix_scalar;
+
+u32 get_ascii_prefix_scalar(const u8* bytes, u32 size) {
+    u32 i = 0;
+    for (; (i + 8) <= size; i += 8) {
+        u64 word;
+        memcpy(&word, &bytes[i], sizeof(u64));
+        /* NOTE: High bit set in any byte, or any byte equal to zero. */
+        u64 zero = (word - 0x0101010101010101) & ~word;
+        if (((word | zero) & 0x8080808080808080) != 0) {
+            break;
+        }
+    }
+    for (; i < size; ++i) {
+        if ((bytes[i] == 0) || (0x7F < bytes[i])) {
+            break;
+        }
+    }
+    return i;
+}
+
+#ifdef MUTF8_X86
+
+__attribute__((target("sse4.1"))) u32 get_ascii_prefix_sse(const u8* bytes,
+                                                           u32 size) {
+    const __m128i zero = _mm_setzero_si128();
+    u32           i = 0;
+    for (; (i + 16) <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128((const void*)&bytes[i]);
+        /* NOTE: Signed `x > 0` is exactly `0x01 <= x <= 0x7F`. */
+        if (!_mm_test_all_ones(_mm_cmpgt_epi8(chunk, zero))) {
+            break;
+        }
+    }
+    return i + get_ascii_prefix_scalar(&bytes[i], size - i);
+}
+
+__attribute__((target("avx2"))) u32 get_ascii_prefix_avx2(const u8* bytes,
+                                                          u32       size) {
+    const __m256i zero = _mm256_setzero_si256();
+    u32           i = 0;
+    for (; (i + 64) <= size; i += 64) {
+        __m256i a = _mm256_loadu_si256((const void*)&bytes[i]);
+        __m256i b = _mm256_loadu_si256((const void*)&bytes[i + 32]);
+        __m256i ok = _mm256_and_si256(_mm256_cmpgt_epi8(a, zero),
+                                      _mm256_cmpgt_epi8(b, zero));
+        if (_mm256_movemask_epi8(ok) != -1) {
+            break;
+        }
+    }
+    for (; (i + 32) <= size; i += 32) {
+        __m256i chunk = _mm256_loadu_si256((const void*)&bytes[i]);
+        if (_mm256_movemask_epi8(_mm256_cmpgt_epi8(chunk, zero)) != -1) {
+            break;
+        }
+    }
+    return i + get_ascii_prefix_scalar(&bytes[i], size - i);
+}
+
+#endif
+
+u32 get_ascii_prefix(const u8* bytes, u32 size) {
+    return GET_ASCII_PREFIX(bytes, size);
+}
+
+/* NOTE: Call once before any threads start; every kernel returns the same
+ * answer, so the choice only affects speed. */
+void set_mutf8_dispatch(void) {
+#ifdef MUTF8_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        GET_ASCII_PREFIX = get_ascii_prefix_avx2;
+    } else if (__builtin_cpu_supports("sse4.1")) {
+        GET_ASCII_PREFIX = get_ascii_prefix_sse;
+    }
+#endif
+}
+
+/* NOTE: Size of the sequence starting at `bytes[i]`, or zero if it is not
+ * valid Modified UTF-8. */
+u32 get_mutf8_sequence_size(const u8* bytes, u32 i, u32 size) {
+    u8 lead = bytes[i];
+    if ((0x01 <= lead) && (lead <= 0x7F)) {
+        return 1;
+    }
+    if ((lead & 0xE0) == 0xC0) {
+        if ((size <= (i + 1)) || ((bytes[i + 1] & 0xC0) != 0x80)) {
+            return 0;
+        }
+        /* NOTE: `C0 80` is the only overlong form allowed. */
+        if ((lead < 0xC2) && !((lead == 0xC0) && (bytes[i + 1] == 0x80))) {
+            return 0;
+        }
+        return 2;
+    }
+    if ((lead & 0xF0) == 0xE0) {
+        if ((size <= (i + 2)) || ((bytes[i + 1] & 0xC0) != 0x80) ||
+            ((bytes[i + 2] & 0xC0) != 0x80))
+        {
+            return 0;
+        }
+        if ((lead == 0xE0) && (bytes[i + 1] < 0xA0)) {
+            return 0;
+        }
+        return 3;
+    }
+    return 0;
+}
+
+Bool is_mutf8_valid(const u8* bytes, u32 size) {
+    u32 i = get_ascii_prefix(bytes, size);
+    while (i < size) {
+        u32 sequence_size = get_mutf8_sequence_size(bytes, i, size);
+        if (sequence_size == 0) {
+            return FALSE;
+        }
+        i += sequence_size;
+        i += get_ascii_prefix(&bytes[i], size - i);
+    }
+    return TRUE;
+}
+
+/* NOTE: Expects input already accepted by `is_mutf8_valid`. Standard UTF-8
+ * is never longer than Modified UTF-8 for the same text (`C0 80` shrinks
+ * to one byte, a surrogate pair from six to four), so `out` needs at most
+ * `size` bytes. A lone surrogate has no UTF-8 spelling and becomes
+ * U+FFFD. */
+u32 set_mutf8_to_utf8(const u8* bytes, u32 size, u8* out) {
+    u32 i = 0;
+    u32 n = 0;
+    while (i < size) {
+        u32 ascii_size = get_ascii_prefix(&bytes[i], size - i);
+        memcpy(&out[n], &bytes[i], ascii_size);
+        i += ascii_size;
+        n += ascii_size;
+        if (size <= i) {
+            break;
+        }
+        u8 lead = bytes[i];
+        if ((lead == 0xC0) && (bytes[i + 1] == 0x80)) {
+            out[n++] = 0;
+            i += 2;
+        } else if ((lead & 0xE0) == 0xC0) {
+            out[n++] = bytes[i++];
+            out[n++] = bytes[i++];
+        } else if ((lead == 0xED) && (0xA0 <= bytes[i + 1])) {
+            if ((bytes[i + 1] < 0xB0) && ((i + 5) < size) &&
+                (bytes[i + 3] == 0xED) && (0xB0 <= bytes[i + 4]))
+            {
+                u32 high = ((u32)(bytes[i + 1] & 0x0F) << 6) |
+                           (u32)(bytes[i + 2] & 0x3F);
+                u32 low = ((u32)(bytes[i + 4] & 0x0F) << 6) |
+                          (u32)(bytes[i + 5] & 0x3F);
+                u32 code_point = 0x10000 + ((high << 10) | low);
+                out[n++] = (u8)(0xF0 | (code_point >> 18));
+                out[n++] = (u8)(0x80 | ((code_point >> 12) & 0x3F));
+                out[n++] = (u8)(0x80 | ((code_point >> 6) & 0x3F));
+                out[n++] = (u8)(0x80 | (code_point & 0x3F));
+                i += 6;
+            } else {
+                out[n++] = 0xEF;
+                out[n++] = 0xBF;
+                out[n++] = 0xBD;
+                i += 3;
+            }
+        } else if ((lead & 0xF0) == 0xE0) {
+            out[n++] = bytes[i++];
+            out[n++] = bytes[i++];
+            out[n++] = bytes[i++];
+        } else {
+            out[n++] = bytes[i++];
+        }
+    }
+    return n;
+}
+
+#endif
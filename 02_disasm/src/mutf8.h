@@ -0,0 +1,27 @@
+#ifndef __MUTF8_H__
+#define __MUTF8_H__
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #define MUTF8_X86
+#endif
+
+#include "prelude.h"
+
+typedef u32 (*GetAsciiPrefix)(const u8*, u32);
+
+u32 get_ascii_prefix_scalar(const u8*, u32);
+#ifdef MUTF8_X86
+u32 get_ascii_prefix_sse(const u8*, u32);
+u32 get_ascii_prefix_avx2(const u8*, u32);
+#endif
+u32  get_ascii_prefix(const u8*, u32);
+void set_mutf8_dispatch(void);
+
+u32  get_mutf8_sequence_size(const u8*, u32, u32);
+Bool is_mutf8_valid(const u8*, u32);
+u32  set_mutf8_to_utf8(const u8*, u32, u8*);
+
+#endif
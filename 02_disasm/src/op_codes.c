@@ -0,0 +1,315 @@
+#ifndef __OP_CODES_C__
+#define __OP_CODES_C__
+
+#include "op_codes.h"
+
+/* NOTE: See `https://docs.oracle.com/javase/specs/jvms/se17/html/jvms-6.html`.
+ * `size` is the full instruction length in bytes, or `0` for the
+ * variable-length `tableswitch`, `lookupswitch` and `wide`. `stack_effect`
+ * counts operand stack slots (`long` and `double` take two); instructions
+ * whose effect depends on a descriptor are marked `OP_STACK_VARIES`. Opcodes
+ * the spec leaves unassigned have a `NULL` mnemonic. */
+static const OpCodeInfo OP_CODES[COUNT_OP_CODES] = {
+    [OP_NOP] = {"nop", OPERAND_NONE, 1, 0},
+    [OP_ACONST_NULL] = {"aconst_null", OPERAND_NONE, 1, 1},
+    [OP_ICONST_M1] = {"iconst_m1", OPERAND_NONE, 1, 1},
+    [OP_ICONST_0] = {"iconst_0", OPERAND_NONE, 1, 1},
+    [OP_ICONST_1] = {"iconst_1", OPERAND_NONE, 1, 1},
+    [OP_ICONST_2] = {"iconst_2", OPERAND_NONE, 1, 1},
+    [OP_ICONST_3] = {"iconst_3", OPERAND_NONE, 1, 1},
+    [OP_ICONST_4] = {"iconst_4", OPERAND_NONE, 1, 1},
+    [OP_ICONST_5] = {"iconst_5", OPERAND_NONE, 1, 1},
+    [OP_LCONST_0] = {"lconst_0", OPERAND_NONE, 1, 2},
+    [OP_LCONST_1] = {"lconst_1", OPERAND_NONE, 1, 2},
+    [OP_FCONST_0] = {"fconst_0", OPERAND_NONE, 1, 1},
+    [OP_FCONST_1] = {"fconst_1", OPERAND_NONE, 1, 1},
+    [OP_FCONST_2] = {"fconst_2", OPERAND_NONE, 1, 1},
+    [OP_DCONST_0] = {"dconst_0", OPERAND_NONE, 1, 2},
+    [OP_DCONST_1] = {"dconst_1", OPERAND_NONE, 1, 2},
+    [OP_BIPUSH] = {"bipush", OPERAND_I8, 2, 1},
+    [OP_SIPUSH] = {"sipush", OPERAND_I16, 3, 1},
+    [OP_LDC] = {"ldc", OPERAND_U8, 2, 1},
+    [OP_LDC_W] = {"ldc_w", OPERAND_U16, 3, 1},
+    [OP_LDC2_W] = {"ldc2_w", OPERAND_U16, 3, 2},
+    [OP_ILOAD] = {"iload", OPERAND_U8, 2, 1},
+    [OP_LLOAD] = {"lload", OPERAND_U8, 2, 2},
+    [OP_FLOAD] = {"fload", OPERAND_U8, 2, 1},
+    [OP_DLOAD] = {"dload", OPERAND_U8, 2, 2},
+    [OP_ALOAD] = {"aload", OPERAND_U8, 2, 1},
+    [OP_ILOAD_0] = {"iload_0", OPERAND_NONE, 1, 1},
+    [OP_ILOAD_1] = {"iload_1", OPERAND_NONE, 1, 1},
+    [OP_ILOAD_2] = {"iload_2", OPERAND_NONE, 1, 1},
+    [OP_ILOAD_3] = {"iload_3", OPERAND_NONE, 1, 1},
+    [OP_LLOAD_0] = {"lload_0", OPERAND_NONE, 1, 2},
+    [OP_LLOAD_1] = {"lload_1", OPERAND_NONE, 1, 2},
+    [OP_LLOAD_2] = {"lload_2", OPERAND_NONE, 1, 2},
+    [OP_LLOAD_3] = {"lload_3", OPERAND_NONE, 1, 2},
+    [OP_FLOAD_0] = {"fload_0", OPERAND_NONE, 1, 1},
+    [OP_FLOAD_1] = {"fload_1", OPERAND_NONE, 1, 1},
+    [OP_FLOAD_2] = {"fload_2", OPERAND_NONE, 1, 1},
+    [OP_FLOAD_3] = {"fload_3", OPERAND_NONE, 1, 1},
+    [OP_DLOAD_0] = {"dload_0", OPERAND_NONE, 1, 2},
+    [OP_DLOAD_1] = {"dload_1", OPERAND_NONE, 1, 2},
+    [OP_DLOAD_2] = {"dload_2", OPERAND_NONE, 1, 2},
+    [OP_DLOAD_3] = {"dload_3", OPERAND_NONE, 1, 2},
+    [OP_ALOAD_0] = {"aload_0", OPERAND_NONE, 1, 1},
+    [OP_ALOAD_1] = {"aload_1", OPERAND_NONE, 1, 1},
+    [OP_ALOAD_2] = {"aload_2", OPERAND_NONE, 1, 1},
+    [OP_ALOAD_3] = {"aload_3", OPERAND_NONE, 1, 1},
+    [OP_IALOAD] = {"iaload", OPERAND_NONE, 1, -1},
+    [OP_LALOAD] = {"laload", OPERAND_NONE, 1, 0},
+    [OP_FALOAD] = {"faload", OPERAND_NONE, 1, -1},
+    [OP_DALOAD] = {"daload", OPERAND_NONE, 1, 0},
+    [OP_AALOAD] = {"aaload", OPERAND_NONE, 1, -1},
+    [OP_BALOAD] = {"baload", OPERAND_NONE, 1, -1},
+    [OP_CALOAD] = {"caload", OPERAND_NONE, 1, -1},
+    [OP_SALOAD] = {"saload", OPERAND_NONE, 1, -1},
+    [OP_ISTORE] = {"istore", OPERAND_U8, 2, -1},
+    [OP_LSTORE] = {"lstore", OPERAND_U8, 2, -2},
+    [OP_FSTORE] = {"fstore", OPERAND_U8, 2, -1},
+    [OP_DSTORE] = {"dstore", OPERAND_U8, 2, -2},
+    [OP_ASTORE] = {"astore", OPERAND_U8, 2, -1},
+    [OP_ISTORE_0] = {"istore_0", OPERAND_NONE, 1, -1},
+    [OP_ISTORE_1] = {"istore_1", OPERAND_NONE, 1, -1},
+    [OP_ISTORE_2] = {"istore_2", OPERAND_NONE, 1, -1},
+    [OP_ISTORE_3] = {"istore_3", OPERAND_NONE, 1, -1},
+    [OP_LSTORE_0] = {"lstore_0", OPERAND_NONE, 1, -2},
+    [OP_LSTORE_1] = {"lstore_1", OPERAND_NONE, 1, -2},
+    [OP_LSTORE_2] = {"lstore_2", OPERAND_NONE, 1, -2},
+    [OP_LSTORE_3] = {"lstore_3", OPERAND_NONE, 1, -2},
+    [OP_FSTORE_0] = {"fstore_0", OPERAND_NONE, 1, -1},
+    [OP_FSTORE_1] = {"fstore_1", OPERAND_NONE, 1, -1},
+    [OP_FSTORE_2] = {"fstore_2", OPERAND_NONE, 1, -1},
+    [OP_FSTORE_3] = {"fstore_3", OPERAND_NONE, 1, -1},
+    [OP_DSTORE_0] = {"dstore_0", OPERAND_NONE, 1, -2},
+    [OP_DSTORE_1] = {"dstore_1", OPERAND_NONE, 1, -2},
+    [OP_DSTORE_2] = {"dstore_2", OPERAND_NONE, 1, -2},
+    [OP_DSTORE_3] = {"dstore_3", OPERAND_NONE, 1, -2},
+    [OP_ASTORE_0] = {"astore_0", OPERAND_NONE, 1, -1},
+    [OP_ASTORE_1] = {"astore_1", OPERAND_NONE, 1, -1},
+    [OP_ASTORE_2] = {"astore_2", OPERAND_NONE, 1, -1},
+    [OP_ASTORE_3] = {"astore_3", OPERAND_NONE, 1, -1},
+    [OP_IASTORE] = {"iastore", OPERAND_NONE, 1, -3},
+    [OP_LASTORE] = {"lastore", OPERAND_NONE, 1, -4},
+    [OP_FASTORE] = {"fastore", OPERAND_NONE, 1, -3},
+    [OP_DASTORE] = {"dastore", OPERAND_NONE, 1, -4},
+    [OP_AASTORE] = {"aastore", OPERAND_NONE, 1, -3},
+    [OP_BASTORE] = {"bastore", OPERAND_NONE, 1, -3},
+    [OP_CASTORE] = {"castore", OPERAND_NONE, 1, -3},
+    [OP_SASTORE] = {"sastore", OPERAND_NONE, 1, -3},
+    [OP_POP] = {"pop", OPERAND_NONE, 1, -1},
+    [OP_POP2] = {"pop2", OPERAND_NONE, 1, -2},
+    [OP_DUP] = {"dup", OPERAND_NONE, 1, 1},
+    [OP_DUP_X1] = {"dup_x1", OPERAND_NONE, 1, 1},
+    [OP_DUP_X2] = {"dup_x2", OPERAND_NONE, 1, 1},
+    [OP_DUP2] = {"dup2", OPERAND_NONE, 1, 2},
+    [OP_DUP2_X1] = {"dup2_x1", OPERAND_NONE, 1, 2},
+    [OP_DUP2_X2] = {"dup2_x2", OPERAND_NONE, 1, 2},
+    [OP_SWAP] = {"swap", OPERAND_NONE, 1, 0},
+    [OP_IADD] = {"iadd", OPERAND_NONE, 1, -1},
+    [OP_LADD] = {"ladd", OPERAND_NONE, 1, -2},
+    [OP_FADD] = {"fadd", OPERAND_NONE, 1, -1},
+    [OP_DADD] = {"dadd", OPERAND_NONE, 1, -2},
+    [OP_ISUB] = {"isub", OPERAND_NONE, 1, -1},
+    [OP_LSUB] = {"lsub", OPERAND_NONE, 1, -2},
+    [OP_FSUB] = {"fsub", OPERAND_NONE, 1, -1},
+    [OP_DSUB] = {"dsub", OPERAND_NONE, 1, -2},
+    [OP_IMUL] = {"imul", OPERAND_NONE, 1, -1},
+    [OP_LMUL] = {"lmul", OPERAND_NONE, 1, -2},
+    [OP_FMUL] = {"fmul", OPERAND_NONE, 1, -1},
+    [OP_DMUL] = {"dmul", OPERAND_NONE, 1, -2},
+    [OP_IDIV] = {"idiv", OPERAND_NONE, 1, -1},
+    [OP_LDIV] = {"ldiv", OPERAND_NONE, 1, -2},
+    [OP_FDIV] = {"fdiv", OPERAND_NONE, 1, -1},
+    [OP_DDIV] = {"ddiv", OPERAND_NONE, 1, -2},
+    [OP_IREM] = {"irem", OPERAND_NONE, 1, -1},
+    [OP_LREM] = {"lrem", OPERAND_NONE, 1, -2},
+    [OP_FREM] = {"frem", OPERAND_NONE, 1, -1},
+    [OP_DREM] = {"drem", OPERAND_NONE, 1, -2},
+    [OP_INEG] = {"ineg", OPERAND_NONE, 1, 0},
+    [OP_LNEG] = {"lneg", OPERAND_NONE, 1, 0},
+    [OP_FNEG] = {"fneg", OPERAND_NONE, 1, 0},
+    [OP_DNEG] = {"dneg", OPERAND_NONE, 1, 0},
+    [OP_ISHL] = {"ishl", OPERAND_NONE, 1, -1},
+    [OP_LSHL] = {"lshl", OPERAND_NONE, 1, -1},
+    [OP_ISHR] = {"ishr", OPERAND_NONE, 1, -1},
+    [OP_LSHR] = {"lshr", OPERAND_NONE, 1, -1},
+    [OP_IUSHR] = {"iushr", OPERAND_NONE, 1, -1},
+    [OP_LUSHR] = {"lushr", OPERAND_NONE, 1, -1},
+    [OP_IAND] = {"iand", OPERAND_NONE, 1, -1},
+    [OP_LAND] = {"land", OPERAND_NONE, 1, -2},
+    [OP_IOR] = {"ior", OPERAND_NONE, 1, -1},
+    [OP_LOR] = {"lor", OPERAND_NONE, 1, -2},
+    [OP_IXOR] = {"ixor", OPERAND_NONE, 1, -1},
+    [OP_LXOR] = {"lxor", OPERAND_NONE, 1, -2},
+    [OP_IINC] = {"iinc", OPERAND_U8_I8, 3, 0},
+    [OP_I2L] = {"i2l", OPERAND_NONE, 1, 1},
+    [OP_I2F] = {"i2f", OPERAND_NONE, 1, 0},
+    [OP_I2D] = {"i2d", OPERAND_NONE, 1, 1},
+    [OP_L2I] = {"l2i", OPERAND_NONE, 1, -1},
+    [OP_L2F] = {"l2f", OPERAND_NONE, 1, -1},
+    [OP_L2D] = {"l2d", OPERAND_NONE, 1, 0},
+    [OP_F2I] = {"f2i", OPERAND_NONE, 1, 0},
+    [OP_F2L] = {"f2l", OPERAND_NONE, 1, 1},
+    [OP_F2D] = {"f2d", OPERAND_NONE, 1, 1},
+    [OP_D2I] = {"d2i", OPERAND_NONE, 1, -1},
+    [OP_D2L] = {"d2l", OPERAND_NONE, 1, 0},
+    [OP_D2F] = {"d2f", OPERAND_NONE, 1, -1},
+    [OP_I2B] = {"i2b", OPERAND_NONE, 1, 0},
+    [OP_I2C] = {"i2c", OPERAND_NONE, 1, 0},
+    [OP_I2S] = {"i2s", OPERAND_NONE, 1, 0},
+    [OP_LCMP] = {"lcmp", OPERAND_NONE, 1, -3},
+    [OP_FCMPL] = {"fcmpl", OPERAND_NONE, 1, -1},
+    [OP_FCMPG] = {"fcmpg", OPERAND_NONE, 1, -1},
+    [OP_DCMPL] = {"dcmpl", OPERAND_NONE, 1, -3},
+    [OP_DCMPG] = {"dcmpg", OPERAND_NONE, 1, -3},
+    [OP_IFEQ] = {"ifeq", OPERAND_I16, 3, -1},
+    [OP_IFNE] = {"ifne", OPERAND_I16, 3, -1},
+    [OP_IFLT] = {"iflt", OPERAND_I16, 3, -1},
+    [OP_IFGE] = {"ifge", OPERAND_I16, 3, -1},
+    [OP_IFGT] = {"ifgt", OPERAND_I16, 3, -1},
+    [OP_IFLE] = {"ifle", OPERAND_I16, 3, -1},
+    [OP_IF_ICMPEQ] = {"if_icmpeq", OPERAND_I16, 3, -2},
+    [OP_IF_ICMPNE] = {"if_icmpne", OPERAND_I16, 3, -2},
+    [OP_IF_ICMPLT] = {"if_icmplt", OPERAND_I16, 3, -2},
+    [OP_IF_ICMPGE] = {"if_icmpge", OPERAND_I16, 3, -2},
+    [OP_IF_ICMPGT] = {"if_icmpgt", OPERAND_I16, 3, -2},
+    [OP_IF_ICMPLE] = {"if_icmple", OPERAND_I16, 3, -2},
+    [OP_IF_ACMPEQ] = {"if_acmpeq", OPERAND_I16, 3, -2},
+    [OP_IF_ACMPNE] = {"if_acmpne", OPERAND_I16, 3, -2},
+    [OP_GOTO] = {"goto", OPERAND_I16, 3, 0},
+    [OP_JSR] = {"jsr", OPERAND_I16, 3, 1},
+    [OP_RET] = {"ret", OPERAND_U8, 2, 0},
+    [OP_TABLESWITCH] = {"tableswitch", OPERAND_TABLE_SWITCH, 0, -1},
+    [OP_LOOKUPSWITCH] = {"lookupswitch", OPERAND_LOOKUP_SWITCH, 0, -1},
+    [OP_IRETURN] = {"ireturn", OPERAND_NONE, 1, -1},
+    [OP_LRETURN] = {"lreturn", OPERAND_NONE, 1, -2},
+    [OP_FRETURN] = {"freturn", OPERAND_NONE, 1, -1},
+    [OP_DRETURN] = {"dreturn", OPERAND_NONE, 1, -2},
+    [OP_ARETURN] = {"areturn", OPERAND_NONE, 1, -1},
+    [OP_RETURN] = {"return", OPERAND_NONE, 1, 0},
+    [OP_GETSTATIC] = {"getstatic", OPERAND_U16, 3, OP_STACK_VARIES},
+    [OP_PUTSTATIC] = {"putstatic", OPERAND_U16, 3, OP_STACK_VARIES},
+    [OP_GETFIELD] = {"getfield", OPERAND_U16, 3, OP_STACK_VARIES},
+    [OP_PUTFIELD] = {"putfield", OPERAND_U16, 3, OP_STACK_VARIES},
+    [OP_INVOKEVIRTUAL] = {"invokevirtual", OPERAND_U16, 3, OP_STACK_VARIES},
+    [OP_INVOKESPECIAL] = {"invokespecial", OPERAND_U16, 3, OP_STACK_VARIES},
+    [OP_INVOKESTATIC] = {"invokestatic", OPERAND_U16, 3, OP_STACK_VARIES},
+    [OP_INVOKEINTERFACE] =
+        {"invokeinterface", OPERAND_U16_U8_U8, 5, OP_STACK_VARIES},
+    [OP_INVOKEDYNAMIC] =
+        {"invokedynamic", OPERAND_U16_U16, 5, OP_STACK_VARIES},
+    [OP_NEW] = {"new", OPERAND_U16, 3, 1},
+    [OP_NEWARRAY] = {"newarray", OPERAND_U8, 2, 0},
+    [OP_ANEWARRAY] = {"anewarray", OPERAND_U16, 3, 0},
+    [OP_ARRAYLENGTH] = {"arraylength", OPERAND_NONE, 1, 0},
+    [OP_ATHROW] = {"athrow", OPERAND_NONE, 1, -1},
+    [OP_CHECKCAST] = {"checkcast", OPERAND_U16, 3, 0},
+    [OP_INSTANCEOF] = {"instanceof", OPERAND_U16, 3, 0},
+    [OP_MONITORENTER] = {"monitorenter", OPERAND_NONE, 1, -1},
+    [OP_MONITOREXIT] = {"monitorexit", OPERAND_NONE, 1, -1},
+    [OP_WIDE] = {"wide", OPERAND_WIDE, 0, OP_STACK_VARIES},
+    [OP_MULTIANEWARRAY] =
+        {"multianewarray", OPERAND_U16_U8, 4, OP_STACK_VARIES},
+    [OP_IFNULL] = {"ifnull", OPERAND_I16, 3, -1},
+    [OP_IFNONNULL] = {"ifnonnull", OPERAND_I16, 3, -1},
+    [OP_GOTO_W] = {"goto_w", OPERAND_I32, 5, 0},
+    [OP_JSR_W] = {"jsr_w", OPERAND_I32, 5, 1},
+    [OP_BREAKPOINT] = {"breakpoint", OPERAND_NONE, 1, 0},
+    [OP_IMPDEP1] = {"impdep1", OPERAND_NONE, 1, 0},
+    [OP_IMPDEP2] = {"impdep2", OPERAND_NONE, 1, 0},
+};
+
+/* NOTE: `tableswitch` and `lookupswitch` operands start at the next multiple
+ * of four from the start of the method's code. */
+u32 get_switch_padding(u32 pc) {
+    return (4 - ((pc + 1) & 3)) & 3;
+}
+
+/* NOTE: Returns zero for an undefined opcode, a `wide` of one that cannot
+ * be widened, or an instruction that does not fit in the `byte_count` bytes
+ * of code, so callers can walk untrusted code without reading past it. */
+u32 get_op_code_size(const u8* bytes, u32 pc, u32 byte_count) {
+    const OpCodeInfo* info = &OP_CODES[bytes[pc]];
+    if (info->mnemonic == NULL) {
+        return 0;
+    }
+    u64 size = info->size;
+    u32 i = pc + 1;
+    switch (info->layout) {
+    case OPERAND_TABLE_SWITCH: {
+        i += get_switch_padding(pc) + 4;
+        if (byte_count < (i + 8)) {
+            return 0;
+        }
+        i32 low = (i32)get_u32_be(&bytes[i]);
+        i32 high = (i32)get_u32_be(&bytes[i + 4]);
+        i += 8;
+        if (high < low) {
+            return 0;
+        }
+        size = (i - pc) + ((((u64)high - (u64)low) + 1) * 4);
+        break;
+    }
+    case OPERAND_LOOKUP_SWITCH: {
+        i += get_switch_padding(pc) + 4;
+        if (byte_count < (i + 4)) {
+            return 0;
+        }
+        u32 pair_count = get_u32_be(&bytes[i]);
+        i += 4;
+        size = (i - pc) + ((u64)pair_count * 8);
+        break;
+    }
+    case OPERAND_WIDE: {
+        if ((byte_count <= i) || !is_wide_op_code(bytes[i])) {
+            return 0;
+        }
+        size = bytes[i] == OP_IINC ? 6 : 4;
+        break;
+    }
+    case OPERAND_NONE:
+    case OPERAND_U8:
+    case OPERAND_I8:
+    case OPERAND_U16:
+    case OPERAND_I16:
+    case OPERAND_I32:
+    case OPERAND_U8_I8:
+    case OPERAND_U16_U8:
+    case OPERAND_U16_U8_U8:
+    case OPERAND_U16_U16: {
+        break;
+    }
+    }
+    if ((u64)(byte_count - pc) < size) {
+        return 0;
+    }
+    return (u32)size;
+}
+
+/* NOTE: Only the loads, stores, `ret` and `iinc`, the opcodes taking a
+ * local index, can be widened. */
+Bool is_wide_op_code(OpCode op_code) {
+    return ((OP_ILOAD <= op_code) && (op_code <= OP_ALOAD)) ||
+           ((OP_ISTORE <= op_code) && (op_code <= OP_ASTORE)) ||
+           (op_code == OP_RET) || (op_code == OP_IINC);
+}
+
+/* NOTE: Every opcode with a pc-relative `i16` or `i32` target; the
+ * switches are handled separately since they carry many. */
+Bool is_branch_op_code(OpCode op_code) {
+    return ((OP_IFEQ <= op_code) && (op_code <= OP_JSR)) ||
+           (op_code == OP_IFNULL) || (op_code == OP_IFNONNULL) ||
+           (op_code == OP_GOTO_W) || (op_code == OP_JSR_W);
+}
+
+/* NOTE: `jsr` counts as falling through, to its return point; the `ret`
+ * that gets there is an exit as far as the graph can tell. */
+Bool is_fall_through_op_code(OpCode op_code) {
+    return (op_code != OP_GOTO) && (op_code != OP_GOTO_W) &&
+           (op_code != OP_RET) && (op_code != OP_TABLESWITCH) &&
+           (op_code != OP_LOOKUPSWITCH) && (op_code != OP_ATHROW) &&
+           ((op_code < OP_IRETURN) || (OP_RETURN < op_code));
+}
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef __PARSE_ERROR_H__
+#define __PARSE_ERROR_H__
+
+#include <stdint.h>
+
+/* NOTE: Shared by the parser and the public `jsmr.h`, so it sticks to
+ * fixed-width fields; `-fshort-enums` would otherwise change the layout
+ * between the library and whoever links it. */
+
+typedef enum {
+    PARSE_OK = 0,
+    PARSE_OUT_OF_BOUNDS,
+    PARSE_OUT_OF_MEMORY,
+    PARSE_BAD_MAGIC,
+    PARSE_BAD_CONSTANT_TAG,
+    PARSE_BAD_CONSTANT_INDEX,
+    PARSE_BAD_UTF8,
+    PARSE_BAD_VERIFICATION_TYPE,
+    PARSE_BAD_STACK_MAP_FRAME,
+    PARSE_BAD_METHOD_RANGE,
+    PARSE_BAD_INSTRUCTION,
+    PARSE_BAD_CODE_OFFSET,
+    PARSE_BAD_DESCRIPTOR,
+    PARSE_BAD_STACK,
+    PARSE_BAD_LOCAL,
+    PARSE_BAD_TYPE,
+    PARSE_BAD_FRAME,
+    COUNT_PARSE_ERRORS,
+} ParseErrorCode;
+
+typedef struct {
+    uint32_t offset;
+    uint32_t code;
+} ParseError;
+
+#endif
@@ -10,17 +10,19 @@ typedef FILE File;
 typedef uint8_t  u8;
 typedef uint16_t u16;
 typedef uint32_t u32;
+typedef uint64_t u64;
 
 typedef int8_t  i8;
 typedef int16_t i16;
 typedef int32_t i32;
+typedef int64_t i64;
 
 typedef enum {
     FALSE = 0,
     TRUE,
 } Bool;
 
-static u16 get_len(const char* x) {
+__attribute__((unused)) static u16 get_len(const char* x) {
     u16 i = 0;
     while (x[i] != '\0') {
         ++i;
@@ -28,7 +30,7 @@ static u16 get_len(const char* x) {
     return i;
 }
 
-static Bool get_eq(const char* a, const char* b) {
+__attribute__((unused)) static Bool get_eq(const char* a, const char* b) {
     u16 n = get_len(a);
     if (n != get_len(b)) {
         return FALSE;
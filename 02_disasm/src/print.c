@@ -3,334 +3,445 @@
 
 #include "print.h"
 
-void print_op_codes(const u8* bytes, u32 byte_count) {
-    printf("    {\n");
-    for (u32 i = 0; i < byte_count;) {
-        printf("      #%-4u ", i);
-        OpCode op_code = bytes[i++];
-        switch (op_code) {
-        case OP_ALOAD_0: {
-            printf("aload_0\n");
-            break;
-        }
-        case OP_INVOKESPECIAL: {
-            printf(OP_FMT_U16,
-                   "invokespecial",
-                   pop_u16_at(bytes, &i, byte_count));
-            break;
-        }
-        case OP_RETURN: {
-            printf("return\n");
-            break;
-        }
-        case OP_GETFIELD: {
-            printf(OP_FMT_U16, "getfield", pop_u16_at(bytes, &i, byte_count));
-            break;
-        }
-        case OP_IFNE: {
-            printf(OP_FMT_I16, "ifne", (i16)pop_u16_at(bytes, &i, byte_count));
-            break;
-        }
-        case OP_IRETURN: {
-            printf("ireturn\n");
-            break;
-        }
-        case OP_IF_ICMPNE: {
-            printf(OP_FMT_I16,
-                   "if_icmpne",
-                   (i16)pop_u16_at(bytes, &i, byte_count));
-            break;
-        }
-        case OP_ISTORE_1: {
-            printf("istore_1\n");
-            break;
-        }
-        case OP_ISTORE_2: {
-            printf("istore_2\n");
-            break;
-        }
-        case OP_ISTORE_3: {
-            printf("istore_3\n");
-            break;
-        }
-        case OP_ICONST_0: {
-            printf("iconst_0\n");
-            break;
-        }
-        case OP_ICONST_1: {
-            printf("iconst_1\n");
-            break;
-        }
-        case OP_ICONST_2: {
-            printf("iconst_2\n");
-            break;
-        }
-        case OP_ICONST_3: {
-            printf("iconst_3\n");
-            break;
-        }
-        case OP_ISTORE: {
-            printf(OP_FMT_U8, "istore", pop_u8_at(bytes, &i, byte_count));
-            break;
-        }
-        case OP_ILOAD: {
-            printf(OP_FMT_U8, "iload", pop_u8_at(bytes, &i, byte_count));
-            break;
-        }
-        case OP_IF_ICMPGE: {
-            printf(OP_FMT_I16,
-                   "if_icmpge",
-                   (i16)pop_u16_at(bytes, &i, byte_count));
-            break;
-        }
-        case OP_ILOAD_2: {
-            printf("iload_2\n");
-            break;
-        }
-        case OP_ILOAD_3: {
-            printf("iload_3\n");
-            break;
-        }
-        case OP_ILOAD_1: {
-            printf("iload_1\n");
-            break;
-        }
-        case OP_IADD: {
-            printf("iadd\n");
-            break;
-        }
-        case OP_ISUB: {
-            printf("isub\n");
-            break;
-        }
-        case OP_IINC: {
-            u8 index = pop_u8_at(bytes, &i, byte_count);
-            i8 constant = (i8)pop_u8_at(bytes, &i, byte_count);
-            printf(OP_FMT_U8_I8, "iinc", index, constant);
-            break;
-        }
-        case OP_GOTO: {
-            printf(OP_FMT_I16, "goto", (i16)pop_u16_at(bytes, &i, byte_count));
-            break;
+void print_field(Buffer* buffer, u32 value, const char* label) {
+    put_spaces(buffer, 2);
+    put_u32_pad(buffer, value, 18);
+    put_str(buffer, label);
+}
+
+void print_field_pair(Buffer*     buffer,
+                      u32         a,
+                      u32         b,
+                      const char* label) {
+    put_spaces(buffer, 2);
+    put_u32_pad(buffer, a, 4);
+    put_u32_pad(buffer, b, 14);
+    put_str(buffer, label);
+}
+
+void print_field_triple(Buffer*     buffer,
+                        u32         a,
+                        u32         b,
+                        u32         c,
+                        const char* label) {
+    put_spaces(buffer, 2);
+    put_u32_pad(buffer, a, 4);
+    put_u32_pad(buffer, b, 4);
+    put_u32_pad(buffer, c, 10);
+    put_str(buffer, label);
+}
+
+void print_field_quad(Buffer*     buffer,
+                      u32         a,
+                      u32         b,
+                      u32         c,
+                      u32         d,
+                      const char* label) {
+    put_spaces(buffer, 2);
+    put_u32_pad(buffer, a, 4);
+    put_u32_pad(buffer, b, 4);
+    put_u32_pad(buffer, c, 4);
+    put_u32_pad(buffer, d, 6);
+    put_str(buffer, label);
+}
+
+void put_utf8(Buffer* buffer, ConstantUtf8 utf8) {
+    reserve_buffer(buffer, utf8.size);
+    buffer->size += set_mutf8_to_utf8(utf8.bytes,
+                                      utf8.size,
+                                      (u8*)&buffer->chars[buffer->size]);
+}
+
+void print_op_mnemonic(Buffer* buffer, const char* mnemonic) {
+    put_str_pad(buffer, mnemonic, WIDTH_OP_MNEMONIC);
+    put_char(buffer, ' ');
+}
+
+void print_switch(Buffer*   buffer,
+                  Memory*   memory,
+                  const u8* bytes,
+                  u32*      index,
+                  u32       byte_count,
+                  u32       pc,
+                  OpCode    op_code) {
+    *index += get_switch_padding(pc);
+    i32 default_offset = (i32)pop_u32_at(memory, bytes, index, byte_count);
+    if (op_code == OP_TABLESWITCH) {
+        i32 low = (i32)pop_u32_at(memory, bytes, index, byte_count);
+        i32 high = (i32)pop_u32_at(memory, bytes, index, byte_count);
+        print_op_mnemonic(buffer, "tableswitch");
+        put_i32_pad(buffer, low, WIDTH_OP_OPERAND);
+        put_i32(buffer, high);
+        put_char(buffer, '\n');
+        for (i64 key = low; key <= high; ++key) {
+            put_spaces(buffer, WIDTH_SWITCH_PAD);
+            put_i32_pad(buffer, (i32)key, WIDTH_OP_OPERAND);
+            put_i32(buffer, (i32)pop_u32_at(memory, bytes, index, byte_count));
+            put_char(buffer, '\n');
+        }
+    } else {
+        u32 pair_count = pop_u32_at(memory, bytes, index, byte_count);
+        print_op_mnemonic(buffer, "lookupswitch");
+        put_u32(buffer, pair_count);
+        put_char(buffer, '\n');
+        for (u32 i = 0; i < pair_count; ++i) {
+            i32 key = (i32)pop_u32_at(memory, bytes, index, byte_count);
+            put_spaces(buffer, WIDTH_SWITCH_PAD);
+            put_i32_pad(buffer, key, WIDTH_OP_OPERAND);
+            put_i32(buffer, (i32)pop_u32_at(memory, bytes, index, byte_count));
+            put_char(buffer, '\n');
         }
-        case OP_BIPUSH: {
-            printf(OP_FMT_U8, "bipush", pop_u8_at(bytes, &i, byte_count));
+    }
+    put_spaces(buffer, WIDTH_SWITCH_PAD);
+    put_str(buffer, "default ");
+    put_i32(buffer, default_offset);
+    put_char(buffer, '\n');
+}
+
+/* NOTE: Points the error at the instruction, as the JSON view does. */
+_Noreturn void set_op_code_error(Memory* memory, const u8* bytes, u32 pc) {
+    set_parse_error_at(memory, bytes, pc, PARSE_BAD_INSTRUCTION);
+}
+
+void print_wide(Buffer*   buffer,
+                Memory*   memory,
+                const u8* bytes,
+                u32*      index,
+                u32       byte_count) {
+    OpCode            op_code = pop_u8_at(memory, bytes, index, byte_count);
+    const OpCodeInfo* info = &OP_CODES[op_code];
+    u16 local = pop_u16_at(memory, bytes, index, byte_count);
+    put_str(buffer, "wide ");
+    put_str_pad(buffer, info->mnemonic, WIDTH_WIDE);
+    if (op_code == OP_IINC) {
+        put_u32_pad(buffer, local, WIDTH_OP_OPERAND);
+        put_i32(buffer, (i16)pop_u16_at(memory, bytes, index, byte_count));
+    } else {
+        put_u32(buffer, local);
+    }
+    put_char(buffer, '\n');
+}
+
+void print_resolved(Buffer* buffer, Resolver* resolver, u16 index) {
+    if (resolver == NULL) {
+        return;
+    }
+    Resolved resolved = get_resolved(resolver, index);
+    put_str(buffer, " // ");
+    put_chars(buffer, resolved.chars, resolved.size);
+}
+
+/* NOTE: Each instruction is sized before it is printed, so the operand
+ * reads below stay inside the code; a reserved opcode or one cut short
+ * ends the listing with a parse error rather than the process. */
+void print_op_codes(Buffer*   buffer,
+                    Memory*   memory,
+                    Resolver* resolver,
+                    const u8* bytes,
+                    u32       byte_count) {
+    put_str(buffer, "    {\n");
+    for (u32 i = 0; i < byte_count;) {
+        if (get_op_code_size(bytes, i, byte_count) == 0) {
+            put_str(buffer, "    }\n");
+            set_op_code_error(memory, bytes, i);
+        }
+        put_str(buffer, "      #");
+        put_u32_pad(buffer, i, 4);
+        put_char(buffer, ' ');
+        u32               pc = i;
+        OpCode            op_code = bytes[i++];
+        const OpCodeInfo* info = &OP_CODES[op_code];
+        const char*       mnemonic = info->mnemonic;
+        switch (info->layout) {
+        case OPERAND_NONE: {
+            put_str(buffer, mnemonic);
             break;
         }
-        case OP_NEW: {
-            printf(OP_FMT_U16, "new", pop_u16_at(bytes, &i, byte_count));
+        case OPERAND_U8: {
+            u8 operand = pop_u8_at(memory, bytes, &i, byte_count);
+            print_op_mnemonic(buffer, mnemonic);
+            put_u32(buffer, operand);
+            if (op_code == OP_LDC) {
+                print_resolved(buffer, resolver, operand);
+            }
             break;
         }
-        case OP_DUP: {
-            printf("dup\n");
+        case OPERAND_I8: {
+            print_op_mnemonic(buffer, mnemonic);
+            put_i32(buffer, (i8)pop_u8_at(memory, bytes, &i, byte_count));
             break;
         }
-        case OP_ASTORE_2: {
-            printf("astore_2\n");
+        case OPERAND_U16: {
+            u16 index = pop_u16_at(memory, bytes, &i, byte_count);
+            print_op_mnemonic(buffer, mnemonic);
+            put_u32(buffer, index);
+            print_resolved(buffer, resolver, index);
             break;
         }
-        case OP_ALOAD_2: {
-            printf("aload_2\n");
+        case OPERAND_I16: {
+            print_op_mnemonic(buffer, mnemonic);
+            put_i32(buffer, (i16)pop_u16_at(memory, bytes, &i, byte_count));
             break;
         }
-        case OP_PUTFIELD: {
-            printf(OP_FMT_U16, "putfield", pop_u16_at(bytes, &i, byte_count));
+        case OPERAND_I32: {
+            print_op_mnemonic(buffer, mnemonic);
+            put_i32(buffer, (i32)pop_u32_at(memory, bytes, &i, byte_count));
             break;
         }
-        case OP_GETSTATIC: {
-            printf(OP_FMT_U16, "getstatic", pop_u16_at(bytes, &i, byte_count));
+        case OPERAND_U8_I8: {
+            u8 index = pop_u8_at(memory, bytes, &i, byte_count);
+            i8 constant = (i8)pop_u8_at(memory, bytes, &i, byte_count);
+            print_op_mnemonic(buffer, mnemonic);
+            put_u32_pad(buffer, index, WIDTH_OP_OPERAND);
+            put_i32(buffer, constant);
             break;
         }
-        case OP_INVOKESTATIC: {
-            printf(OP_FMT_U16,
-                   "invokestatic",
-                   pop_u16_at(bytes, &i, byte_count));
+        case OPERAND_U16_U8: {
+            u16 index = pop_u16_at(memory, bytes, &i, byte_count);
+            u8  dimensions = pop_u8_at(memory, bytes, &i, byte_count);
+            print_op_mnemonic(buffer, mnemonic);
+            put_u32_pad(buffer, index, WIDTH_OP_OPERAND);
+            put_u32(buffer, dimensions);
+            print_resolved(buffer, resolver, index);
             break;
         }
-        case OP_INVOKEVIRTUAL: {
-            printf(OP_FMT_U16,
-                   "invokevirtual",
-                   pop_u16_at(bytes, &i, byte_count));
+        case OPERAND_U16_U8_U8: {
+            u16 index = pop_u16_at(memory, bytes, &i, byte_count);
+            u8  count = pop_u8_at(memory, bytes, &i, byte_count);
+            pop_u8_at(memory, bytes, &i, byte_count);
+            print_op_mnemonic(buffer, mnemonic);
+            put_u32_pad(buffer, index, WIDTH_OP_OPERAND);
+            put_u32(buffer, count);
+            print_resolved(buffer, resolver, index);
             break;
         }
-        case OP_LDC: {
-            printf(OP_FMT_U8, "ldc", pop_u8_at(bytes, &i, byte_count));
+        case OPERAND_U16_U16: {
+            u16 index = pop_u16_at(memory, bytes, &i, byte_count);
+            pop_u16_at(memory, bytes, &i, byte_count);
+            print_op_mnemonic(buffer, mnemonic);
+            put_u32(buffer, index);
+            print_resolved(buffer, resolver, index);
             break;
         }
-        case OP_ILOAD_0: {
-            printf("iload_0\n");
-            break;
+        case OPERAND_TABLE_SWITCH:
+        case OPERAND_LOOKUP_SWITCH: {
+            print_switch(buffer, memory, bytes, &i, byte_count, pc, op_code);
+            continue;
         }
-        default: {
-            fflush(stdout);
-            fprintf(stderr,
-                    "\n[ERROR] `{ OpCode op_code (%hhu) }` "
-                    "unimplemented\n\n",
-                    (u8)op_code);
-            exit(EXIT_FAILURE);
+        case OPERAND_WIDE: {
+            print_wide(buffer, memory, bytes, &i, byte_count);
+            continue;
         }
         }
+        put_char(buffer, '\n');
     }
-    printf("    }\n");
+    put_str(buffer, "    }\n");
 }
 
-void print_verification_table(const VerificationType* verification_types,
+void print_verification_table(Buffer*                 buffer,
+                              const VerificationType* verification_types,
                               u16 verification_type_count) {
     for (u16 i = 0; i < verification_type_count; ++i) {
         VerificationType verification_type = verification_types[i];
         switch (verification_type.tag) {
         case VERI_TOP: {
-            printf(TOKEN_FMT_U8 "(u8 VerificationItem.Top)\n",
-                   verification_type.bit_tag);
+            print_field(buffer,
+                        verification_type.bit_tag,
+                        "(u8 VerificationItem.Top)\n");
             break;
         }
         case VERI_INTEGER: {
-            printf(TOKEN_FMT_U8 "(u8 VerificationItem.Integer)\n",
-                   verification_type.bit_tag);
+            print_field(buffer,
+                        verification_type.bit_tag,
+                        "(u8 VerificationItem.Integer)\n");
             break;
         }
         case VERI_FLOAT: {
-            printf(TOKEN_FMT_U8 "(u8 VerificationItem.Float)\n",
-                   verification_type.bit_tag);
+            print_field(buffer,
+                        verification_type.bit_tag,
+                        "(u8 VerificationItem.Float)\n");
             break;
         }
         case VERI_DOUBLE: {
-            printf(TOKEN_FMT_U8 "(u8 VerificationItem.Double)\n",
-                   verification_type.bit_tag);
+            print_field(buffer,
+                        verification_type.bit_tag,
+                        "(u8 VerificationItem.Double)\n");
             break;
         }
         case VERI_LONG: {
-            printf(TOKEN_FMT_U8 "(u8 VerificationItem.Long)\n",
-                   verification_type.bit_tag);
+            print_field(buffer,
+                        verification_type.bit_tag,
+                        "(u8 VerificationItem.Long)\n");
             break;
         }
         case VERI_NULL: {
-            printf(TOKEN_FMT_U8 "(u8 VerificationItem.Null)\n",
-                   verification_type.bit_tag);
+            print_field(buffer,
+                        verification_type.bit_tag,
+                        "(u8 VerificationItem.Null)\n");
             break;
         }
         case VERI_UNINIT_THIS: {
-            printf(TOKEN_FMT_U8 "(u8 VerificationItem.UninitThis)\n",
-                   verification_type.bit_tag);
+            print_field(buffer,
+                        verification_type.bit_tag,
+                        "(u8 VerificationItem.UninitThis)\n");
             break;
         }
         case VERI_OBJECT: {
-            printf(TOKEN_FMT_U8_U16 "(u8 VerificationItem.Object)\n",
-                   verification_type.bit_tag,
-                   verification_type.constant_pool_index);
+            print_field_pair(buffer,
+                             verification_type.bit_tag,
+                             verification_type.constant_pool_index,
+                             "(u8 VerificationItem.Object)\n");
             break;
         }
         case VERI_UNINIT: {
-            printf(TOKEN_FMT_U8_U16 "(u8 VerificationItem.Uninit)\n",
-                   verification_type.bit_tag,
-                   verification_type.offset);
+            print_field_pair(buffer,
+                             verification_type.bit_tag,
+                             verification_type.offset,
+                             "(u8 VerificationItem.Uninit)\n");
             break;
         }
         }
     }
 }
 
-void print_attribute(Attribute* attribute) {
-    printf("\n  %-4hu%-14u(u16 AttributeNameIndex, u32 AttributeSize)\n"
-           "                    ",
-           attribute->name_index,
-           attribute->size);
+void print_attribute(Buffer*          buffer,
+                     Memory*          memory,
+                     Resolver*        resolver,
+                     const Attribute* attribute) {
+    put_char(buffer, '\n');
+    print_field_pair(buffer,
+                     attribute->name_index,
+                     attribute->size,
+                     "(u16 AttributeNameIndex, u32 AttributeSize)\n"
+                     TOKEN_PAD);
     switch (attribute->tag) {
     case ATTRIB_CODE: {
-        printf("[ CodeAttribute ]\n");
-        printf("  %-4hu%-4hu%-10u"
-               "(u16 CodeMaxStack, u16 CodeMaxLocal, u32 CodeByteCount)\n",
-               attribute->code.max_stack,
-               attribute->code.max_local,
-               attribute->code.byte_count);
-        print_op_codes(attribute->code.bytes, attribute->code.byte_count);
-        printf(TOKEN_FMT_U16 "(u16 CodeExceptionTableCount)\n",
-               attribute->code.exception_table_count);
-        printf(TOKEN_FMT_U16 "(u16 CodeAttributeCount)\n",
-               attribute->code.attribute_count);
-        Attribute* code_attribute = attribute->code.attributes;
-        for (u16 _ = 0; _ < attribute->code.attribute_count; ++_) {
-            if (code_attribute != NULL) {
-                print_attribute(code_attribute);
-                code_attribute = code_attribute->next_attribute;
-            }
+        put_str(buffer, "[ CodeAttribute ]\n");
+        print_field_triple(buffer,
+                           attribute->code.max_stack,
+                           attribute->code.max_local,
+                           attribute->code.byte_count,
+                           "(u16 CodeMaxStack, u16 CodeMaxLocal, "
+                           "u32 CodeByteCount)\n");
+        print_op_codes(buffer,
+                       memory,
+                       resolver,
+                       attribute->code.bytes,
+                       attribute->code.byte_count);
+        print_field(buffer,
+                    attribute->code.exception_table_count,
+                    "(u16 CodeExceptionTableCount)\n");
+        for (u16 i = 0; i < attribute->code.exception_table_count; ++i) {
+            ExceptionTable exception = attribute->code.exception_table[i];
+            print_field_quad(buffer,
+                             exception.pc_start,
+                             exception.pc_end,
+                             exception.pc_handler,
+                             exception.catch_type,
+                             "(u16 PcStart, u16 PcEnd, u16 PcHandler, "
+                             "u16 CatchType)\n");
+        }
+        print_field(buffer,
+                    attribute->code.attribute_count,
+                    "(u16 CodeAttributeCount)\n");
+        for (u32 i = attribute->code.attributes; i != 0;
+             i = get_attribute_at(memory, i)->next_attribute)
+        {
+            print_attribute(buffer,
+                            memory,
+                            resolver,
+                            get_attribute_at(memory, i));
         }
         break;
     }
     case ATTRIB_LINE_NUMBER_TABLE: {
-        printf("[ LineNumberTableAttribute ]\n");
+        put_str(buffer, "[ LineNumberTableAttribute ]\n");
         u16 line_number_table_count = attribute->line_number_table.count;
-        printf(TOKEN_FMT_U16 "(u16 LineNumberTableCount)\n",
-               line_number_table_count);
+        print_field(buffer,
+                    line_number_table_count,
+                    "(u16 LineNumberTableCount)\n");
         for (u16 i = 0; i < line_number_table_count; ++i) {
             LineNumberEntry line_number_entry =
                 attribute->line_number_table.entries[i];
-            printf("  %-4hu%-14hu(u16 PcStart, u16 LineNumber)\n",
-                   line_number_entry.pc_start,
-                   line_number_entry.line_number);
+            print_field_pair(buffer,
+                             line_number_entry.pc_start,
+                             line_number_entry.line_number,
+                             "(u16 PcStart, u16 LineNumber)\n");
         }
         break;
     }
     case ATTRIB_STACK_MAP_TABLE: {
-        printf("[ StackMapTableAttribute ]\n");
+        put_str(buffer, "[ StackMapTableAttribute ]\n");
         for (u16 i = 0; i < attribute->stack_map_table.count; ++i) {
             StackMapEntry stack_map_entry =
                 attribute->stack_map_table.entries[i];
             switch (stack_map_entry.tag) {
             case STACK_MAP_SAME_FRAME: {
-                printf(TOKEN_FMT_U8 "(u8 SameFrame)\n",
-                       stack_map_entry.bit_tag);
+                print_field(buffer,
+                            stack_map_entry.bit_tag,
+                            "(u8 SameFrame)\n");
                 break;
             }
             case STACK_MAP_SAME_LOCALS_1_STACK_ITEM_FRAME: {
-                printf(TOKEN_FMT_U8 "(u8 SameLocals1StackItemFrame)\n",
-                       stack_map_entry.bit_tag);
-                print_verification_table(stack_map_entry.stack_items,
+                print_field(buffer,
+                            stack_map_entry.bit_tag,
+                            "(u8 SameLocals1StackItemFrame)\n");
+                print_verification_table(buffer,
+                                         stack_map_entry.stack_items,
                                          stack_map_entry.stack_item_count);
                 break;
             }
             case STACK_MAP_SAME_LOCALS_1_STACK_ITEM_FRAME_EXTENDED: {
-                printf(TOKEN_FMT_U8_U16
-                       "(u8 SameLocals1StackItemFrameExtended, "
-                       "u16 OffsetDelta)\n",
-                       stack_map_entry.bit_tag,
-                       stack_map_entry.offset_delta);
-                print_verification_table(stack_map_entry.stack_items,
+                print_field_pair(buffer,
+                                 stack_map_entry.bit_tag,
+                                 stack_map_entry.offset_delta,
+                                 "(u8 SameLocals1StackItemFrameExtended, "
+                                 "u16 OffsetDelta)\n");
+                print_verification_table(buffer,
+                                         stack_map_entry.stack_items,
                                          stack_map_entry.stack_item_count);
                 break;
             }
             case STACK_MAP_CHOP_FRAME: {
-                printf(TOKEN_FMT_U8_U16 "(u8 ChopFrame, u16 OffsetDelta)\n",
-                       stack_map_entry.bit_tag,
-                       stack_map_entry.offset_delta);
+                print_field_pair(buffer,
+                                 stack_map_entry.bit_tag,
+                                 stack_map_entry.offset_delta,
+                                 "(u8 ChopFrame, u16 OffsetDelta)\n");
                 break;
             }
             case STACK_MAP_SAME_FRAME_EXTENDED: {
-                printf(TOKEN_FMT_U8_U16 "(u8 SameFrameExtended, "
-                                        "u16 OffsetDelta)\n",
-                       stack_map_entry.bit_tag,
-                       stack_map_entry.offset_delta);
+                print_field_pair(buffer,
+                                 stack_map_entry.bit_tag,
+                                 stack_map_entry.offset_delta,
+                                 "(u8 SameFrameExtended, u16 OffsetDelta)\n");
                 break;
             }
             case STACK_MAP_APPEND_FRAME: {
-                printf(TOKEN_FMT_U8_U16 "(u8 AppendFrame, u16 OffsetDelta)\n",
-                       stack_map_entry.bit_tag,
-                       stack_map_entry.offset_delta);
-                print_verification_table(stack_map_entry.local_items,
+                print_field_pair(buffer,
+                                 stack_map_entry.bit_tag,
+                                 stack_map_entry.offset_delta,
+                                 "(u8 AppendFrame, u16 OffsetDelta)\n");
+                print_verification_table(buffer,
+                                         stack_map_entry.local_items,
                                          stack_map_entry.local_item_count);
                 break;
             }
             case STACK_MAP_FULL_FRAME: {
-                printf(TOKEN_FMT_U8_U16 "(u8 FullFrame, u16 OffsetDelta)\n",
-                       stack_map_entry.bit_tag,
-                       stack_map_entry.offset_delta);
-                printf("  %-18hu(u16 LocalItemCount)\n",
-                       stack_map_entry.local_item_count);
-                print_verification_table(stack_map_entry.local_items,
+                print_field_pair(buffer,
+                                 stack_map_entry.bit_tag,
+                                 stack_map_entry.offset_delta,
+                                 "(u8 FullFrame, u16 OffsetDelta)\n");
+                print_field(buffer,
+                            stack_map_entry.local_item_count,
+                            "(u16 LocalItemCount)\n");
+                print_verification_table(buffer,
+                                         stack_map_entry.local_items,
                                          stack_map_entry.local_item_count);
-                printf("  %-18hu(u16 StackItemCount)\n",
-                       stack_map_entry.stack_item_count);
-                print_verification_table(stack_map_entry.stack_items,
+                print_field(buffer,
+                            stack_map_entry.stack_item_count,
+                            "(u16 StackItemCount)\n");
+                print_verification_table(buffer,
+                                         stack_map_entry.stack_items,
                                          stack_map_entry.stack_item_count);
                 break;
             }
@@ -339,277 +450,772 @@ void print_attribute(Attribute* attribute) {
         break;
     }
     case ATTRIB_SOURCE_FILE: {
-        printf("[ SourceFileAttribute ]\n");
-        printf(TOKEN_FMT_U16 "(u16 SourceFileIndex)\n", attribute->u16);
+        put_str(buffer, "[ SourceFileAttribute ]\n");
+        print_field(buffer, attribute->u16, "(u16 SourceFileIndex)\n");
         break;
     }
     case ATTRIB_NEST_MEMBER: {
-        printf("[ NestMember ]\n");
-        printf(TOKEN_FMT_U16 "(u16 NestMemberCount)\n",
-               attribute->nest_member.count);
-        printf("  [");
+        put_str(buffer, "[ NestMember ]\n");
+        print_field(buffer,
+                    attribute->nest_member.count,
+                    "(u16 NestMemberCount)\n");
+        put_str(buffer, "  [");
         for (u16 i = 0; i < attribute->nest_member.count; ++i) {
-            printf(" %hu", attribute->nest_member.classes[i]);
+            put_char(buffer, ' ');
+            put_u32(buffer, attribute->nest_member.classes[i]);
         }
-        printf(" ]\n");
+        put_str(buffer, " ]\n");
         break;
     }
     case ATTRIB_INNER_CLASSES: {
-        printf("[ InnerClasses ]\n");
-        printf(TOKEN_FMT_U16 "(u16 InnerClassesCount)\n",
-               attribute->inner_classes.count);
+        put_str(buffer, "[ InnerClasses ]\n");
+        print_field(buffer,
+                    attribute->inner_classes.count,
+                    "(u16 InnerClassesCount)\n");
         for (u16 i = 0; i < attribute->inner_classes.count; ++i) {
             InnerClassEntry inner_class_entry =
                 attribute->inner_classes.entries[i];
-            printf("  %-4hu%-4hu%-4hu%-6hu"
-                   "(u16 InnerClassInfoIndex, u16 OuterClassInfoIndex,\n"
-                   "                     "
-                   "u16 InnerNameIndex, u16 InnerClassAccessFlags)\n",
-                   inner_class_entry.inner_class_info_index,
-                   inner_class_entry.outer_class_info_index,
-                   inner_class_entry.inner_name_index,
-                   inner_class_entry.inner_class_access_flags);
+            put_spaces(buffer, 2);
+            put_u32_pad(buffer, inner_class_entry.inner_class_info_index, 4);
+            put_u32_pad(buffer, inner_class_entry.outer_class_info_index, 4);
+            put_u32_pad(buffer, inner_class_entry.inner_name_index, 4);
+            put_u32_pad(buffer, inner_class_entry.inner_class_access_flags, 6);
+            put_str(buffer,
+                    "(u16 InnerClassInfoIndex, u16 OuterClassInfoIndex,\n"
+                    "                     "
+                    "u16 InnerNameIndex, u16 InnerClassAccessFlags)\n");
         }
+        break;
+    }
+    case ATTRIB_UNKNOWN: {
+        put_str(buffer, "[ OpaqueAttribute `");
+        put_utf8(buffer, get_utf8(memory, attribute->name_index));
+        put_str(buffer, "` ]\n");
+        break;
     }
     }
 }
 
-void print_tokens(Memory* memory) {
-    const Token* tokens = memory->tokens;
-    for (u32 i = 0; i < memory->token_index; ++i) {
-        Token token = tokens[i];
-        switch (token.tag) {
-        case MAGIC: {
-            printf("  0x%-16X(u32 Magic)\n\n", token.u32);
+void print_token(Buffer*   buffer,
+                 Memory*   memory,
+                 Resolver* resolver,
+                 Token     token) {
+    switch (token.tag) {
+    case MAGIC: {
+        put_str(buffer, "  0x");
+        put_hex_pad(buffer, token.u32, 16);
+        put_str(buffer, "(u32 Magic)\n\n");
+        break;
+    }
+    case MINOR_VERSION: {
+        print_field(buffer, token.u16, "(u16 MinorVersion)\n");
+        break;
+    }
+    case MAJOR_VERSION: {
+        print_field(buffer, token.u16, "(u16 MajorVersion)\n\n");
+        break;
+    }
+    case CONSTANT_POOL_COUNT: {
+        print_field(buffer, token.u16, "(u16 ConstantPoolCount)\n\n");
+        break;
+    }
+    case CONSTANT: {
+        Constant constant = get_constant(memory, token.u16);
+        switch (constant.tag) {
+        case CONSTANT_TAG_UTF8: {
+            put_spaces(buffer, 2);
+            put_u32_pad(buffer, (u8)constant.tag, 4);
+            put_u32_pad(buffer, constant.utf8.size, 4);
+            put_char(buffer, '"');
+            put_utf8(buffer, constant.utf8);
+            put_str(buffer, "\"\n" TOKEN_PAD "#");
+            put_u32_pad(buffer, constant.index, 3);
+            put_str(buffer, " (u8 Constant.Utf8, u16 Length, u8*");
+            put_u32(buffer, constant.utf8.size);
+            put_str(buffer, " String)\n");
+            break;
+        }
+        case CONSTANT_TAG_CLASS: {
+            print_field_pair(buffer,
+                             (u8)constant.tag,
+                             constant.class_.name_index,
+                             "#");
+            put_u32_pad(buffer, constant.index, 3);
+            put_str(buffer, " (u8 Constant.Class, u16 NameIndex)\n");
+            break;
+        }
+        case CONSTANT_TAG_STRING: {
+            print_field_pair(buffer,
+                             (u8)constant.tag,
+                             constant.string.string_index,
+                             "#");
+            put_u32_pad(buffer, constant.index, 3);
+            put_str(buffer, " (u8 Constant.String, u16 StringIndex)\n");
+            break;
+        }
+        case CONSTANT_TAG_INTEGER: {
+            put_spaces(buffer, 2);
+            put_u32_pad(buffer, (u8)constant.tag, 4);
+            put_i32_pad(buffer, (i32)constant.u32, 14);
+            put_char(buffer, '#');
+            put_u32_pad(buffer, constant.index, 3);
+            put_str(buffer, " (u8 Constant.Integer, i32 Bytes)\n");
+            break;
+        }
+        case CONSTANT_TAG_FLOAT: {
+            put_spaces(buffer, 2);
+            put_u32_pad(buffer, (u8)constant.tag, 4);
+            put_str(buffer, "0x");
+            put_hex_pad(buffer, constant.u32, 12);
+            put_char(buffer, '#');
+            put_u32_pad(buffer, constant.index, 3);
+            put_str(buffer, " (u8 Constant.Float, u32 Bytes)\n");
+            break;
+        }
+        case CONSTANT_TAG_LONG:
+        case CONSTANT_TAG_DOUBLE: {
+            put_spaces(buffer, 2);
+            put_u32_pad(buffer, (u8)constant.tag, 4);
+            put_str(buffer, "0x");
+            put_hex_pad(buffer,
+                        ((u64)constant.wide.high_bytes << 32) |
+                            constant.wide.low_bytes,
+                        17);
+            put_char(buffer, '#');
+            put_u32_pad(buffer, constant.index, 3);
+            put_str(buffer,
+                    constant.tag == CONSTANT_TAG_LONG
+                        ? " (u8 Constant.Long, u64 Bytes)\n"
+                        : " (u8 Constant.Double, u64 Bytes)\n");
+            break;
+        }
+        case CONSTANT_TAG_FIELD_REF: {
+            print_field_triple(buffer,
+                               (u8)constant.tag,
+                               constant.ref.class_index,
+                               constant.ref.name_and_type_index,
+                               "#");
+            put_u32_pad(buffer, constant.index, 3);
+            put_str(buffer,
+                    " (u8 Constant.FieldRef, u16 ClassIndex, "
+                    "u16 NameAndTypeIndex)\n");
             break;
         }
-        case MINOR_VERSION: {
-            printf(TOKEN_FMT_U16 "(u16 MinorVersion)\n", token.u16);
+        case CONSTANT_TAG_METHOD_REF: {
+            print_field_triple(buffer,
+                               (u8)constant.tag,
+                               constant.ref.class_index,
+                               constant.ref.name_and_type_index,
+                               "#");
+            put_u32_pad(buffer, constant.index, 3);
+            put_str(buffer,
+                    " (u8 Constant.MethodRef, u16 ClassIndex,\n"
+                    CONSTANT_TAG_PAD "u16 NameAndTypeIndex)\n");
             break;
         }
-        case MAJOR_VERSION: {
-            printf(TOKEN_FMT_U16 "(u16 MajorVersion)\n\n", token.u16);
+        case CONSTANT_TAG_NAME_AND_TYPE: {
+            print_field_triple(buffer,
+                               (u8)constant.tag,
+                               constant.name_and_type.name_index,
+                               constant.name_and_type.descriptor_index,
+                               "#");
+            put_u32_pad(buffer, constant.index, 3);
+            put_str(buffer,
+                    " (u8 Constant.NameAndType, u16 NameIndex,\n"
+                    CONSTANT_TAG_PAD "u16 DescriptorIndex)\n");
             break;
         }
-        case CONSTANT_POOL_COUNT: {
-            printf(TOKEN_FMT_U16 "(u16 ConstantPoolCount)\n\n", token.u16);
+        case CONSTANT_TAG_INTERFACE_METHOD_REF: {
+            print_field_triple(buffer,
+                               (u8)constant.tag,
+                               constant.ref.class_index,
+                               constant.ref.name_and_type_index,
+                               "#");
+            put_u32_pad(buffer, constant.index, 3);
+            put_str(buffer,
+                    " (u8 Constant.InterfaceMethodRef, u16 ClassIndex,\n"
+                    CONSTANT_TAG_PAD "u16 NameAndTypeIndex)\n");
             break;
         }
-        case CONSTANT: {
-            switch (token.constant.tag) {
-            case CONSTANT_TAG_UTF8: {
-                printf(CONSTANT_FMT_U8_U16_STRING CONSTANT_FMT_INDEX
-                       "(u8 Constant.Utf8, u16 Length, u8*%hu String)\n",
-                       (u8)token.constant.tag,
-                       token.constant.utf8.size,
-                       token.constant.utf8.string,
-                       token.constant.index,
-                       token.constant.utf8.size);
+        case CONSTANT_TAG_METHOD_HANDLE: {
+            print_field_triple(buffer,
+                               (u8)constant.tag,
+                               constant.method_handle.reference_kind,
+                               constant.method_handle.reference_index,
+                               "#");
+            put_u32_pad(buffer, constant.index, 3);
+            put_str(buffer,
+                    " (u8 Constant.MethodHandle, u8 ReferenceKind,\n"
+                    CONSTANT_TAG_PAD "u16 ReferenceIndex)\n");
+            break;
+        }
+        case CONSTANT_TAG_METHOD_TYPE: {
+            print_field_pair(buffer,
+                             (u8)constant.tag,
+                             constant.u16,
+                             "#");
+            put_u32_pad(buffer, constant.index, 3);
+            put_str(buffer,
+                    " (u8 Constant.MethodType, u16 DescriptorIndex)\n");
+            break;
+        }
+        case CONSTANT_TAG_DYNAMIC:
+        case CONSTANT_TAG_INVOKE_DYNAMIC: {
+            print_field_triple(
+                buffer,
+                (u8)constant.tag,
+                constant.dynamic.bootstrap_method_attr_index,
+                constant.dynamic.name_and_type_index,
+                "#");
+            put_u32_pad(buffer, constant.index, 3);
+            put_str(buffer,
+                    constant.tag == CONSTANT_TAG_DYNAMIC
+                        ? " (u8 Constant.Dynamic, "
+                        : " (u8 Constant.InvokeDynamic, ");
+            put_str(buffer,
+                    "u16 BootstrapMethodAttrIndex,\n" CONSTANT_TAG_PAD
+                    "u16 NameAndTypeIndex)\n");
+            break;
+        }
+        case CONSTANT_TAG_MODULE:
+        case CONSTANT_TAG_PACKAGE: {
+            print_field_pair(buffer,
+                             (u8)constant.tag,
+                             constant.u16,
+                             "#");
+            put_u32_pad(buffer, constant.index, 3);
+            put_str(buffer,
+                    constant.tag == CONSTANT_TAG_MODULE
+                        ? " (u8 Constant.Module, u16 NameIndex)\n"
+                        : " (u8 Constant.Package, u16 NameIndex)\n");
+            break;
+        }
+        }
+        break;
+    }
+    case ACCESS_FLAGS: {
+        put_str(buffer, "  0x");
+        put_hex_pad(buffer, token.u16, 16);
+        put_str(buffer, "(u16 AccessFlags) [");
+        for (u16 j = 0; j < 16; ++j) {
+            switch ((AccessFlag)((1 << j) & token.u16)) {
+            case ACC_PUBLIC: {
+                put_str(buffer, " ACC_PUBLIC");
                 break;
             }
-            case CONSTANT_TAG_CLASS: {
-                printf(CONSTANT_FMT_U8_U16 CONSTANT_FMT_INDEX
-                       "(u8 Constant.Class, "
-                       "u16 NameIndex)\n",
-                       (u8)token.constant.tag,
-                       token.constant.class_.name_index,
-                       token.constant.index);
+            case ACC_FINAL: {
+                put_str(buffer, " ACC_FINAL");
                 break;
             }
-            case CONSTANT_TAG_STRING: {
-                printf(CONSTANT_FMT_U8_U16 CONSTANT_FMT_INDEX
-                       "(u8 Constant.String, "
-                       "u16 StringIndex)\n",
-                       (u8)token.constant.tag,
-                       token.constant.string.string_index,
-                       token.constant.index);
+            case ACC_SUPER: {
+                put_str(buffer, " ACC_SUPER");
                 break;
             }
-            case CONSTANT_TAG_FIELD_REF: {
-                printf(CONSTANT_FMT_U8_U16_U16 CONSTANT_FMT_INDEX
-                       "(u8 Constant.FieldRef, u16 ClassIndex, "
-                       "u16 NameAndTypeIndex)\n",
-                       (u8)token.constant.tag,
-                       token.constant.ref.class_index,
-                       token.constant.ref.name_and_type_index,
-                       token.constant.index);
+            case ACC_INTERFACE: {
+                put_str(buffer, " ACC_INTERFACE");
                 break;
             }
-            case CONSTANT_TAG_METHOD_REF: {
-                printf(CONSTANT_FMT_U8_U16_U16 CONSTANT_FMT_INDEX
-                       "(u8 Constant.MethodRef, u16 "
-                       "ClassIndex,\n" CONSTANT_TAG_PAD
-                       "u16 NameAndTypeIndex)\n",
-                       (u8)token.constant.tag,
-                       token.constant.ref.class_index,
-                       token.constant.ref.name_and_type_index,
-                       token.constant.index);
+            case ACC_ABSTRACT: {
+                put_str(buffer, " ACC_ABSTRACT");
                 break;
             }
-            case CONSTANT_TAG_NAME_AND_TYPE: {
-                printf(CONSTANT_FMT_U8_U16_U16 CONSTANT_FMT_INDEX
-                       "(u8 Constant.NameAndType, u16 "
-                       "NameIndex,\n" CONSTANT_TAG_PAD
-                       "u16 DescriptorIndex)\n",
-                       (u8)token.constant.tag,
-                       token.constant.name_and_type.name_index,
-                       token.constant.name_and_type.descriptor_index,
-                       token.constant.index);
+            case ACC_SYNTHETIC: {
+                put_str(buffer, " ACC_SYNTHETIC");
                 break;
             }
+            case ACC_ANNOTATION: {
+                put_str(buffer, " ACC_ANNOTATION");
+                break;
+            }
+            case ACC_ENUM: {
+                put_str(buffer, " ACC_ENUM");
+                break;
             }
+            case ACC_MODULE: {
+                put_str(buffer, " ACC_MODULE");
+                break;
+            }
+            }
+        }
+        put_str(buffer, " ]\n\n");
+        break;
+    }
+    case THIS_CLASS: {
+        print_field(buffer, token.u16, "(u16 ThisClass)\n");
+        break;
+    }
+    case SUPER_CLASS: {
+        print_field(buffer, token.u16, "(u16 SuperClass)\n");
+        break;
+    }
+    case INTERFACE_COUNT: {
+        put_char(buffer, '\n');
+        print_field(buffer, token.u16, "(u16 InterfaceCount)\n");
+        break;
+    }
+    case FIELD_COUNT: {
+        put_char(buffer, '\n');
+        print_field(buffer, token.u16, "(u16 FieldCount)\n");
+        break;
+    }
+    case METHOD_COUNT: {
+        put_char(buffer, '\n');
+        print_field(buffer, token.u16, "(u16 MethodCount)\n");
+        break;
+    }
+    case METHOD: {
+        Method* method = &memory->methods[token.u16];
+        put_char(buffer, '\n');
+        print_field(buffer,
+                    method->access_flags,
+                    "(u16 MethodAccessFlags) [");
+        for (u16 j = 0; j < 16; ++j) {
+            MethodAccessFlag method_access_flag =
+                (MethodAccessFlag)((1 << j) & method->access_flags);
+            switch (method_access_flag) {
+            case METHOD_ACC_PUBLIC: {
+                put_str(buffer, " ACC_PUBLIC");
+                break;
+            }
+            case METHOD_ACC_PRIVATE: {
+                put_str(buffer, " ACC_PRIVATE");
+                break;
+            }
+            case METHOD_ACC_PROTECTED: {
+                put_str(buffer, " ACC_PROTECTED");
+                break;
+            }
+            case METHOD_ACC_STATIC: {
+                put_str(buffer, " ACC_STATIC");
+                break;
+            }
+            case METHOD_ACC_FINAL: {
+                put_str(buffer, " ACC_FINAL");
+                break;
+            }
+            case METHOD_ACC_SYNCHRONIZED: {
+                put_str(buffer, " ACC_SYNCHRONIZED");
+                break;
+            }
+            case METHOD_ACC_BRIDGE: {
+                put_str(buffer, " ACC_BRIDGE");
+                break;
+            }
+            case METHOD_ACC_VARARGS: {
+                put_str(buffer, " ACC_VARARGS");
+                break;
+            }
+            case METHOD_ACC_NATIVE: {
+                put_str(buffer, " ACC_NATIVE");
+                break;
+            }
+            case METHOD_ACC_ABSTRACT: {
+                put_str(buffer, " ACC_ABSTRACT");
+                break;
+            }
+            case METHOD_ACC_STRICT: {
+                put_str(buffer, " ACC_STRICT");
+                break;
+            }
+            case METHOD_ACC_SYNTHETIC: {
+                put_str(buffer, " ACC_SYNTHETIC");
+                break;
+            }
+            }
+        }
+        put_str(buffer, " ]\n\n");
+        print_field_triple(buffer,
+                           method->name_index,
+                           method->descriptor_index,
+                           method->attribute_count,
+                           "(u16 MethodNameIndex, u16 MethodDescriptorIndex,\n"
+                           "                     "
+                           "u16 MethodAttributeCount)\n");
+        for (u32 j = method->attributes; j != 0;
+             j = get_attribute_at(memory, j)->next_attribute)
+        {
+            print_attribute(buffer,
+                            memory,
+                            resolver,
+                            get_attribute_at(memory, j));
+        }
+        break;
+    }
+    case ATTRIBUTE_COUNT: {
+        put_char(buffer, '\n');
+        print_field(buffer, token.u16, "(u16 AttributeCount)\n");
+        break;
+    }
+    case ATTRIBUTE: {
+        print_attribute(buffer,
+                        memory,
+                        resolver,
+                        get_attribute_at(memory, token.u32));
+        break;
+    }
+    }
+}
+
+void print_tokens(Buffer* buffer, Memory* memory, Resolver* resolver) {
+    for (const TokenBlock* block = memory->first_token_block; block != NULL;
+         block = block->next_block)
+    {
+        for (u32 i = 0; i < block->count; ++i) {
+            print_token(buffer, memory, resolver, block->tokens[i]);
+        }
+    }
+}
+
+void print_summary(Buffer* buffer, Memory* memory) {
+    for (const TokenBlock* block = memory->first_token_block; block != NULL;
+         block = block->next_block)
+    {
+        for (u32 i = 0; i < block->count; ++i) {
+            const Token* token = &block->tokens[i];
+            switch (token->tag) {
+            case THIS_CLASS: {
+                put_str(buffer, "  ");
+                put_utf8(buffer, get_class_name(memory, token->u16));
+                put_char(buffer, '\n');
+                break;
+            }
+            case METHOD: {
+                put_str(buffer, "    ");
+                const Method* method = &memory->methods[token->u16];
+                put_utf8(buffer, get_utf8(memory, method->name_index));
+                put_utf8(buffer, get_utf8(memory, method->descriptor_index));
+                put_char(buffer, '\n');
+                break;
+            }
+            case MAGIC:
+            case MINOR_VERSION:
+            case MAJOR_VERSION:
+            case CONSTANT_POOL_COUNT:
+            case CONSTANT:
+            case ACCESS_FLAGS:
+            case SUPER_CLASS:
+            case INTERFACE_COUNT:
+            case FIELD_COUNT:
+            case METHOD_COUNT:
+            case ATTRIBUTE_COUNT:
+            case ATTRIBUTE: {
+                break;
+            }
+            }
+        }
+    }
+}
+
+void print_methods(Buffer*     buffer,
+                   Memory*     memory,
+                   Resolver*   resolver,
+                   const char* name) {
+    for (u16 i = 0; i < memory->method_count; ++i) {
+        Method* method = &memory->methods[i];
+        if (!get_utf8_eq(get_utf8(memory, method->name_index), name)) {
+            continue;
+        }
+        set_method_attributes(memory, method);
+        print_token(buffer,
+                    memory,
+                    resolver,
+                    (Token){.u16 = i, .tag = METHOD});
+    }
+}
+
+/* NOTE: The resolver lives in the class's arena, so its cache is dropped
+ * with everything else when the next class is parsed. Printing can still
+ * fail, on a method decoded only now or on bad code, and unwinds here the
+ * way `parse_method` does. */
+ParseError print_view(Buffer* buffer, Memory* memory, View view) {
+    jmp_buf on_error;
+    memory->error.code = PARSE_OK;
+    memory->error.offset = 0;
+    memory->on_error = &on_error;
+#ifdef STATS
+    u32 stats_depth = memory->stats.depth;
+#endif
+    if (setjmp(on_error) == 0) {
+        Resolver  resolver;
+        Resolver* resolver_ref = NULL;
+        if (view.resolve) {
+            set_resolver(memory, &resolver);
+            resolver_ref = &resolver;
+        }
+        switch (view.tag) {
+        case VIEW_TOKENS: {
+            print_tokens(buffer, memory, resolver_ref);
+            break;
+        }
+        case VIEW_SUMMARY: {
+            print_summary(buffer, memory);
             break;
         }
-        case ACCESS_FLAGS: {
-            printf("  0x%-16X(u16 AccessFlags) [", token.u16);
-            for (u16 j = 0; j < 16; ++j) {
-                switch ((AccessFlag)((1 << j) & token.u16)) {
-                case ACC_PUBLIC: {
-                    printf(" ACC_PUBLIC");
-                    break;
-                }
-                case ACC_FINAL: {
-                    printf(" ACC_FINAL");
-                    break;
-                }
-                case ACC_SUPER: {
-                    printf(" ACC_SUPER");
-                    break;
-                }
-                case ACC_INTERFACE: {
-                    printf(" ACC_INTERFACE");
-                    break;
-                }
-                case ACC_ABSTRACT: {
-                    printf(" ACC_ABSTRACT");
-                    break;
-                }
-                case ACC_SYNTHETIC: {
-                    printf(" ACC_SYNTHETIC");
-                    break;
-                }
-                case ACC_ANNOTATION: {
-                    printf(" ACC_ANNOTATION");
-                    break;
-                }
-                case ACC_ENUM: {
-                    printf(" ACC_ENUM");
-                    break;
-                }
-                case ACC_MODULE: {
-                    printf(" ACC_MODULE");
-                    break;
-                }
-                }
-            }
-            printf(" ]\n\n");
-            break;
-        }
-        case THIS_CLASS: {
-            printf(TOKEN_FMT_U16 "(u16 ThisClass)\n", token.u16);
-            break;
-        }
-        case SUPER_CLASS: {
-            printf(TOKEN_FMT_U16 "(u16 SuperClass)\n", token.u16);
-            break;
-        }
-        case INTERFACE_COUNT: {
-            printf("\n" TOKEN_FMT_U16 "(u16 InterfaceCount)\n", token.u16);
-            break;
-        }
-        case FIELD_COUNT: {
-            printf("\n" TOKEN_FMT_U16 "(u16 FieldCount)\n", token.u16);
-            break;
-        }
-        case METHOD_COUNT: {
-            printf("\n" TOKEN_FMT_U16 "(u16 MethodCount)\n", token.u16);
-            break;
-        }
-        case METHOD: {
-            printf("\n  %-18hu(u16 MethodAccessFlags) [",
-                   token.method.access_flags);
-            for (u16 j = 0; j < 16; ++j) {
-                MethodAccessFlag method_access_flag =
-                    (MethodAccessFlag)((1 << j) & token.method.access_flags);
-                switch (method_access_flag) {
-                case METHOD_ACC_PUBLIC: {
-                    printf(" ACC_PUBLIC");
-                    break;
-                }
-                case METHOD_ACC_PRIVATE: {
-                    printf(" ACC_PRIVATE");
-                    break;
-                }
-                case METHOD_ACC_PROTECTED: {
-                    printf(" ACC_PROTECTED");
-                    break;
-                }
-                case METHOD_ACC_STATIC: {
-                    printf(" ACC_STATIC");
-                    break;
-                }
-                case METHOD_ACC_FINAL: {
-                    printf(" ACC_FINAL");
-                    break;
-                }
-                case METHOD_ACC_SYNCHRONIZED: {
-                    printf(" ACC_SYNCHRONIZED");
-                    break;
-                }
-                case METHOD_ACC_BRIDGE: {
-                    printf(" ACC_BRIDGE");
-                    break;
-                }
-                case METHOD_ACC_VARARGS: {
-                    printf(" ACC_VARARGS");
-                    break;
-                }
-                case METHOD_ACC_NATIVE: {
-                    printf(" ACC_NATIVE");
-                    break;
-                }
-                case METHOD_ACC_ABSTRACT: {
-                    printf(" ACC_ABSTRACT");
-                    break;
-                }
-                case METHOD_ACC_STRICT: {
-                    printf(" ACC_STRICT");
-                    break;
-                }
-                case METHOD_ACC_SYNTHETIC: {
-                    printf(" ACC_SYNTHETIC");
-                    break;
-                }
-                }
-            }
-            printf(" ]\n\n");
-            printf("  %-4hu%-4hu%-10hu"
-                   "(u16 MethodNameIndex, u16 MethodDescriptorIndex,\n"
-                   "                     "
-                   "u16 MethodAttributeCount)"
-                   "\n",
-                   token.method.name_index,
-                   token.method.descriptor_index,
-                   token.method.attribute_count);
-            Attribute* attribute = token.method.attributes;
-            for (u16 j = 0; j < token.method.attribute_count; ++j) {
-                if (attribute != NULL) {
-                    print_attribute(attribute);
-                    attribute = attribute->next_attribute;
-                }
-            }
-            break;
-        }
-        case ATTRIBUTE_COUNT: {
-            printf("\n" TOKEN_FMT_U16 "(u16 AttributeCount)\n", token.u16);
-            break;
-        }
-        case ATTRIBUTE: {
-            print_attribute(token.attribute);
+        case VIEW_METHOD: {
+            print_methods(buffer, memory, resolver_ref, view.method_name);
             break;
         }
+        case VIEW_OP_COUNTS:
+        case VIEW_CLASS_REFS:
+        case VIEW_CFG:
+        case VIEW_VERIFY:
+        case VIEW_JSON: {
+            break;
         }
+        }
+    }
+#ifdef STATS
+    unwind_stats(&memory->stats, stats_depth);
+#endif
+    memory->on_error = NULL;
+    return memory->error;
+}
+
+void print_cfg_edge(Buffer*     buffer,
+                    Memory*     memory,
+                    const Code* code,
+                    const Edge* edge) {
+    switch (edge->tag) {
+    case EDGE_FALL_THROUGH: {
+        put_str(buffer, " fall #");
+        put_u32(buffer, edge->block_index);
+        break;
+    }
+    case EDGE_BRANCH: {
+        put_str(buffer, " branch #");
+        put_u32(buffer, edge->block_index);
+        break;
+    }
+    case EDGE_HANDLER: {
+        put_str(buffer, " catch #");
+        put_u32(buffer, edge->block_index);
+        u16 catch_type =
+            code->exception_table[edge->exception_index].catch_type;
+        put_str(buffer, " (");
+        if (catch_type == 0) {
+            put_str(buffer, "any");
+        } else {
+            put_utf8(buffer, get_class_name(memory, catch_type));
+        }
+        put_char(buffer, ')');
+        break;
+    }
+    }
+}
+
+void print_cfg(Buffer*     buffer,
+               Memory*     memory,
+               const Cfg*  cfg,
+               const Code* code) {
+    for (u32 i = 0; i < cfg->block_count; ++i) {
+        const Block* block = &cfg->blocks[i];
+        put_str(buffer, "      #");
+        put_u32_pad(buffer, i, 6);
+        put_u32(buffer, block->pc_start);
+        put_str(buffer, "..");
+        put_u32(buffer, block->pc_end);
+        for (u32 j = 0; j < block->edge_count; ++j) {
+            print_cfg_edge(buffer,
+                           memory,
+                           code,
+                           &cfg->edges[block->edge_index + j]);
+        }
+        for (u32 j = block->handler; j != 0;
+             j = cfg->handlers[j - 1].next_handler)
+        {
+            print_cfg_edge(buffer, memory, code, &cfg->handlers[j - 1].edge);
+        }
+        put_char(buffer, '\n');
+    }
+}
+
+/* NOTE: Method bodies are decoded one at a time and the first malformed
+ * one stops the view, the same as a parse error would. */
+ParseError print_cfgs(Buffer* buffer, Memory* memory) {
+    put_str(buffer, "  ");
+    put_utf8(buffer, get_class_name(memory, memory->this_class));
+    put_char(buffer, '\n');
+    for (u16 i = 0; i < memory->method_count; ++i) {
+        Method*    method = &memory->methods[i];
+        ParseError error = parse_method(memory, method);
+        if (error.code != PARSE_OK) {
+            return error;
+        }
+        put_str(buffer, "    ");
+        put_utf8(buffer, get_utf8(memory, method->name_index));
+        put_utf8(buffer, get_utf8(memory, method->descriptor_index));
+        put_char(buffer, '\n');
+        const Code* code = get_method_code(memory, method);
+        if (code == NULL) {
+            continue;
+        }
+        Cfg cfg;
+        error = parse_cfg(memory, &cfg, code);
+        if (error.code != PARSE_OK) {
+            return error;
+        }
+        print_cfg(buffer, memory, &cfg, code);
+    }
+    return memory->error;
+}
+
+/* NOTE: Every method is checked even after one fails, so a single run
+ * lists them all; the first failure is what the class reports. */
+ParseError print_verify(Buffer* buffer, Memory* memory) {
+    ParseError first_error = memory->error;
+    put_str(buffer, "  ");
+    put_utf8(buffer, get_class_name(memory, memory->this_class));
+    put_char(buffer, '\n');
+    for (u16 i = 0; i < memory->method_count; ++i) {
+        Method*    method = &memory->methods[i];
+        Verifier   verifier;
+        ParseError error = parse_verify(memory, &verifier, method);
+        put_str(buffer, "    ");
+        put_utf8(buffer, get_utf8(memory, method->name_index));
+        put_utf8(buffer, get_utf8(memory, method->descriptor_index));
+        if (error.code == PARSE_OK) {
+            put_str(buffer,
+                    verifier.code == NULL     ? " (no code)\n"
+                    : is_type_checked(memory) ? " ok\n"
+                                              : " not verifiable by type "
+                                                "checking\n");
+            continue;
+        }
+        if (first_error.code == PARSE_OK) {
+            first_error = error;
+        }
+        u32 code_offset = verifier.code == NULL
+                              ? 0
+                              : (u32)(verifier.code->bytes - memory->bytes);
+        if ((verifier.code != NULL) && (code_offset <= error.offset) &&
+            (error.offset <= (code_offset + verifier.code->byte_count)))
+        {
+            put_str(buffer, " pc ");
+            put_u32(buffer, error.offset - code_offset);
+        } else {
+            put_str(buffer, " byte ");
+            put_u32(buffer, error.offset);
+        }
+        put_str(buffer, ": ");
+        put_str(buffer, get_parse_error_name(error.code));
+        put_char(buffer, '\n');
+    }
+    return first_error;
+}
+
+void push_op_count(void* context, const Instruction* instruction) {
+    PrintVisit* visit = context;
+    ++visit->op_counts[instruction->op_code];
+}
+
+void print_class_refs(void* context, const ClassHeader* header) {
+    PrintVisit* visit = context;
+    Memory*     memory = visit->memory;
+    for (u16 i = 1; i < memory->constant_count; ++i) {
+        if ((i == header->this_class) ||
+            (get_constant_tag(memory, i) != CONSTANT_TAG_CLASS))
+        {
+            continue;
+        }
+        put_spaces(visit->buffer, 2);
+        put_utf8(visit->buffer, get_class_name(memory, i));
+        put_char(visit->buffer, '\n');
+    }
+}
+
+void print_op_counts(Buffer* buffer, const u64* op_counts) {
+    for (u32 i = 0; i < COUNT_OP_CODES; ++i) {
+        if (op_counts[i] == 0) {
+            continue;
+        }
+        put_spaces(buffer, 2);
+        print_op_mnemonic(buffer, OP_CODES[i].mnemonic);
+        put_u32(buffer, (u32)op_counts[i]);
+        put_char(buffer, '\n');
+    }
+}
+
+/* NOTE: The op count and class reference views stream through
+ * `visit_class` and never build tokens; the rest parse first, then
+ * print. */
+ParseError print_class(Buffer* buffer, Memory* memory, View view) {
+    switch (view.tag) {
+    case VIEW_TOKENS:
+    case VIEW_SUMMARY:
+    case VIEW_METHOD: {
+        ParseError error =
+            parse_class(memory, memory->bytes, memory->file_size);
+        if (error.code != PARSE_OK) {
+            return error;
+        }
+        STATS_PUSH(memory, STATS_PRINT);
+        error = print_view(buffer, memory, view);
+        STATS_POP(memory, STATS_PRINT);
+        return error;
+    }
+    case VIEW_CFG: {
+        ParseError error =
+            parse_class(memory, memory->bytes, memory->file_size);
+        if (error.code != PARSE_OK) {
+            return error;
+        }
+        STATS_PUSH(memory, STATS_PRINT);
+        error = print_cfgs(buffer, memory);
+        STATS_POP(memory, STATS_PRINT);
+        return error;
+    }
+    case VIEW_VERIFY: {
+        ParseError error =
+            parse_class(memory, memory->bytes, memory->file_size);
+        if (error.code != PARSE_OK) {
+            return error;
+        }
+        STATS_PUSH(memory, STATS_PRINT);
+        error = print_verify(buffer, memory);
+        STATS_POP(memory, STATS_PRINT);
+        return error;
+    }
+    case VIEW_JSON: {
+        ParseError error =
+            parse_class(memory, memory->bytes, memory->file_size);
+        if (error.code != PARSE_OK) {
+            return error;
+        }
+        STATS_PUSH(memory, STATS_PRINT);
+        error = print_json_class(buffer, memory);
+        STATS_POP(memory, STATS_PRINT);
+        return error;
+    }
+    case VIEW_OP_COUNTS: {
+        PrintVisit visit = {.buffer = buffer, .memory = memory};
+        Visitor    visitor = {
+               .context = &visit,
+               .on_instruction = push_op_count,
+        };
+        ParseError error = visit_class(memory,
+                                       memory->bytes,
+                                       memory->file_size,
+                                       &visitor);
+        if (error.code == PARSE_OK) {
+            STATS_PUSH(memory, STATS_PRINT);
+            print_op_counts(buffer, visit.op_counts);
+            STATS_POP(memory, STATS_PRINT);
+        }
+        return error;
+    }
+    case VIEW_CLASS_REFS: {
+        PrintVisit visit = {.buffer = buffer, .memory = memory};
+        Visitor    visitor = {
+               .context = &visit,
+               .on_class = print_class_refs,
+        };
+        return visit_class(memory,
+                           memory->bytes,
+                           memory->file_size,
+                           &visitor);
+    }
     }
+    return memory->error;
 }
 
 #endif
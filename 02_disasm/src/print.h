@@ -1,29 +1,76 @@
 #ifndef __PRINT_H__
 #define __PRINT_H__
 
-#include "memory.c"
-
-#define TOKEN_FMT_U8     "  %-18hhu"
-#define TOKEN_FMT_U16    "  %-18hu"
-#define TOKEN_FMT_U8_U16 "  %-4hhu%-14hu"
-
-#define OP_OFFSET    "%-14s"
-#define OP_FMT_U8    OP_OFFSET "%hhu\n"
-#define OP_FMT_U16   OP_OFFSET "%hu\n"
-#define OP_FMT_I16   OP_OFFSET "%hd\n"
-#define OP_FMT_U8_I8 OP_OFFSET "%-6hhu%hhd\n"
-
-#define CONSTANT_TAG_PAD        "                          "
-#define CONSTANT_FMT_U8         "  %-4hhu"
-#define CONSTANT_FMT_U8_U16     CONSTANT_FMT_U8 "%-14hu"
-#define CONSTANT_FMT_U8_U16_U16 CONSTANT_FMT_U8 "%-4hu%-10hu"
-#define CONSTANT_FMT_U8_U16_STRING \
-    CONSTANT_FMT_U8 "%-4hu\"%s\"\n                    "
-#define CONSTANT_FMT_INDEX "#%-3hu "
-
-void print_op_codes(const u8*, u32);
-void print_verification_table(const VerificationType*, u16);
-void print_attribute(Attribute*);
-void print_tokens(Memory*);
+#include "buffer.c"
+#include "json.c"
+#include "resolve.c"
+#include "verify.c"
+#include "visitor.c"
+
+#define WIDTH_OP_MNEMONIC 13
+#define WIDTH_OP_OPERAND  6
+#define WIDTH_WIDE        9
+#define WIDTH_SWITCH_PAD  26
+
+/* NOTE: Part of every batch cache key. Bump whenever any view prints
+ * something different for the same class, so entries written by an older
+ * build are never served. */
+#define OUTPUT_VERSION 3
+
+#define CONSTANT_TAG_PAD "                          "
+#define TOKEN_PAD        "                    "
+
+typedef enum {
+    VIEW_TOKENS = 0,
+    VIEW_SUMMARY,
+    VIEW_METHOD,
+    VIEW_OP_COUNTS,
+    VIEW_CLASS_REFS,
+    VIEW_CFG,
+    VIEW_VERIFY,
+    VIEW_JSON,
+} ViewTag;
+
+typedef struct {
+    const char* method_name;
+    u32         attribute_skip_mask;
+    ViewTag     tag;
+    Bool        resolve;
+} View;
+
+void print_field(Buffer*, u32, const char*);
+void print_field_pair(Buffer*, u32, u32, const char*);
+void print_field_triple(Buffer*, u32, u32, u32, const char*);
+void print_field_quad(Buffer*, u32, u32, u32, u32, const char*);
+void put_utf8(Buffer*, ConstantUtf8);
+void print_op_mnemonic(Buffer*, const char*);
+void print_switch(Buffer*, Memory*, const u8*, u32*, u32, u32, OpCode);
+_Noreturn void set_op_code_error(Memory*, const u8*, u32);
+void print_wide(Buffer*, Memory*, const u8*, u32*, u32);
+void print_resolved(Buffer*, Resolver*, u16);
+void print_op_codes(Buffer*, Memory*, Resolver*, const u8*, u32);
+void print_verification_table(Buffer*, const VerificationType*, u16);
+void print_attribute(Buffer*, Memory*, Resolver*, const Attribute*);
+void print_token(Buffer*, Memory*, Resolver*, Token);
+void print_tokens(Buffer*, Memory*, Resolver*);
+void print_summary(Buffer*, Memory*);
+void print_methods(Buffer*, Memory*, Resolver*, const char*);
+ParseError print_view(Buffer*, Memory*, View);
+
+void       print_cfg_edge(Buffer*, Memory*, const Code*, const Edge*);
+void       print_cfg(Buffer*, Memory*, const Cfg*, const Code*);
+ParseError print_cfgs(Buffer*, Memory*);
+ParseError print_verify(Buffer*, Memory*);
+
+typedef struct {
+    Buffer* buffer;
+    Memory* memory;
+    u64     op_counts[COUNT_OP_CODES];
+} PrintVisit;
+
+void       push_op_count(void*, const Instruction*);
+void       print_class_refs(void*, const ClassHeader*);
+void       print_op_counts(Buffer*, const u64*);
+ParseError print_class(Buffer*, Memory*, View);
 
 #endif
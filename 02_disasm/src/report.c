@@ -0,0 +1,299 @@
+#ifndef __REPORT_C__
+#define __REPORT_C__
+
+#include "report.h"
+
+const char* get_stats_phase_name(StatsPhase phase) {
+    switch (phase) {
+    case STATS_LOAD: {
+        return "load";
+    }
+    case STATS_CONSTANT_POOL: {
+        return "constant pool";
+    }
+    case STATS_METHODS: {
+        return "methods";
+    }
+    case STATS_ATTRIBUTES: {
+        return "attributes";
+    }
+    case STATS_PRINT: {
+        return "print";
+    }
+    case COUNT_STATS_PHASES: {
+        break;
+    }
+    }
+    return NULL;
+}
+
+const char* get_stats_op_code_name(OpCode op_code) {
+    const char* mnemonic = OP_CODES[op_code].mnemonic;
+    return mnemonic == NULL ? "?" : mnemonic;
+}
+
+/* NOTE: Measured over the whole run rather than trusted from `/proc`, so it
+ * holds with or without a time stamp counter. */
+double get_stats_cycles_per_us(const StatsReport* report) {
+    StatsClock end = get_stats_clock();
+    u64        nanoseconds = end.nanoseconds - report->start.nanoseconds;
+    if (nanoseconds == 0) {
+        return 1;
+    }
+    return ((double)(end.cycles - report->start.cycles) * (double)1000) /
+           (double)nanoseconds;
+}
+
+void set_stats_report(StatsReport* report) {
+    if (!report->text && (report->trace_path == NULL)) {
+        return;
+    }
+#ifndef STATS
+    fprintf(stderr, "[ERROR] Built without `-DSTATS`\n");
+    exit(EXIT_FAILURE);
+#endif
+    report->start = get_stats_clock();
+}
+
+#ifdef STATS
+
+/* NOTE: Runs after a class is printed, outside every phase, so walking the
+ * bytecode again for op code counts does not show up in the timings. Only
+ * methods something already parsed are counted; the visitor views count
+ * as they go instead. */
+void push_stats_class(Memory* memory, const Buffer* buffer) {
+    Stats* stats = &memory->stats;
+    for (u16 i = 0; i < memory->method_count; ++i) {
+        const Code* code = get_method_code(memory, &memory->methods[i]);
+        if (code == NULL) {
+            continue;
+        }
+        for (u32 pc = 0; pc < code->byte_count;) {
+            u32 size = get_op_code_size(code->bytes, pc, code->byte_count);
+            if (size == 0) {
+                break;
+            }
+            ++stats->op_code_counts[code->bytes[pc]];
+            pc += size;
+        }
+    }
+    if (stats->token_high_water < memory->token_count) {
+        stats->token_high_water = memory->token_count;
+    }
+    if (stats->attribute_high_water < memory->attribute_count) {
+        stats->attribute_high_water = memory->attribute_count;
+    }
+    if (stats->output_high_water < buffer->capacity) {
+        stats->output_high_water = buffer->capacity;
+    }
+}
+
+void merge_stats(StatsReport* report, Memory* memory, u32 thread) {
+    Stats* into = &report->stats;
+    Stats* from = &memory->stats;
+    for (u32 i = 0; i < COUNT_STATS_PHASES; ++i) {
+        into->phase_cycles[i] += from->phase_cycles[i];
+        into->phase_counts[i] += from->phase_counts[i];
+    }
+    for (u32 i = 0; i < COUNT_STATS_CONSTANT_TAGS; ++i) {
+        into->constant_tag_counts[i] += from->constant_tag_counts[i];
+    }
+    for (u32 i = 0; i < COUNT_STATS_ATTRIBUTE_TAGS; ++i) {
+        into->attribute_tag_counts[i] += from->attribute_tag_counts[i];
+    }
+    for (u32 i = 0; i < COUNT_STATS_OP_CODES; ++i) {
+        into->op_code_counts[i] += from->op_code_counts[i];
+    }
+    /* NOTE: Peaks are per worker; each has its own `Memory`. */
+    if (into->arena_high_water < memory->arena.high_water) {
+        into->arena_high_water = memory->arena.high_water;
+    }
+    into->arena_reserved += memory->arena.reserved;
+    if (into->token_high_water < from->token_high_water) {
+        into->token_high_water = from->token_high_water;
+    }
+    if (into->attribute_high_water < from->attribute_high_water) {
+        into->attribute_high_water = from->attribute_high_water;
+    }
+    if (into->output_high_water < from->output_high_water) {
+        into->output_high_water = from->output_high_water;
+    }
+    for (u32 i = 0; i < from->event_count; ++i) {
+        StatsEvent event = from->events[i];
+        event.thread = thread;
+        push_stats_event(into, event);
+    }
+    free_stats(from);
+    if (report->thread_count <= thread) {
+        report->thread_count = thread + 1;
+    }
+}
+
+#endif
+
+void print_stats(File* file, const StatsReport* report) {
+    const Stats* stats = &report->stats;
+    double       cycles_per_us = get_stats_cycles_per_us(report);
+    u64          total = 0;
+    for (u32 i = 0; i < COUNT_STATS_PHASES; ++i) {
+        total += stats->phase_cycles[i];
+    }
+    fprintf(file,
+            "[STATS] %u threads, %.0f cycles/us\n"
+            "  %-18s %10s %14s %10s %6s\n",
+            report->thread_count,
+            cycles_per_us,
+            "Phase",
+            "Count",
+            "Cycles",
+            "ms",
+            "Share");
+    for (u32 i = 0; i < COUNT_STATS_PHASES; ++i) {
+        fprintf(file,
+                "  %-18s %10lu %14lu %10.3f %5.1f%%\n",
+                get_stats_phase_name((StatsPhase)i),
+                stats->phase_counts[i],
+                stats->phase_cycles[i],
+                (double)stats->phase_cycles[i] /
+                    (cycles_per_us * (double)1000),
+                total == 0 ? (double)0
+                           : ((double)stats->phase_cycles[i] * (double)100) /
+                                 (double)total);
+    }
+    fprintf(file, "[STATS] Constant tags\n");
+    for (u32 i = 0; i < COUNT_STATS_CONSTANT_TAGS; ++i) {
+        if (stats->constant_tag_counts[i] != 0) {
+            fprintf(file,
+                    "  %-18s %10lu\n",
+                    get_json_constant_tag_name((ConstantTag)i),
+                    stats->constant_tag_counts[i]);
+        }
+    }
+    fprintf(file, "[STATS] Attribute tags\n");
+    for (u32 i = 0; i < COUNT_STATS_ATTRIBUTE_TAGS; ++i) {
+        if (stats->attribute_tag_counts[i] != 0) {
+            fprintf(file,
+                    "  %-18s %10lu\n",
+                    get_json_attribute_name((AttributeTag)i),
+                    stats->attribute_tag_counts[i]);
+        }
+    }
+    fprintf(file, "[STATS] Op codes\n");
+    for (u32 i = 0; i < COUNT_STATS_OP_CODES; ++i) {
+        if (stats->op_code_counts[i] != 0) {
+            fprintf(file,
+                    "  %-18s %10lu\n",
+                    get_stats_op_code_name((OpCode)i),
+                    stats->op_code_counts[i]);
+        }
+    }
+    fprintf(file,
+            "[STATS] Pools\n"
+            "  %-18s %10lu bytes peak, %lu bytes reserved\n"
+            "  %-18s %10lu peak\n"
+            "  %-18s %10lu peak\n"
+            "  %-18s %10lu bytes peak\n",
+            "arena",
+            stats->arena_high_water,
+            stats->arena_reserved,
+            "tokens",
+            stats->token_high_water,
+            "attributes",
+            stats->attribute_high_water,
+            "output",
+            stats->output_high_water);
+}
+
+/* NOTE: Chrome's trace event format (`chrome://tracing`, Perfetto): one
+ * complete event per phase instance on the thread that ran it, with the
+ * counts and pool peaks under `otherData`. */
+void print_stats_trace(File* file, const StatsReport* report) {
+    const Stats* stats = &report->stats;
+    double       cycles_per_us = get_stats_cycles_per_us(report);
+    fprintf(file, "{\"traceEvents\":[\n");
+    for (u32 i = 0; i < report->thread_count; ++i) {
+        fprintf(file,
+                "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                "\"tid\":%u,\"args\":{\"name\":\"worker %u\"}},\n",
+                i,
+                i);
+    }
+    for (u32 i = 0; i < stats->event_count; ++i) {
+        const StatsEvent* event = &stats->events[i];
+        fprintf(file,
+                "{\"name\":\"%s\",\"cat\":\"disasm\",\"ph\":\"X\","
+                "\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f},\n",
+                get_stats_phase_name(event->phase),
+                event->thread,
+                (double)(event->start - report->start.cycles) / cycles_per_us,
+                (double)event->cycles / cycles_per_us);
+    }
+    fprintf(file,
+            "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+            "\"args\":{\"name\":\"disasm\"}}\n"
+            "],\"otherData\":{\"constant_tags\":{");
+    Bool first = TRUE;
+    for (u32 i = 0; i < COUNT_STATS_CONSTANT_TAGS; ++i) {
+        if (stats->constant_tag_counts[i] != 0) {
+            fprintf(file,
+                    "%s\"%s\":%lu",
+                    first ? "" : ",",
+                    get_json_constant_tag_name((ConstantTag)i),
+                    stats->constant_tag_counts[i]);
+            first = FALSE;
+        }
+    }
+    fprintf(file, "},\"attribute_tags\":{");
+    first = TRUE;
+    for (u32 i = 0; i < COUNT_STATS_ATTRIBUTE_TAGS; ++i) {
+        if (stats->attribute_tag_counts[i] != 0) {
+            fprintf(file,
+                    "%s\"%s\":%lu",
+                    first ? "" : ",",
+                    get_json_attribute_name((AttributeTag)i),
+                    stats->attribute_tag_counts[i]);
+            first = FALSE;
+        }
+    }
+    fprintf(file, "},\"op_codes\":{");
+    first = TRUE;
+    for (u32 i = 0; i < COUNT_STATS_OP_CODES; ++i) {
+        if (stats->op_code_counts[i] != 0) {
+            fprintf(file,
+                    "%s\"%s\":%lu",
+                    first ? "" : ",",
+                    get_stats_op_code_name((OpCode)i),
+                    stats->op_code_counts[i]);
+            first = FALSE;
+        }
+    }
+    fprintf(file,
+            "},\"arena_high_water\":%lu,\"arena_reserved\":%lu,"
+            "\"token_high_water\":%lu,\"attribute_high_water\":%lu,"
+            "\"output_high_water\":%lu}}\n",
+            stats->arena_high_water,
+            stats->arena_reserved,
+            stats->token_high_water,
+            stats->attribute_high_water,
+            stats->output_high_water);
+}
+
+void print_stats_report(StatsReport* report) {
+    if (report->text) {
+        print_stats(stderr, report);
+    }
+    if (report->trace_path != NULL) {
+        File* file = fopen(report->trace_path, "w");
+        if (file == NULL) {
+            fprintf(stderr,
+                    "[ERROR] Unable to open `%s`\n",
+                    report->trace_path);
+            exit(EXIT_FAILURE);
+        }
+        print_stats_trace(file, report);
+        fclose(file);
+    }
+    free_stats(&report->stats);
+}
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef __REPORT_H__
+#define __REPORT_H__
+
+#include "print.c"
+
+const char* get_stats_phase_name(StatsPhase);
+const char* get_stats_op_code_name(OpCode);
+double      get_stats_cycles_per_us(const StatsReport*);
+
+void set_stats_report(StatsReport*);
+#ifdef STATS
+void push_stats_class(Memory*, const Buffer*);
+void merge_stats(StatsReport*, Memory*, u32);
+#endif
+void print_stats(File*, const StatsReport*);
+void print_stats_trace(File*, const StatsReport*);
+void print_stats_report(StatsReport*);
+
+#endif
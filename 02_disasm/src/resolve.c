@@ -0,0 +1,294 @@
+#ifndef __RESOLVE_C__
+#define __RESOLVE_C__
+
+#include "resolve.h"
+
+static const char* METHOD_HANDLE_KINDS[COUNT_METHOD_HANDLE_KINDS] = {
+    "REF_?",
+    "REF_getField",
+    "REF_getStatic",
+    "REF_putField",
+    "REF_putStatic",
+    "REF_invokeVirtual",
+    "REF_invokeStatic",
+    "REF_invokeSpecial",
+    "REF_newInvokeSpecial",
+    "REF_invokeInterface",
+};
+
+/* NOTE: One slot per pool index; every chain below it is walked once and
+ * then shared, so a class named by a hundred refs is converted once. */
+void set_resolver(Memory* memory, Resolver* resolver) {
+    resolver->memory = memory;
+    resolver->resolved =
+        alloc_memory_bytes(memory,
+                           sizeof(Resolved) * (u64)memory->constant_count,
+                           _Alignof(Resolved));
+    memset(resolver->resolved,
+           0,
+           sizeof(Resolved) * (u64)memory->constant_count);
+}
+
+Resolved get_resolved_chars(Resolver* resolver, const char* chars, u32 size) {
+    char* copy = alloc_chars(resolver->memory, size);
+    memcpy(copy, chars, size);
+    return (Resolved){.chars = copy, .size = size};
+}
+
+Resolved get_resolved_join(Resolver* resolver,
+                           Resolved  a,
+                           char      separator,
+                           Resolved  b) {
+    char* chars = alloc_chars(resolver->memory, a.size + 1 + b.size);
+    memcpy(chars, a.chars, a.size);
+    chars[a.size] = separator;
+    memcpy(&chars[a.size + 1], b.chars, b.size);
+    return (Resolved){.chars = chars, .size = a.size + 1 + b.size};
+}
+
+Resolved get_resolved_utf8(Resolver* resolver, u16 index) {
+    if (get_constant_tag(resolver->memory, index) != CONSTANT_TAG_UTF8) {
+        return (Resolved){.chars = "?", .size = 1};
+    }
+    Resolved* resolved = &resolver->resolved[index];
+    if (resolved->chars == NULL) {
+        ConstantUtf8 utf8 = get_utf8(resolver->memory, index);
+        char*        chars = alloc_chars(resolver->memory, utf8.size);
+        resolved->size = set_mutf8_to_utf8(utf8.bytes, utf8.size, (u8*)chars);
+        resolved->chars = chars;
+    }
+    return *resolved;
+}
+
+/* NOTE: Quoted, with the escapes that would otherwise break a line of
+ * output; sized in a first pass so the copy is allocated once. */
+Resolved get_resolved_string(Resolver* resolver, u16 index) {
+    Resolved utf8 = get_resolved_utf8(resolver, index);
+    u32      size = utf8.size + 2;
+    for (u32 i = 0; i < utf8.size; ++i) {
+        char x = utf8.chars[i];
+        if ((x == '"') || (x == '\\') || (x == '\n') || (x == '\r') ||
+            (x == '\t'))
+        {
+            ++size;
+        }
+    }
+    char* chars = alloc_chars(resolver->memory, size);
+    u32   n = 0;
+    chars[n++] = '"';
+    for (u32 i = 0; i < utf8.size; ++i) {
+        char x = utf8.chars[i];
+        switch (x) {
+        case '"':
+        case '\\': {
+            chars[n++] = '\\';
+            chars[n++] = x;
+            break;
+        }
+        case '\n': {
+            chars[n++] = '\\';
+            chars[n++] = 'n';
+            break;
+        }
+        case '\r': {
+            chars[n++] = '\\';
+            chars[n++] = 'r';
+            break;
+        }
+        case '\t': {
+            chars[n++] = '\\';
+            chars[n++] = 't';
+            break;
+        }
+        default: {
+            chars[n++] = x;
+        }
+        }
+    }
+    chars[n++] = '"';
+    return (Resolved){.chars = chars, .size = n};
+}
+
+/* NOTE: Floats print with the fewest digits that read back to the same
+ * bits, plus the `f`, `l`, `d` suffixes Java source would use. */
+Resolved get_resolved_number(Resolver* resolver, ConstantTag tag, u64 bits) {
+    char chars[SIZE_RESOLVED_NUMBER];
+    i32  size = 0;
+    if (tag == CONSTANT_TAG_INTEGER) {
+        size = snprintf(chars, sizeof(chars), "%d", (i32)(u32)bits);
+    } else if (tag == CONSTANT_TAG_LONG) {
+        size = snprintf(chars, sizeof(chars), "%" PRId64 "l", (i64)bits);
+    } else {
+        Bool   is_float = tag == CONSTANT_TAG_FLOAT;
+        double value;
+        if (is_float) {
+            u32   low = (u32)bits;
+            float x;
+            memcpy(&x, &low, sizeof(x));
+            value = (double)x;
+        } else {
+            memcpy(&value, &bits, sizeof(value));
+        }
+        if (isnan(value)) {
+            size = snprintf(chars, sizeof(chars), "NaN");
+        } else if (isinf(value)) {
+            size = snprintf(chars,
+                            sizeof(chars),
+                            value < 0 ? "-Infinity" : "Infinity");
+        } else {
+            for (i32 precision = 1; precision <= 17; ++precision) {
+                size = snprintf(chars,
+                                sizeof(chars),
+                                "%.*g",
+                                precision,
+                                value);
+                u64 read_bits = 0;
+                if (is_float) {
+                    float x = strtof(chars, NULL);
+                    u32   low;
+                    memcpy(&low, &x, sizeof(low));
+                    read_bits = low;
+                } else {
+                    double x = strtod(chars, NULL);
+                    memcpy(&read_bits, &x, sizeof(read_bits));
+                }
+                if (read_bits == bits) {
+                    break;
+                }
+            }
+            if (strcspn(chars, ".e") == (u64)size) {
+                chars[size++] = '.';
+                chars[size++] = '0';
+            }
+        }
+        chars[size++] = is_float ? 'f' : 'd';
+    }
+    return get_resolved_chars(resolver, chars, (u32)size);
+}
+
+Resolved get_resolved_method_handle(Resolver* resolver,
+                                    u8        kind,
+                                    u16       reference_index) {
+    ConstantTag tag = get_constant_tag(resolver->memory, reference_index);
+    const char* name =
+        METHOD_HANDLE_KINDS[kind < COUNT_METHOD_HANDLE_KINDS ? kind : 0];
+    Resolved    reference = {.chars = "?", .size = 1};
+    if ((tag == CONSTANT_TAG_FIELD_REF) || (tag == CONSTANT_TAG_METHOD_REF) ||
+        (tag == CONSTANT_TAG_INTERFACE_METHOD_REF))
+    {
+        reference = get_resolved(resolver, reference_index);
+    }
+    return get_resolved_join(resolver,
+                             (Resolved){.chars = name,
+                                        .size = (u32)strlen(name)},
+                             ' ',
+                             reference);
+}
+
+Resolved get_resolved_dynamic(Resolver* resolver,
+                              u16       bootstrap_index,
+                              u16       name_and_type_index) {
+    char     chars[SIZE_RESOLVED_NUMBER];
+    i32      size = snprintf(chars, sizeof(chars), "#%u", bootstrap_index);
+    Resolved name_and_type = {.chars = "?", .size = 1};
+    if (get_constant_tag(resolver->memory, name_and_type_index) ==
+        CONSTANT_TAG_NAME_AND_TYPE)
+    {
+        name_and_type = get_resolved(resolver, name_and_type_index);
+    }
+    return get_resolved_join(resolver,
+                             (Resolved){.chars = chars, .size = (u32)size},
+                             ':',
+                             name_and_type);
+}
+
+/* NOTE: Each kind only follows indices of the kinds it may point at, so a
+ * malformed pool cannot send the walk around a cycle. */
+Resolved get_resolved(Resolver* resolver, u16 index) {
+    Memory*     memory = resolver->memory;
+    ConstantTag tag = get_constant_tag(memory, index);
+    if (tag == 0) {
+        return (Resolved){.chars = "?", .size = 1};
+    }
+    Resolved* resolved = &resolver->resolved[index];
+    if (resolved->chars != NULL) {
+        return *resolved;
+    }
+    Constant constant = get_constant(memory, index);
+    switch (tag) {
+    case CONSTANT_TAG_UTF8: {
+        return get_resolved_utf8(resolver, index);
+    }
+    case CONSTANT_TAG_INTEGER:
+    case CONSTANT_TAG_FLOAT: {
+        *resolved = get_resolved_number(resolver, tag, constant.u32);
+        break;
+    }
+    case CONSTANT_TAG_LONG:
+    case CONSTANT_TAG_DOUBLE: {
+        u64 high = constant.wide.high_bytes;
+        u64 low = constant.wide.low_bytes;
+        *resolved = get_resolved_number(resolver, tag, (high << 32) | low);
+        break;
+    }
+    case CONSTANT_TAG_CLASS:
+    case CONSTANT_TAG_METHOD_TYPE:
+    case CONSTANT_TAG_MODULE:
+    case CONSTANT_TAG_PACKAGE: {
+        *resolved = get_resolved_utf8(resolver, constant.u16);
+        break;
+    }
+    case CONSTANT_TAG_STRING: {
+        *resolved =
+            get_resolved_string(resolver, constant.string.string_index);
+        break;
+    }
+    case CONSTANT_TAG_FIELD_REF:
+    case CONSTANT_TAG_METHOD_REF:
+    case CONSTANT_TAG_INTERFACE_METHOD_REF: {
+        u16      class_index = constant.ref.class_index;
+        u16      name_and_type_index = constant.ref.name_and_type_index;
+        Resolved class_name = {.chars = "?", .size = 1};
+        Resolved name_and_type = {.chars = "?", .size = 1};
+        if (get_constant_tag(memory, class_index) == CONSTANT_TAG_CLASS) {
+            class_name = get_resolved(resolver, class_index);
+        }
+        if (get_constant_tag(memory, name_and_type_index) ==
+            CONSTANT_TAG_NAME_AND_TYPE)
+        {
+            name_and_type = get_resolved(resolver, name_and_type_index);
+        }
+        *resolved =
+            get_resolved_join(resolver, class_name, '.', name_and_type);
+        break;
+    }
+    case CONSTANT_TAG_NAME_AND_TYPE: {
+        u16 name_index = constant.name_and_type.name_index;
+        u16 descriptor_index = constant.name_and_type.descriptor_index;
+        *resolved =
+            get_resolved_join(resolver,
+                              get_resolved_utf8(resolver, name_index),
+                              ':',
+                              get_resolved_utf8(resolver, descriptor_index));
+        break;
+    }
+    case CONSTANT_TAG_METHOD_HANDLE: {
+        *resolved = get_resolved_method_handle(
+            resolver,
+            constant.method_handle.reference_kind,
+            constant.method_handle.reference_index);
+        break;
+    }
+    case CONSTANT_TAG_DYNAMIC:
+    case CONSTANT_TAG_INVOKE_DYNAMIC: {
+        *resolved =
+            get_resolved_dynamic(resolver,
+                                 constant.dynamic.bootstrap_method_attr_index,
+                                 constant.dynamic.name_and_type_index);
+        break;
+    }
+    }
+    return *resolved;
+}
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef __RESOLVE_H__
+#define __RESOLVE_H__
+
+#include <inttypes.h>
+#include <math.h>
+
+#include "memory.c"
+
+#define COUNT_METHOD_HANDLE_KINDS 10
+#define SIZE_RESOLVED_NUMBER      32
+
+/* NOTE: A constant spelled out the way `javap` would, already converted to
+ * UTF-8 so printing it is one copy. `chars` stays NULL until the constant
+ * is first asked for. */
+typedef struct {
+    const char* chars;
+    u32         size;
+} Resolved;
+
+typedef struct {
+    Memory*   memory;
+    Resolved* resolved;
+} Resolver;
+
+void set_resolver(Memory*, Resolver*);
+
+Resolved get_resolved_chars(Resolver*, const char*, u32);
+Resolved get_resolved_join(Resolver*, Resolved, char, Resolved);
+Resolved get_resolved_utf8(Resolver*, u16);
+Resolved get_resolved_string(Resolver*, u16);
+Resolved get_resolved_number(Resolver*, ConstantTag, u64);
+Resolved get_resolved_method_handle(Resolver*, u8, u16);
+Resolved get_resolved_dynamic(Resolver*, u16, u16);
+Resolved get_resolved(Resolver*, u16);
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef __STATS_C__
+#define __STATS_C__
+
+#include "stats.h"
+
+/* NOTE: The time stamp counter where there is one; it ticks at a constant
+ * rate on anything recent, and `get_stats_clock` pairs it with the
+ * monotonic clock so the report can convert. Elsewhere the "cycles" are
+ * nanoseconds. */
+u64 get_stats_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((u64)now.tv_sec * 1000000000) + (u64)now.tv_nsec;
+#endif
+}
+
+StatsClock get_stats_clock(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (StatsClock){
+        .cycles = get_stats_cycles(),
+        .nanoseconds = ((u64)now.tv_sec * 1000000000) + (u64)now.tv_nsec,
+    };
+}
+
+void push_stats_event(Stats* stats, StatsEvent event) {
+    if (stats->event_capacity <= stats->event_count) {
+        u32 event_capacity = stats->event_capacity == 0
+                                 ? COUNT_STATS_EVENTS
+                                 : stats->event_capacity * 2;
+        StatsEvent* events =
+            realloc(stats->events, sizeof(StatsEvent) * event_capacity);
+        if (events == NULL) {
+            fprintf(stderr, "[ERROR] `realloc` failed\n");
+            exit(EXIT_FAILURE);
+        }
+        stats->events = events;
+        stats->event_capacity = event_capacity;
+    }
+    stats->events[stats->event_count++] = event;
+}
+
+void push_stats_phase(Stats* stats, StatsPhase phase) {
+    if (COUNT_STATS_DEPTH <= stats->depth) {
+        fprintf(stderr, "[ERROR] Stats phases nested too deeply\n");
+        exit(EXIT_FAILURE);
+    }
+    stats->open_phases[stats->depth] = phase;
+    stats->open_child_cycles[stats->depth] = 0;
+    stats->open_starts[stats->depth] = get_stats_cycles();
+    ++stats->depth;
+}
+
+/* NOTE: Also closes anything left open inside `phase`, which only happens
+ * when a parse error unwound past its `STATS_POP`. */
+void pop_stats_phase(Stats* stats, StatsPhase phase) {
+    u64 end = get_stats_cycles();
+    while (stats->depth != 0) {
+        u32        depth = --stats->depth;
+        StatsPhase open_phase = stats->open_phases[depth];
+        u64        cycles = end - stats->open_starts[depth];
+        stats->phase_cycles[open_phase] +=
+            cycles - stats->open_child_cycles[depth];
+        ++stats->phase_counts[open_phase];
+        if (depth != 0) {
+            stats->open_child_cycles[depth - 1] += cycles;
+        }
+        push_stats_event(stats,
+                         (StatsEvent){
+                             .start = stats->open_starts[depth],
+                             .cycles = cycles,
+                             .phase = open_phase,
+                         });
+        if (open_phase == phase) {
+            return;
+        }
+    }
+}
+
+/* NOTE: Called where a parse error lands, with the depth from before the
+ * `setjmp`. */
+void unwind_stats(Stats* stats, u32 depth) {
+    while (depth < stats->depth) {
+        pop_stats_phase(stats, stats->open_phases[stats->depth - 1]);
+    }
+}
+
+void free_stats(Stats* stats) {
+    free(stats->events);
+    stats->events = NULL;
+    stats->event_count = 0;
+    stats->event_capacity = 0;
+}
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef __STATS_H__
+#define __STATS_H__
+
+#include <time.h>
+
+#include "prelude.h"
+
+/* NOTE: Everything that touches the hot path is behind `-DSTATS`; without
+ * it the hooks below expand to nothing and `Memory` keeps its layout. The
+ * types stay visible either way so the command line can reject `--stats`
+ * with a clear message instead of failing to build. */
+
+#define COUNT_STATS_DEPTH          8
+#define COUNT_STATS_EVENTS         1024
+#define COUNT_STATS_CONSTANT_TAGS  32
+#define COUNT_STATS_ATTRIBUTE_TAGS 8
+#define COUNT_STATS_OP_CODES       256
+
+typedef enum {
+    STATS_LOAD,
+    STATS_CONSTANT_POOL,
+    STATS_METHODS,
+    STATS_ATTRIBUTES,
+    STATS_PRINT,
+    COUNT_STATS_PHASES,
+} StatsPhase;
+
+typedef struct {
+    u64        start;
+    u64        cycles;
+    u32        thread;
+    StatsPhase phase;
+} StatsEvent;
+
+typedef struct {
+    u64 cycles;
+    u64 nanoseconds;
+} StatsClock;
+
+/* NOTE: Phases nest (method attributes are parsed lazily while printing),
+ * so each open phase also collects the cycles of the phases inside it and
+ * `phase_cycles` ends up exclusive; the shares in the report add up to the
+ * instrumented total. */
+typedef struct {
+    StatsEvent* events;
+    u32         event_count;
+    u32         event_capacity;
+    u32         depth;
+    StatsPhase  open_phases[COUNT_STATS_DEPTH];
+    u64         open_starts[COUNT_STATS_DEPTH];
+    u64         open_child_cycles[COUNT_STATS_DEPTH];
+    u64         phase_cycles[COUNT_STATS_PHASES];
+    u64         phase_counts[COUNT_STATS_PHASES];
+    u64         constant_tag_counts[COUNT_STATS_CONSTANT_TAGS];
+    u64         attribute_tag_counts[COUNT_STATS_ATTRIBUTE_TAGS];
+    u64         op_code_counts[COUNT_STATS_OP_CODES];
+    u64         arena_high_water;
+    u64         arena_reserved;
+    u64         token_high_water;
+    u64         attribute_high_water;
+    u64         output_high_water;
+} Stats;
+
+typedef struct {
+    Stats       stats;
+    StatsClock  start;
+    const char* trace_path;
+    u32         thread_count;
+    Bool        text;
+} StatsReport;
+
+#ifdef STATS
+    #define STATS_PUSH(memory, phase) push_stats_phase(&(memory)->stats, phase)
+    #define STATS_POP(memory, phase)  pop_stats_phase(&(memory)->stats, phase)
+    #define STATS_COUNT_CONSTANT(memory, tag) \
+        ++(memory)->stats.constant_tag_counts[tag]
+    #define STATS_COUNT_ATTRIBUTE(memory, tag) \
+        ++(memory)->stats.attribute_tag_counts[tag]
+    #define STATS_COUNT_OP_CODE(memory, op_code) \
+        ++(memory)->stats.op_code_counts[op_code]
+    #define STATS_CLASS(memory, buffer) push_stats_class(memory, buffer)
+#else
+    #define STATS_PUSH(memory, phase)
+    #define STATS_POP(memory, phase)
+    #define STATS_COUNT_CONSTANT(memory, tag)
+    #define STATS_COUNT_ATTRIBUTE(memory, tag)
+    #define STATS_COUNT_OP_CODE(memory, op_code)
+    #define STATS_CLASS(memory, buffer)
+#endif
+
+u64        get_stats_cycles(void);
+StatsClock get_stats_clock(void);
+
+void push_stats_event(Stats*, StatsEvent);
+void push_stats_phase(Stats*, StatsPhase);
+void pop_stats_phase(Stats*, StatsPhase);
+void unwind_stats(Stats*, u32);
+void free_stats(Stats*);
+
+#endif
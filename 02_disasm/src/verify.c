@@ -0,0 +1,1170 @@
+#ifndef __VERIFY_C__
+#define __VERIFY_C__
+
+#include "verify.h"
+
+/* NOTE: Operand types of the instructions that need nothing but their
+ * operand stack checked, as `pops>pushes` with the top of the stack last.
+ * `I`, `F`, `J` and `D` are the primitives, `A` an initialized reference,
+ * `R` any reference and `N` null. Everything left `NULL` is handled by
+ * `set_instruction`. */
+static const char* VERIFY_SIGNATURES[COUNT_OP_CODES] = {
+    [OP_NOP] = ">",
+    [OP_ACONST_NULL] = ">N",
+    [OP_ICONST_M1] = ">I",
+    [OP_ICONST_0] = ">I",
+    [OP_ICONST_1] = ">I",
+    [OP_ICONST_2] = ">I",
+    [OP_ICONST_3] = ">I",
+    [OP_ICONST_4] = ">I",
+    [OP_ICONST_5] = ">I",
+    [OP_LCONST_0] = ">J",
+    [OP_LCONST_1] = ">J",
+    [OP_FCONST_0] = ">F",
+    [OP_FCONST_1] = ">F",
+    [OP_FCONST_2] = ">F",
+    [OP_DCONST_0] = ">D",
+    [OP_DCONST_1] = ">D",
+    [OP_BIPUSH] = ">I",
+    [OP_SIPUSH] = ">I",
+    [OP_IALOAD] = "AI>I",
+    [OP_LALOAD] = "AI>J",
+    [OP_FALOAD] = "AI>F",
+    [OP_DALOAD] = "AI>D",
+    [OP_AALOAD] = "AI>A",
+    [OP_BALOAD] = "AI>I",
+    [OP_CALOAD] = "AI>I",
+    [OP_SALOAD] = "AI>I",
+    [OP_IASTORE] = "AII>",
+    [OP_LASTORE] = "AIJ>",
+    [OP_FASTORE] = "AIF>",
+    [OP_DASTORE] = "AID>",
+    [OP_AASTORE] = "AIA>",
+    [OP_BASTORE] = "AII>",
+    [OP_CASTORE] = "AII>",
+    [OP_SASTORE] = "AII>",
+    [OP_IADD] = "II>I",
+    [OP_LADD] = "JJ>J",
+    [OP_FADD] = "FF>F",
+    [OP_DADD] = "DD>D",
+    [OP_ISUB] = "II>I",
+    [OP_LSUB] = "JJ>J",
+    [OP_FSUB] = "FF>F",
+    [OP_DSUB] = "DD>D",
+    [OP_IMUL] = "II>I",
+    [OP_LMUL] = "JJ>J",
+    [OP_FMUL] = "FF>F",
+    [OP_DMUL] = "DD>D",
+    [OP_IDIV] = "II>I",
+    [OP_LDIV] = "JJ>J",
+    [OP_FDIV] = "FF>F",
+    [OP_DDIV] = "DD>D",
+    [OP_IREM] = "II>I",
+    [OP_LREM] = "JJ>J",
+    [OP_FREM] = "FF>F",
+    [OP_DREM] = "DD>D",
+    [OP_INEG] = "I>I",
+    [OP_LNEG] = "J>J",
+    [OP_FNEG] = "F>F",
+    [OP_DNEG] = "D>D",
+    [OP_ISHL] = "II>I",
+    [OP_LSHL] = "JI>J",
+    [OP_ISHR] = "II>I",
+    [OP_LSHR] = "JI>J",
+    [OP_IUSHR] = "II>I",
+    [OP_LUSHR] = "JI>J",
+    [OP_IAND] = "II>I",
+    [OP_LAND] = "JJ>J",
+    [OP_IOR] = "II>I",
+    [OP_LOR] = "JJ>J",
+    [OP_IXOR] = "II>I",
+    [OP_LXOR] = "JJ>J",
+    [OP_I2L] = "I>J",
+    [OP_I2F] = "I>F",
+    [OP_I2D] = "I>D",
+    [OP_L2I] = "J>I",
+    [OP_L2F] = "J>F",
+    [OP_L2D] = "J>D",
+    [OP_F2I] = "F>I",
+    [OP_F2L] = "F>J",
+    [OP_F2D] = "F>D",
+    [OP_D2I] = "D>I",
+    [OP_D2L] = "D>J",
+    [OP_D2F] = "D>F",
+    [OP_I2B] = "I>I",
+    [OP_I2C] = "I>I",
+    [OP_I2S] = "I>I",
+    [OP_LCMP] = "JJ>I",
+    [OP_FCMPL] = "FF>I",
+    [OP_FCMPG] = "FF>I",
+    [OP_DCMPL] = "DD>I",
+    [OP_DCMPG] = "DD>I",
+    [OP_IFEQ] = "I>",
+    [OP_IFNE] = "I>",
+    [OP_IFLT] = "I>",
+    [OP_IFGE] = "I>",
+    [OP_IFGT] = "I>",
+    [OP_IFLE] = "I>",
+    [OP_IF_ICMPEQ] = "II>",
+    [OP_IF_ICMPNE] = "II>",
+    [OP_IF_ICMPLT] = "II>",
+    [OP_IF_ICMPGE] = "II>",
+    [OP_IF_ICMPGT] = "II>",
+    [OP_IF_ICMPLE] = "II>",
+    [OP_IF_ACMPEQ] = "RR>",
+    [OP_IF_ACMPNE] = "RR>",
+    [OP_GOTO] = ">",
+    [OP_TABLESWITCH] = "I>",
+    [OP_LOOKUPSWITCH] = "I>",
+    [OP_NEWARRAY] = "I>A",
+    [OP_ANEWARRAY] = "I>A",
+    [OP_ARRAYLENGTH] = "A>I",
+    [OP_ATHROW] = "A>",
+    [OP_INSTANCEOF] = "A>I",
+    [OP_MONITORENTER] = "R>",
+    [OP_MONITOREXIT] = "R>",
+    [OP_IFNULL] = "R>",
+    [OP_IFNONNULL] = "R>",
+    [OP_GOTO_W] = ">",
+};
+
+/* NOTE: Indexed by the offset of an opcode from `iload`, `istore` and
+ * friends, which all come in the order int, long, float, double,
+ * reference. */
+static const VerificationTypeTag LOAD_TAGS[COUNT_LOAD_KINDS] = {
+    VERI_INTEGER,
+    VERI_LONG,
+    VERI_FLOAT,
+    VERI_DOUBLE,
+    VERI_OBJECT,
+};
+
+_Noreturn void set_verify_error(Verifier* verifier, ParseErrorCode code) {
+    Memory* memory = verifier->memory;
+    memory->byte_index =
+        (u32)(verifier->code->bytes - memory->bytes) + verifier->pc;
+    set_parse_error(memory, code);
+}
+
+/* NOTE: An `Object` with constant pool index zero is a reference whose
+ * class is not tracked, e.g. one read from a descriptor. */
+VerificationType get_type(VerificationTypeTag tag, u16 index) {
+    VerificationType type;
+    type.constant_pool_index = index;
+    type.tag = tag;
+    type.bit_tag = (u8)tag;
+    return type;
+}
+
+Bool is_wide_type(VerificationType type) {
+    return (type.tag == VERI_LONG) || (type.tag == VERI_DOUBLE);
+}
+
+Bool is_reference_type(VerificationType type) {
+    return (type.tag == VERI_NULL) || (type.tag == VERI_OBJECT) ||
+           (type.tag == VERI_UNINIT_THIS) || (type.tag == VERI_UNINIT);
+}
+
+Bool is_same_type(VerificationType a, VerificationType b) {
+    return (a.tag == b.tag) &&
+           ((a.tag != VERI_UNINIT) || (a.offset == b.offset));
+}
+
+/* NOTE: Without loading other classes there is no hierarchy to walk, so
+ * any initialized reference is taken to fit any class type; that part of
+ * the check is left to the JVM at link time. */
+Bool is_assignable(VerificationType from, VerificationType to) {
+    switch (to.tag) {
+    case VERI_TOP: {
+        return TRUE;
+    }
+    case VERI_INTEGER:
+    case VERI_FLOAT:
+    case VERI_DOUBLE:
+    case VERI_LONG:
+    case VERI_NULL:
+    case VERI_UNINIT_THIS: {
+        return from.tag == to.tag;
+    }
+    case VERI_OBJECT: {
+        return (from.tag == VERI_NULL) || (from.tag == VERI_OBJECT);
+    }
+    case VERI_UNINIT: {
+        return (from.tag == VERI_UNINIT) && (from.offset == to.offset);
+    }
+    }
+    return FALSE;
+}
+
+Bool is_frame_assignable(Verifier* verifier, const Frame* frame) {
+    const Frame* current = &verifier->frame;
+    for (u16 i = 0; i < verifier->code->max_local; ++i) {
+        if (!is_assignable(current->locals[i], frame->locals[i])) {
+            return FALSE;
+        }
+    }
+    if (current->stack_size != frame->stack_size) {
+        return FALSE;
+    }
+    for (u16 i = 0; i < current->stack_size; ++i) {
+        if (!is_assignable(current->stack[i], frame->stack[i])) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/* NOTE: A handler is entered with the locals of the instruction that
+ * threw and nothing on the stack but the exception. */
+Bool is_handler_assignable(Verifier*    verifier,
+                           const Frame* frame,
+                           u16          catch_type) {
+    const Frame* current = &verifier->frame;
+    for (u16 i = 0; i < verifier->code->max_local; ++i) {
+        if (!is_assignable(current->locals[i], frame->locals[i])) {
+            return FALSE;
+        }
+    }
+    return (frame->stack_size == 1) &&
+           is_assignable(get_type(VERI_OBJECT, catch_type), frame->stack[0]);
+}
+
+void alloc_frame(Verifier* verifier, Frame* frame) {
+    const Code* code = verifier->code;
+    frame->locals = alloc_verification_types(verifier->memory,
+                                             code->max_local);
+    frame->stack = alloc_verification_types(verifier->memory,
+                                            code->max_stack);
+    for (u16 i = 0; i < code->max_local; ++i) {
+        frame->locals[i] = get_type(VERI_TOP, 0);
+    }
+    frame->local_size = 0;
+    frame->stack_size = 0;
+}
+
+void set_frame(Verifier* verifier, Frame* to, const Frame* from) {
+    memcpy(to->locals,
+           from->locals,
+           sizeof(VerificationType) * verifier->code->max_local);
+    memcpy(to->stack,
+           from->stack,
+           sizeof(VerificationType) * from->stack_size);
+    to->local_size = from->local_size;
+    to->stack_size = from->stack_size;
+}
+
+/* NOTE: Checks a stack map item before it goes into a frame. An
+ * `Uninitialized` item must name a `new` instruction, which `set_init`
+ * reads its class from. */
+VerificationType get_frame_item(Verifier* verifier, VerificationType type) {
+    const Code* code = verifier->code;
+    if (((type.tag == VERI_OBJECT) &&
+         (get_constant_tag(verifier->memory, type.constant_pool_index) !=
+          CONSTANT_TAG_CLASS)) ||
+        ((type.tag == VERI_UNINIT) &&
+         ((code->byte_count <= type.offset) ||
+          !(verifier->cfg.pc_flags[type.offset] & PC_INSTRUCTION) ||
+          (code->bytes[type.offset] != OP_NEW))))
+    {
+        set_verify_error(verifier, PARSE_BAD_FRAME);
+    }
+    return type;
+}
+
+void push_frame_local(Verifier*        verifier,
+                      Frame*           frame,
+                      VerificationType type) {
+    u32 size = is_wide_type(type) ? 2 : 1;
+    if (verifier->code->max_local < (frame->local_size + size)) {
+        set_verify_error(verifier, PARSE_BAD_LOCAL);
+    }
+    frame->locals[frame->local_size++] = type;
+    if (size == 2) {
+        frame->locals[frame->local_size++] = get_type(VERI_TOP, 0);
+    }
+}
+
+void push_frame_stack(Verifier*        verifier,
+                      Frame*           frame,
+                      VerificationType type) {
+    u32 size = is_wide_type(type) ? 2 : 1;
+    if (verifier->code->max_stack < (frame->stack_size + size)) {
+        set_verify_error(verifier, PARSE_BAD_STACK);
+    }
+    frame->stack[frame->stack_size++] = type;
+    if (size == 2) {
+        frame->stack[frame->stack_size++] = get_type(VERI_TOP, 0);
+    }
+}
+
+VerificationType get_signature_type(char signature) {
+    switch (signature) {
+    case 'I': {
+        return get_type(VERI_INTEGER, 0);
+    }
+    case 'F': {
+        return get_type(VERI_FLOAT, 0);
+    }
+    case 'J': {
+        return get_type(VERI_LONG, 0);
+    }
+    case 'D': {
+        return get_type(VERI_DOUBLE, 0);
+    }
+    case 'N': {
+        return get_type(VERI_NULL, 0);
+    }
+    default: {
+        return get_type(VERI_OBJECT, 0);
+    }
+    }
+}
+
+/* NOTE: Reads one field type at `*index`; `V` comes back as `Top`, which
+ * only a return type may be. */
+VerificationType get_descriptor_type(Verifier*    verifier,
+                                     ConstantUtf8 descriptor,
+                                     u32*         index) {
+    if (descriptor.size <= *index) {
+        set_verify_error(verifier, PARSE_BAD_DESCRIPTOR);
+    }
+    u8 byte = descriptor.bytes[(*index)++];
+    switch (byte) {
+    case 'B':
+    case 'C':
+    case 'I':
+    case 'S':
+    case 'Z': {
+        return get_type(VERI_INTEGER, 0);
+    }
+    case 'F': {
+        return get_type(VERI_FLOAT, 0);
+    }
+    case 'J': {
+        return get_type(VERI_LONG, 0);
+    }
+    case 'D': {
+        return get_type(VERI_DOUBLE, 0);
+    }
+    case 'V': {
+        return get_type(VERI_TOP, 0);
+    }
+    case 'L': {
+        u32 start = *index;
+        while ((*index < descriptor.size) &&
+               (descriptor.bytes[*index] != ';'))
+        {
+            ++(*index);
+        }
+        if ((*index == start) || (descriptor.size <= *index)) {
+            set_verify_error(verifier, PARSE_BAD_DESCRIPTOR);
+        }
+        ++(*index);
+        return get_type(VERI_OBJECT, 0);
+    }
+    case '[': {
+        while ((*index < descriptor.size) &&
+               (descriptor.bytes[*index] == '['))
+        {
+            ++(*index);
+        }
+        if (get_descriptor_type(verifier, descriptor, index).tag == VERI_TOP)
+        {
+            set_verify_error(verifier, PARSE_BAD_DESCRIPTOR);
+        }
+        return get_type(VERI_OBJECT, 0);
+    }
+    default: {
+        set_verify_error(verifier, PARSE_BAD_DESCRIPTOR);
+    }
+    }
+}
+
+VerificationType get_field_type(Verifier* verifier, u16 descriptor_index) {
+    ConstantUtf8     descriptor = get_utf8(verifier->memory, descriptor_index);
+    u32              index = 0;
+    VerificationType type =
+        get_descriptor_type(verifier, descriptor, &index);
+    if ((type.tag == VERI_TOP) || (index != descriptor.size)) {
+        set_verify_error(verifier, PARSE_BAD_DESCRIPTOR);
+    }
+    return type;
+}
+
+/* NOTE: Validates a method descriptor and returns how many slots its
+ * arguments take. */
+u32 get_descriptor_size(Verifier*         verifier,
+                        ConstantUtf8      descriptor,
+                        VerificationType* return_type) {
+    if ((descriptor.size == 0) || (descriptor.bytes[0] != '(')) {
+        set_verify_error(verifier, PARSE_BAD_DESCRIPTOR);
+    }
+    u32 size = 0;
+    u32 index = 1;
+    while ((index < descriptor.size) && (descriptor.bytes[index] != ')')) {
+        VerificationType type =
+            get_descriptor_type(verifier, descriptor, &index);
+        if (type.tag == VERI_TOP) {
+            set_verify_error(verifier, PARSE_BAD_DESCRIPTOR);
+        }
+        size += is_wide_type(type) ? 2 : 1;
+    }
+    ++index;
+    *return_type = get_descriptor_type(verifier, descriptor, &index);
+    if (index != descriptor.size) {
+        set_verify_error(verifier, PARSE_BAD_DESCRIPTOR);
+    }
+    return size;
+}
+
+void push_type(Verifier* verifier, VerificationType type) {
+    Frame* frame = &verifier->frame;
+    u32    size = is_wide_type(type) ? 2 : 1;
+    if (verifier->code->max_stack < (frame->stack_size + size)) {
+        set_verify_error(verifier, PARSE_BAD_STACK);
+    }
+    frame->stack[frame->stack_size++] = type;
+    if (size == 2) {
+        frame->stack[frame->stack_size++] = get_type(VERI_TOP, 0);
+    }
+}
+
+VerificationType pop_type(Verifier* verifier, VerificationType type) {
+    Frame* frame = &verifier->frame;
+    u32    size = is_wide_type(type) ? 2 : 1;
+    if (frame->stack_size < size) {
+        set_verify_error(verifier, PARSE_BAD_STACK);
+    }
+    frame->stack_size = (u16)(frame->stack_size - size);
+    VerificationType popped = frame->stack[frame->stack_size];
+    if (!is_assignable(popped, type)) {
+        set_verify_error(verifier, PARSE_BAD_TYPE);
+    }
+    return popped;
+}
+
+VerificationType pop_reference(Verifier* verifier, Bool initialized) {
+    Frame* frame = &verifier->frame;
+    if (frame->stack_size == 0) {
+        set_verify_error(verifier, PARSE_BAD_STACK);
+    }
+    VerificationType popped = frame->stack[--frame->stack_size];
+    if (initialized ? !is_assignable(popped, get_type(VERI_OBJECT, 0))
+                    : !is_reference_type(popped))
+    {
+        set_verify_error(verifier, PARSE_BAD_TYPE);
+    }
+    return popped;
+}
+
+/* NOTE: Overwriting either half of a long or double leaves the other half
+ * unusable. */
+void set_local(Verifier* verifier, u32 index, VerificationType type) {
+    VerificationType* locals = verifier->frame.locals;
+    u32               size = is_wide_type(type) ? 2 : 1;
+    if (verifier->code->max_local < (index + size)) {
+        set_verify_error(verifier, PARSE_BAD_LOCAL);
+    }
+    if ((index != 0) && is_wide_type(locals[index - 1])) {
+        locals[index - 1] = get_type(VERI_TOP, 0);
+    }
+    locals[index] = type;
+    if (size == 2) {
+        locals[index + 1] = get_type(VERI_TOP, 0);
+    }
+}
+
+VerificationType get_local(Verifier*        verifier,
+                           u32              index,
+                           VerificationType type) {
+    u32 size = is_wide_type(type) ? 2 : 1;
+    if (verifier->code->max_local < (index + size)) {
+        set_verify_error(verifier, PARSE_BAD_LOCAL);
+    }
+    VerificationType local = verifier->frame.locals[index];
+    if (!is_assignable(local, type)) {
+        set_verify_error(verifier, PARSE_BAD_TYPE);
+    }
+    return local;
+}
+
+void set_initial_frame(Verifier* verifier) {
+    Memory*       memory = verifier->memory;
+    const Method* method = verifier->method;
+    Frame*        frame = &verifier->frame;
+    ConstantUtf8  descriptor = get_utf8(memory, method->descriptor_index);
+    alloc_frame(verifier, frame);
+    verifier->is_init =
+        get_utf8_eq(get_utf8(memory, method->name_index), "<init>");
+    if (!(method->access_flags & METHOD_ACC_STATIC)) {
+        Bool is_object =
+            get_utf8_eq(get_class_name(memory, memory->this_class),
+                        "java/lang/Object");
+        push_frame_local(verifier,
+                         frame,
+                         verifier->is_init && !is_object
+                             ? get_type(VERI_UNINIT_THIS, 0)
+                             : get_type(VERI_OBJECT, memory->this_class));
+    }
+    get_descriptor_size(verifier, descriptor, &verifier->return_type);
+    for (u32 i = 1; descriptor.bytes[i] != ')';) {
+        push_frame_local(verifier,
+                         frame,
+                         get_descriptor_type(verifier, descriptor, &i));
+    }
+}
+
+/* NOTE: Expands the compressed frames up front, since a branch may target
+ * a frame further down. Each one is relative to the one before it, the
+ * first to the frame built from the descriptor. */
+void set_stack_map_frames(Verifier* verifier) {
+    Memory*              memory = verifier->memory;
+    const Code*          code = verifier->code;
+    const StackMapTable* stack_map_table = NULL;
+    for (u32 i = code->attributes; i != 0;
+         i = get_attribute_at(memory, i)->next_attribute)
+    {
+        const Attribute* attribute = get_attribute_at(memory, i);
+        if (attribute->tag == ATTRIB_STACK_MAP_TABLE) {
+            stack_map_table = &attribute->stack_map_table;
+        }
+    }
+    u16 frame_count = stack_map_table == NULL ? 0 : stack_map_table->count;
+    verifier->frame_indices =
+        alloc_memory_bytes(memory,
+                           sizeof(u32) * (u64)code->byte_count,
+                           _Alignof(u32));
+    memset(verifier->frame_indices, 0, sizeof(u32) * (u64)code->byte_count);
+    verifier->frames = alloc_memory_bytes(memory,
+                                          sizeof(Frame) * frame_count,
+                                          _Alignof(Frame));
+    verifier->frame_count = frame_count;
+    const Frame* prev_frame = &verifier->frame;
+    u32          pc = 0;
+    for (u16 i = 0; i < frame_count; ++i) {
+        const StackMapEntry* entry = &stack_map_table->entries[i];
+        pc = i == 0 ? entry->offset_delta : pc + entry->offset_delta + 1;
+        if (code->byte_count <= pc) {
+            verifier->pc = code->byte_count;
+            set_verify_error(verifier, PARSE_BAD_FRAME);
+        }
+        verifier->pc = pc;
+        Frame* frame = &verifier->frames[i];
+        alloc_frame(verifier, frame);
+        set_frame(verifier, frame, prev_frame);
+        frame->stack_size = 0;
+        switch (entry->tag) {
+        case STACK_MAP_SAME_FRAME:
+        case STACK_MAP_SAME_FRAME_EXTENDED: {
+            break;
+        }
+        case STACK_MAP_SAME_LOCALS_1_STACK_ITEM_FRAME:
+        case STACK_MAP_SAME_LOCALS_1_STACK_ITEM_FRAME_EXTENDED: {
+            push_frame_stack(verifier,
+                             frame,
+                             get_frame_item(verifier, entry->stack_items[0]));
+            break;
+        }
+        case STACK_MAP_CHOP_FRAME: {
+            for (u32 j = 0; j < (u32)(251 - entry->bit_tag); ++j) {
+                if (frame->local_size == 0) {
+                    set_verify_error(verifier, PARSE_BAD_FRAME);
+                }
+                if ((2 <= frame->local_size) &&
+                    is_wide_type(frame->locals[frame->local_size - 2]))
+                {
+                    frame->locals[--frame->local_size] = get_type(VERI_TOP, 0);
+                }
+                frame->locals[--frame->local_size] = get_type(VERI_TOP, 0);
+            }
+            break;
+        }
+        case STACK_MAP_APPEND_FRAME: {
+            for (u16 j = 0; j < entry->local_item_count; ++j) {
+                VerificationType item =
+                    get_frame_item(verifier, entry->local_items[j]);
+                push_frame_local(verifier, frame, item);
+            }
+            break;
+        }
+        case STACK_MAP_FULL_FRAME: {
+            for (u16 j = 0; j < code->max_local; ++j) {
+                frame->locals[j] = get_type(VERI_TOP, 0);
+            }
+            frame->local_size = 0;
+            for (u16 j = 0; j < entry->local_item_count; ++j) {
+                VerificationType item =
+                    get_frame_item(verifier, entry->local_items[j]);
+                push_frame_local(verifier, frame, item);
+            }
+            for (u16 j = 0; j < entry->stack_item_count; ++j) {
+                VerificationType item =
+                    get_frame_item(verifier, entry->stack_items[j]);
+                push_frame_stack(verifier, frame, item);
+            }
+            break;
+        }
+        }
+        verifier->frame_indices[pc] = (u32)i + 1;
+        prev_frame = frame;
+    }
+}
+
+void set_branch_frame(Verifier* verifier, u32 pc) {
+    u32 frame_index = verifier->frame_indices[pc];
+    if ((frame_index == 0) ||
+        !is_frame_assignable(verifier, &verifier->frames[frame_index - 1]))
+    {
+        set_verify_error(verifier, PARSE_BAD_FRAME);
+    }
+}
+
+/* NOTE: Exception range ends are block leaders, so the handlers covering
+ * an instruction are exactly the handler edges of its block. */
+void set_handler_frames(Verifier* verifier) {
+    const Cfg*   cfg = &verifier->cfg;
+    const Block* block = &cfg->blocks[cfg->block_indices[verifier->pc]];
+    for (u32 i = block->handler; i != 0;
+         i = cfg->handlers[i - 1].next_handler)
+    {
+        const Edge* edge = &cfg->handlers[i - 1].edge;
+        u16 catch_type =
+            verifier->code->exception_table[edge->exception_index].catch_type;
+        if ((catch_type != 0) &&
+            (get_constant_tag(verifier->memory, catch_type) !=
+             CONSTANT_TAG_CLASS))
+        {
+            set_verify_error(verifier, PARSE_BAD_TYPE);
+        }
+        u32 frame_index =
+            verifier->frame_indices[cfg->blocks[edge->block_index].pc_start];
+        if ((frame_index == 0) ||
+            !is_handler_assignable(verifier,
+                                   &verifier->frames[frame_index - 1],
+                                   catch_type))
+        {
+            set_verify_error(verifier, PARSE_BAD_FRAME);
+        }
+    }
+}
+
+void set_signature(Verifier* verifier, const char* signature) {
+    const char* pushes = strchr(signature, '>');
+    for (const char* pop = pushes; pop != signature;) {
+        --pop;
+        if (*pop == 'A') {
+            pop_reference(verifier, TRUE);
+        } else if (*pop == 'R') {
+            pop_reference(verifier, FALSE);
+        } else {
+            pop_type(verifier, get_signature_type(*pop));
+        }
+    }
+    for (const char* push = pushes + 1; *push != '\0'; ++push) {
+        push_type(verifier, get_signature_type(*push));
+    }
+}
+
+/* NOTE: `aload` and `astore` move any reference, initialized or not. */
+void set_load(Verifier* verifier, u32 kind, u32 index) {
+    VerificationTypeTag tag = LOAD_TAGS[kind];
+    if (tag != VERI_OBJECT) {
+        push_type(verifier,
+                  get_local(verifier, index, get_type(tag, 0)));
+        return;
+    }
+    if (verifier->code->max_local <= index) {
+        set_verify_error(verifier, PARSE_BAD_LOCAL);
+    }
+    VerificationType local = verifier->frame.locals[index];
+    if (!is_reference_type(local)) {
+        set_verify_error(verifier, PARSE_BAD_TYPE);
+    }
+    push_type(verifier, local);
+}
+
+void set_store(Verifier* verifier, u32 kind, u32 index) {
+    VerificationTypeTag tag = LOAD_TAGS[kind];
+    set_local(verifier,
+              index,
+              tag == VERI_OBJECT ? pop_reference(verifier, FALSE)
+                                 : pop_type(verifier, get_type(tag, 0)));
+}
+
+/* NOTE: Covers `pop`, `dup` and `swap` in all their forms, on slots. The
+ * top `top` slots are popped, swapped with the `under` slots below them,
+ * or copied beneath those. Neither group may split a long or double,
+ * whose second slot is always `Top` on the stack. */
+void set_stack_op(Verifier* verifier, u32 top, u32 under, Bool copy) {
+    Frame*            frame = &verifier->frame;
+    VerificationType* stack = frame->stack;
+    u32               size = frame->stack_size;
+    if ((size < (top + under)) ||
+        (stack[size - top].tag == VERI_TOP) ||
+        ((under != 0) && (stack[size - top - under].tag == VERI_TOP)))
+    {
+        set_verify_error(verifier, PARSE_BAD_STACK);
+    }
+    if (!copy && (under == 0)) {
+        frame->stack_size = (u16)(size - top);
+    } else if (!copy) {
+        VerificationType type = stack[size - 1];
+        stack[size - 1] = stack[size - 2];
+        stack[size - 2] = type;
+    } else {
+        if (verifier->code->max_stack < (size + top)) {
+            set_verify_error(verifier, PARSE_BAD_STACK);
+        }
+        for (u32 i = size; (size - top - under) < i; --i) {
+            stack[i - 1 + top] = stack[i - 1];
+        }
+        for (u32 i = 0; i < top; ++i) {
+            stack[size - top - under + i] = stack[size + i];
+        }
+        frame->stack_size = (u16)(size + top);
+    }
+}
+
+void set_return(Verifier* verifier, VerificationTypeTag tag) {
+    if (verifier->return_type.tag != tag) {
+        set_verify_error(verifier, PARSE_BAD_TYPE);
+    }
+    if (tag == VERI_OBJECT) {
+        pop_reference(verifier, TRUE);
+    } else if (tag != VERI_TOP) {
+        pop_type(verifier, get_type(tag, 0));
+    } else if (verifier->is_init) {
+        for (u16 i = 0; i < verifier->code->max_local; ++i) {
+            if (verifier->frame.locals[i].tag == VERI_UNINIT_THIS) {
+                set_verify_error(verifier, PARSE_BAD_TYPE);
+            }
+        }
+    }
+}
+
+void set_ldc(Verifier* verifier, u16 index, Bool wide) {
+    Memory*          memory = verifier->memory;
+    ConstantTag      tag = get_constant_tag(memory, index);
+    VerificationType type = get_type(VERI_TOP, 0);
+    switch (tag) {
+    case CONSTANT_TAG_INTEGER: {
+        type = get_type(VERI_INTEGER, 0);
+        break;
+    }
+    case CONSTANT_TAG_FLOAT: {
+        type = get_type(VERI_FLOAT, 0);
+        break;
+    }
+    case CONSTANT_TAG_LONG: {
+        type = get_type(VERI_LONG, 0);
+        break;
+    }
+    case CONSTANT_TAG_DOUBLE: {
+        type = get_type(VERI_DOUBLE, 0);
+        break;
+    }
+    case CONSTANT_TAG_CLASS:
+    case CONSTANT_TAG_STRING:
+    case CONSTANT_TAG_METHOD_HANDLE:
+    case CONSTANT_TAG_METHOD_TYPE: {
+        type = get_type(VERI_OBJECT, 0);
+        break;
+    }
+    case CONSTANT_TAG_DYNAMIC: {
+        type = get_field_type(verifier,
+                              get_name_and_type(memory, index)
+                                  .descriptor_index);
+        break;
+    }
+    case CONSTANT_TAG_UTF8:
+    case CONSTANT_TAG_FIELD_REF:
+    case CONSTANT_TAG_METHOD_REF:
+    case CONSTANT_TAG_INTERFACE_METHOD_REF:
+    case CONSTANT_TAG_NAME_AND_TYPE:
+    case CONSTANT_TAG_INVOKE_DYNAMIC:
+    case CONSTANT_TAG_MODULE:
+    case CONSTANT_TAG_PACKAGE: {
+        break;
+    }
+    }
+    if ((type.tag == VERI_TOP) || (is_wide_type(type) != wide)) {
+        set_verify_error(verifier, PARSE_BAD_TYPE);
+    }
+    push_type(verifier, type);
+}
+
+void set_field(Verifier* verifier, OpCode op_code, u16 index) {
+    Memory* memory = verifier->memory;
+    if (get_constant_tag(memory, index) != CONSTANT_TAG_FIELD_REF) {
+        set_verify_error(verifier, PARSE_BAD_TYPE);
+    }
+    VerificationType type = get_field_type(
+        verifier,
+        get_name_and_type(memory, index).descriptor_index);
+    if (op_code == OP_GETSTATIC) {
+        push_type(verifier, type);
+    } else if (op_code == OP_PUTSTATIC) {
+        pop_type(verifier, type);
+    } else if (op_code == OP_GETFIELD) {
+        pop_reference(verifier, TRUE);
+        push_type(verifier, type);
+    } else {
+        pop_type(verifier, type);
+        /* NOTE: A constructor may set fields before calling `super`. */
+        VerificationType receiver = pop_reference(verifier, FALSE);
+        if ((receiver.tag == VERI_UNINIT) ||
+            ((receiver.tag == VERI_UNINIT_THIS) && !verifier->is_init))
+        {
+            set_verify_error(verifier, PARSE_BAD_TYPE);
+        }
+    }
+}
+
+/* NOTE: Once `<init>` returns, every copy of the object it was called on
+ * becomes an instance of the class named by its `new`, or of this class
+ * for `this`. */
+void set_init(Verifier* verifier, VerificationType receiver) {
+    const Code*      code = verifier->code;
+    VerificationType type =
+        get_type(VERI_OBJECT, verifier->memory->this_class);
+    if (receiver.tag == VERI_UNINIT) {
+        /* NOTE: Only `new` itself and `get_frame_item` make these, so the
+         * offset is always the start of a whole `new` instruction. */
+        type = get_type(VERI_OBJECT,
+                        get_u16_be(&code->bytes[receiver.offset + 1]));
+    }
+    Frame* frame = &verifier->frame;
+    for (u16 i = 0; i < code->max_local; ++i) {
+        if (is_same_type(frame->locals[i], receiver)) {
+            frame->locals[i] = type;
+        }
+    }
+    for (u16 i = 0; i < frame->stack_size; ++i) {
+        if (is_same_type(frame->stack[i], receiver)) {
+            frame->stack[i] = type;
+        }
+    }
+}
+
+void set_invoke(Verifier* verifier, OpCode op_code, u16 index) {
+    Memory*     memory = verifier->memory;
+    ConstantTag tag = get_constant_tag(memory, index);
+    Bool        is_tag_valid =
+        op_code == OP_INVOKEVIRTUAL     ? tag == CONSTANT_TAG_METHOD_REF
+        : op_code == OP_INVOKEINTERFACE ? tag ==
+                                          CONSTANT_TAG_INTERFACE_METHOD_REF
+        : op_code == OP_INVOKEDYNAMIC   ? tag == CONSTANT_TAG_INVOKE_DYNAMIC
+                                        : (tag == CONSTANT_TAG_METHOD_REF) ||
+                                        (tag ==
+                                         CONSTANT_TAG_INTERFACE_METHOD_REF);
+    if (!is_tag_valid) {
+        set_verify_error(verifier, PARSE_BAD_TYPE);
+    }
+    ConstantNameAndType name_and_type = get_name_and_type(memory, index);
+    ConstantUtf8 descriptor = get_utf8(memory, name_and_type.descriptor_index);
+    VerificationType return_type;
+    u32    size = get_descriptor_size(verifier, descriptor, &return_type);
+    Frame* frame = &verifier->frame;
+    if (frame->stack_size < size) {
+        set_verify_error(verifier, PARSE_BAD_STACK);
+    }
+    frame->stack_size = (u16)(frame->stack_size - size);
+    u32 slot = frame->stack_size;
+    for (u32 i = 1; descriptor.bytes[i] != ')';) {
+        VerificationType type = get_descriptor_type(verifier, descriptor, &i);
+        if (!is_assignable(frame->stack[slot], type)) {
+            set_verify_error(verifier, PARSE_BAD_TYPE);
+        }
+        slot += is_wide_type(type) ? 2 : 1;
+    }
+    if ((op_code == OP_INVOKESPECIAL) &&
+        get_utf8_eq(get_utf8(memory, name_and_type.name_index), "<init>"))
+    {
+        VerificationType receiver = pop_reference(verifier, FALSE);
+        if (((receiver.tag != VERI_UNINIT) &&
+             (receiver.tag != VERI_UNINIT_THIS)) ||
+            (return_type.tag != VERI_TOP))
+        {
+            set_verify_error(verifier, PARSE_BAD_TYPE);
+        }
+        set_init(verifier, receiver);
+    } else if ((op_code != OP_INVOKESTATIC) &&
+               (op_code != OP_INVOKEDYNAMIC))
+    {
+        pop_reference(verifier, TRUE);
+    }
+    if (return_type.tag != VERI_TOP) {
+        push_type(verifier, return_type);
+    }
+}
+
+/* NOTE: `jsr` and `ret` cannot appear in a class file that carries stack
+ * maps, so like the reserved opcodes they are rejected outright. */
+void set_instruction(Verifier* verifier) {
+    Memory*     memory = verifier->memory;
+    const Code* code = verifier->code;
+    const u8*   bytes = code->bytes;
+    u32         byte_count = code->byte_count;
+    u32         pc = verifier->pc;
+    u32         i = pc + 1;
+    u8          op_code = bytes[pc];
+    if (VERIFY_SIGNATURES[op_code] != NULL) {
+        set_signature(verifier, VERIFY_SIGNATURES[op_code]);
+        return;
+    }
+    if ((OP_ILOAD <= op_code) && (op_code <= OP_ALOAD)) {
+        set_load(verifier, (u32)(op_code - OP_ILOAD), bytes[i]);
+        return;
+    }
+    if ((OP_ILOAD_0 <= op_code) && (op_code <= OP_ALOAD_3)) {
+        u32 n = (u32)(op_code - OP_ILOAD_0);
+        set_load(verifier, n / 4, n % 4);
+        return;
+    }
+    if ((OP_ISTORE <= op_code) && (op_code <= OP_ASTORE)) {
+        set_store(verifier, (u32)(op_code - OP_ISTORE), bytes[i]);
+        return;
+    }
+    if ((OP_ISTORE_0 <= op_code) && (op_code <= OP_ASTORE_3)) {
+        u32 n = (u32)(op_code - OP_ISTORE_0);
+        set_store(verifier, n / 4, n % 4);
+        return;
+    }
+    switch (op_code) {
+    case OP_LDC: {
+        set_ldc(verifier, bytes[i], FALSE);
+        break;
+    }
+    case OP_LDC_W:
+    case OP_LDC2_W: {
+        set_ldc(verifier,
+                pop_u16_at(memory, bytes, &i, byte_count),
+                op_code == OP_LDC2_W);
+        break;
+    }
+    case OP_POP: {
+        set_stack_op(verifier, 1, 0, FALSE);
+        break;
+    }
+    case OP_POP2: {
+        set_stack_op(verifier, 2, 0, FALSE);
+        break;
+    }
+    case OP_DUP: {
+        set_stack_op(verifier, 1, 0, TRUE);
+        break;
+    }
+    case OP_DUP_X1: {
+        set_stack_op(verifier, 1, 1, TRUE);
+        break;
+    }
+    case OP_DUP_X2: {
+        set_stack_op(verifier, 1, 2, TRUE);
+        break;
+    }
+    case OP_DUP2: {
+        set_stack_op(verifier, 2, 0, TRUE);
+        break;
+    }
+    case OP_DUP2_X1: {
+        set_stack_op(verifier, 2, 1, TRUE);
+        break;
+    }
+    case OP_DUP2_X2: {
+        set_stack_op(verifier, 2, 2, TRUE);
+        break;
+    }
+    case OP_SWAP: {
+        set_stack_op(verifier, 1, 1, FALSE);
+        break;
+    }
+    case OP_IINC: {
+        get_local(verifier, bytes[i], get_type(VERI_INTEGER, 0));
+        break;
+    }
+    case OP_IRETURN: {
+        set_return(verifier, VERI_INTEGER);
+        break;
+    }
+    case OP_LRETURN: {
+        set_return(verifier, VERI_LONG);
+        break;
+    }
+    case OP_FRETURN: {
+        set_return(verifier, VERI_FLOAT);
+        break;
+    }
+    case OP_DRETURN: {
+        set_return(verifier, VERI_DOUBLE);
+        break;
+    }
+    case OP_ARETURN: {
+        set_return(verifier, VERI_OBJECT);
+        break;
+    }
+    case OP_RETURN: {
+        set_return(verifier, VERI_TOP);
+        break;
+    }
+    case OP_GETSTATIC:
+    case OP_PUTSTATIC:
+    case OP_GETFIELD:
+    case OP_PUTFIELD: {
+        set_field(verifier,
+                  op_code,
+                  pop_u16_at(memory, bytes, &i, byte_count));
+        break;
+    }
+    case OP_INVOKEVIRTUAL:
+    case OP_INVOKESPECIAL:
+    case OP_INVOKESTATIC:
+    case OP_INVOKEINTERFACE:
+    case OP_INVOKEDYNAMIC: {
+        set_invoke(verifier,
+                   op_code,
+                   pop_u16_at(memory, bytes, &i, byte_count));
+        break;
+    }
+    case OP_NEW: {
+        if (get_constant_tag(verifier->memory,
+                             pop_u16_at(memory, bytes, &i, byte_count)) !=
+            CONSTANT_TAG_CLASS)
+        {
+            set_verify_error(verifier, PARSE_BAD_TYPE);
+        }
+        push_type(verifier, get_type(VERI_UNINIT, (u16)pc));
+        break;
+    }
+    case OP_CHECKCAST: {
+        u16 index = pop_u16_at(memory, bytes, &i, byte_count);
+        pop_reference(verifier, TRUE);
+        if (get_constant_tag(verifier->memory, index) != CONSTANT_TAG_CLASS)
+        {
+            set_verify_error(verifier, PARSE_BAD_TYPE);
+        }
+        push_type(verifier, get_type(VERI_OBJECT, index));
+        break;
+    }
+    case OP_MULTIANEWARRAY: {
+        u16 index = pop_u16_at(memory, bytes, &i, byte_count);
+        u8  dimension_count = pop_u8_at(memory, bytes, &i, byte_count);
+        if ((dimension_count == 0) ||
+            (get_constant_tag(verifier->memory, index) != CONSTANT_TAG_CLASS))
+        {
+            set_verify_error(verifier, PARSE_BAD_TYPE);
+        }
+        for (u8 j = 0; j < dimension_count; ++j) {
+            pop_type(verifier, get_type(VERI_INTEGER, 0));
+        }
+        push_type(verifier, get_type(VERI_OBJECT, index));
+        break;
+    }
+    case OP_WIDE: {
+        u8  wide_op_code = pop_u8_at(memory, bytes, &i, byte_count);
+        u16 index = pop_u16_at(memory, bytes, &i, byte_count);
+        if (wide_op_code == OP_IINC) {
+            get_local(verifier, index, get_type(VERI_INTEGER, 0));
+        } else if ((OP_ILOAD <= wide_op_code) && (wide_op_code <= OP_ALOAD)) {
+            set_load(verifier, (u32)(wide_op_code - OP_ILOAD), index);
+        } else if ((OP_ISTORE <= wide_op_code) &&
+                   (wide_op_code <= OP_ASTORE))
+        {
+            set_store(verifier, (u32)(wide_op_code - OP_ISTORE), index);
+        } else {
+            set_verify_error(verifier, PARSE_BAD_INSTRUCTION);
+        }
+        break;
+    }
+    default: {
+        set_verify_error(verifier, PARSE_BAD_INSTRUCTION);
+    }
+    }
+}
+
+/* NOTE: One pass in pc order, the way the JVM's split verifier works:
+ * each instruction is checked against the frame before it, and a stack
+ * map frame, where there is one, replaces that frame. Code after an
+ * unconditional jump must have a frame, and every branch and handler
+ * target is checked against its frame without ever being revisited. */
+void set_verify(Verifier* verifier) {
+    const Code* code = verifier->code;
+    const Cfg*  cfg = &verifier->cfg;
+    Bool        falls_through = TRUE;
+    u16         frame_count = 0;
+    for (u32 pc = 0; pc < code->byte_count;) {
+        verifier->pc = pc;
+        u32 frame_index = verifier->frame_indices[pc];
+        if (frame_index != 0) {
+            const Frame* frame = &verifier->frames[frame_index - 1];
+            if (falls_through && !is_frame_assignable(verifier, frame)) {
+                set_verify_error(verifier, PARSE_BAD_FRAME);
+            }
+            set_frame(verifier, &verifier->frame, frame);
+            ++frame_count;
+        } else if (!falls_through) {
+            set_verify_error(verifier, PARSE_BAD_FRAME);
+        }
+        set_handler_frames(verifier);
+        set_instruction(verifier);
+        falls_through = is_fall_through_op_code(code->bytes[pc]);
+        u32 next_pc =
+            pc + get_op_code_size(code->bytes, pc, code->byte_count);
+        if ((next_pc == code->byte_count) ||
+            (cfg->block_indices[next_pc] != cfg->block_indices[pc]))
+        {
+            const Block* block = &cfg->blocks[cfg->block_indices[pc]];
+            for (u32 i = 0; i < block->edge_count; ++i) {
+                const Edge* edge = &cfg->edges[block->edge_index + i];
+                if (edge->tag == EDGE_BRANCH) {
+                    set_branch_frame(verifier,
+                                     cfg->blocks[edge->block_index].pc_start);
+                }
+            }
+        }
+        pc = next_pc;
+    }
+    /* NOTE: A frame that never lined up with an instruction start. */
+    if (frame_count != verifier->frame_count) {
+        verifier->pc = code->byte_count;
+        set_verify_error(verifier, PARSE_BAD_FRAME);
+    }
+}
+
+Bool is_type_checked(const Memory* memory) {
+    return MIN_TYPE_CHECKED_VERSION <= memory->major_version;
+}
+
+/* NOTE: The method is still decoded when its class is too old to check,
+ * so malformed bodies are reported either way. */
+ParseError parse_verify(Memory* memory, Verifier* verifier, Method* method) {
+    jmp_buf on_error;
+    u32     byte_index = memory->byte_index;
+    verifier->memory = memory;
+    verifier->method = method;
+    verifier->code = NULL;
+    verifier->pc = 0;
+    memory->error.code = PARSE_OK;
+    memory->error.offset = 0;
+    memory->on_error = &on_error;
+#ifdef STATS
+    u32 stats_depth = memory->stats.depth;
+#endif
+    if (setjmp(on_error) == 0) {
+        set_method_attributes(memory, method);
+        verifier->code = get_method_code(memory, method);
+        if ((verifier->code != NULL) && is_type_checked(memory)) {
+            set_cfg(memory, &verifier->cfg, verifier->code);
+            set_initial_frame(verifier);
+            set_stack_map_frames(verifier);
+            set_verify(verifier);
+        }
+    }
+#ifdef STATS
+    unwind_stats(&memory->stats, stats_depth);
+#endif
+    memory->on_error = NULL;
+    memory->byte_index = byte_index;
+    return memory->error;
+}
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef __VERIFY_H__
+#define __VERIFY_H__
+
+#include "cfg.c"
+
+#define COUNT_LOAD_KINDS 5
+
+/* NOTE: Class files before version 50 carry no stack maps and are verified
+ * by type inference, which is not done here. */
+#define MIN_TYPE_CHECKED_VERSION 50
+
+/* NOTE: Long and double take two slots, the second one `Top`, the same
+ * way the JVM lays them out. */
+typedef struct {
+    VerificationType* locals;
+    VerificationType* stack;
+    u16               local_size;
+    u16               stack_size;
+} Frame;
+
+/* NOTE: `frame_indices` maps a pc to its stack map frame plus one, or zero
+ * if it has none. A `Top` return type stands for `void`. */
+typedef struct {
+    Memory*          memory;
+    const Method*    method;
+    const Code*      code;
+    Cfg              cfg;
+    Frame*           frames;
+    u16              frame_count;
+    u32*             frame_indices;
+    Frame            frame;
+    VerificationType return_type;
+    u32              pc;
+    Bool             is_init;
+} Verifier;
+
+_Noreturn void set_verify_error(Verifier*, ParseErrorCode);
+Bool           is_type_checked(const Memory*);
+
+VerificationType get_type(VerificationTypeTag, u16);
+Bool             is_wide_type(VerificationType);
+Bool             is_reference_type(VerificationType);
+Bool             is_same_type(VerificationType, VerificationType);
+Bool             is_assignable(VerificationType, VerificationType);
+Bool             is_frame_assignable(Verifier*, const Frame*);
+Bool             is_handler_assignable(Verifier*, const Frame*, u16);
+
+VerificationType get_frame_item(Verifier*, VerificationType);
+
+void alloc_frame(Verifier*, Frame*);
+void set_frame(Verifier*, Frame*, const Frame*);
+void push_frame_local(Verifier*, Frame*, VerificationType);
+void push_frame_stack(Verifier*, Frame*, VerificationType);
+
+VerificationType get_signature_type(char);
+VerificationType get_descriptor_type(Verifier*, ConstantUtf8, u32*);
+VerificationType get_field_type(Verifier*, u16);
+u32 get_descriptor_size(Verifier*, ConstantUtf8, VerificationType*);
+
+void             push_type(Verifier*, VerificationType);
+VerificationType pop_type(Verifier*, VerificationType);
+VerificationType pop_reference(Verifier*, Bool);
+void             set_local(Verifier*, u32, VerificationType);
+VerificationType get_local(Verifier*, u32, VerificationType);
+
+void set_initial_frame(Verifier*);
+void set_stack_map_frames(Verifier*);
+void set_branch_frame(Verifier*, u32);
+void set_handler_frames(Verifier*);
+
+void set_signature(Verifier*, const char*);
+void set_load(Verifier*, u32, u32);
+void set_store(Verifier*, u32, u32);
+void set_stack_op(Verifier*, u32, u32, Bool);
+void set_return(Verifier*, VerificationTypeTag);
+void set_ldc(Verifier*, u16, Bool);
+void set_field(Verifier*, OpCode, u16);
+void set_init(Verifier*, VerificationType);
+void set_invoke(Verifier*, OpCode, u16);
+void set_instruction(Verifier*);
+void set_verify(Verifier*);
+
+ParseError parse_verify(Memory*, Verifier*, Method*);
+
+#endif
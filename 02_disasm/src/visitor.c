@@ -0,0 +1,184 @@
+#ifndef __VISITOR_C__
+#define __VISITOR_C__
+
+#include "visitor.h"
+
+/* NOTE: A single forward pass that hands each piece to the visitor as it
+ * is read. Nothing is materialized except the constant pool slots and
+ * attribute tag tables, which are bounded by the pool size and let hooks
+ * resolve names through `get_utf8`; no tokens, attribute lists or method
+ * bodies are allocated. Attributes are delivered as raw views and skipped
+ * by their `u32 AttributeSize`, so unknown ones cost nothing. */
+
+void visit_instructions(Memory*        memory,
+                        const Visitor* visitor,
+                        const u8*      bytes,
+                        u32            byte_count) {
+    for (u32 pc = 0; pc < byte_count;) {
+        u32 size = get_op_code_size(bytes, pc, byte_count);
+        if (size == 0) {
+            memory->byte_index = (u32)(bytes - memory->bytes) + pc;
+            set_parse_error(memory, PARSE_BAD_INSTRUCTION);
+        }
+        Instruction instruction = {
+            .bytes = &bytes[pc],
+            .pc = pc,
+            .size = size,
+            .op_code = bytes[pc],
+        };
+        STATS_COUNT_OP_CODE(memory, bytes[pc]);
+        visitor->on_instruction(visitor->context, &instruction);
+        pc += size;
+    }
+}
+
+void visit_attributes(Memory*        memory,
+                      const Visitor* visitor,
+                      u16            count,
+                      Bool           in_code) {
+    for (u16 i = 0; i < count; ++i) {
+        Cursor cursor = pop_cursor(memory, 6);
+        u16    name_index = pop_cursor_u16(&cursor);
+        u32    size = pop_cursor_u32(&cursor);
+        if (memory->constant_count <= name_index) {
+            set_parse_error(memory, PARSE_BAD_CONSTANT_INDEX);
+        }
+        if ((memory->file_size - memory->byte_index) < size) {
+            set_parse_error(memory, PARSE_OUT_OF_BOUNDS);
+        }
+        u32           end = memory->byte_index + size;
+        AttributeView attribute = {
+            .bytes = &memory->bytes[memory->byte_index],
+            .size = size,
+            .name_index = name_index,
+            .tag = get_masked_attribute_tag(memory, name_index),
+            .in_code = in_code,
+        };
+        STATS_COUNT_ATTRIBUTE(memory, attribute.tag);
+        if (visitor->on_attribute != NULL) {
+            visitor->on_attribute(visitor->context, &attribute);
+        }
+        if ((attribute.tag == ATTRIB_CODE) && !in_code) {
+            /* NOTE: Stack, locals, code size and the two counts. */
+            if (size < 12) {
+                set_parse_error(memory, PARSE_OUT_OF_BOUNDS);
+            }
+            memory->byte_index += 4;
+            u32 byte_count = pop_u32(memory);
+            if ((end - memory->byte_index) < byte_count) {
+                set_parse_error(memory, PARSE_OUT_OF_BOUNDS);
+            }
+            const u8* bytes = &memory->bytes[memory->byte_index];
+            if (visitor->on_instruction != NULL) {
+                visit_instructions(memory, visitor, bytes, byte_count);
+            }
+            memory->byte_index += byte_count;
+            u16 exception_table_count = pop_u16(memory);
+            memory->byte_index += (u32)exception_table_count * 8;
+            if (end < memory->byte_index) {
+                set_parse_error(memory, PARSE_OUT_OF_BOUNDS);
+            }
+            visit_attributes(memory, visitor, pop_u16(memory), TRUE);
+            if (memory->byte_index != end) {
+                set_parse_error(memory, PARSE_BAD_METHOD_RANGE);
+            }
+        }
+        memory->byte_index = end;
+    }
+}
+
+/* NOTE: Fields and methods share a layout; only methods are reported. */
+void visit_members(Memory* memory, const Visitor* visitor, Bool methods) {
+    u16 count = pop_u16(memory);
+    for (u16 i = 0; i < count; ++i) {
+        Method method = {0};
+        Cursor cursor = pop_cursor(memory, 8);
+        method.access_flags = pop_cursor_u16(&cursor);
+        method.name_index = pop_cursor_u16(&cursor);
+        method.descriptor_index = pop_cursor_u16(&cursor);
+        method.attribute_count = pop_cursor_u16(&cursor);
+        method.offset = memory->byte_index;
+        if (!methods) {
+            skip_attributes(memory, method.attribute_count);
+            continue;
+        }
+        if (visitor->on_method != NULL) {
+            visitor->on_method(visitor->context, &method);
+        }
+        visit_attributes(memory, visitor, method.attribute_count, FALSE);
+    }
+}
+
+void set_visit(Memory* memory, const Visitor* visitor) {
+    reset_arena(&memory->arena);
+    memory->byte_index = 0;
+    memory->first_token_block = NULL;
+    memory->last_token_block = NULL;
+    memory->token_count = 0;
+    memory->this_class = 0;
+    memory->methods = NULL;
+    memory->method_count = 0;
+    memory->attribute_count = 1;
+    if (pop_u32(memory) != 0xCAFEBABE) {
+        set_parse_error(memory, PARSE_BAD_MAGIC);
+    }
+    memory->byte_index += 4;
+    u16 constant_pool_count = pop_u16(memory);
+    set_constant_pool(memory, constant_pool_count);
+    STATS_PUSH(memory, STATS_CONSTANT_POOL);
+    for (u16 i = 1; i < constant_pool_count; ++i) {
+        ConstantTag tag = set_constant(memory, i);
+        if (visitor->on_constant != NULL) {
+            Constant constant = get_constant(memory, i);
+            visitor->on_constant(visitor->context, &constant);
+        }
+        if (is_wide_constant(tag)) {
+            ++i;
+        }
+    }
+    STATS_POP(memory, STATS_CONSTANT_POOL);
+    ClassHeader header;
+    header.access_flags = pop_u16(memory);
+    header.this_class = pop_u16(memory);
+    header.super_class = pop_u16(memory);
+    memory->this_class = header.this_class;
+    if (visitor->on_class != NULL) {
+        visitor->on_class(visitor->context, &header);
+    }
+    u16 interface_count = pop_u16(memory);
+    for (u16 i = 0; i < interface_count; ++i) {
+        pop_u16(memory);
+    }
+    STATS_PUSH(memory, STATS_METHODS);
+    visit_members(memory, visitor, FALSE);
+    visit_members(memory, visitor, TRUE);
+    STATS_POP(memory, STATS_METHODS);
+    STATS_PUSH(memory, STATS_ATTRIBUTES);
+    visit_attributes(memory, visitor, pop_u16(memory), FALSE);
+    STATS_POP(memory, STATS_ATTRIBUTES);
+}
+
+ParseError visit_class(Memory*        memory,
+                       const u8*      bytes,
+                       u32            size,
+                       const Visitor* visitor) {
+    jmp_buf on_error;
+    memory->bytes = bytes;
+    memory->file_size = size;
+    memory->error.code = PARSE_OK;
+    memory->error.offset = 0;
+    memory->on_error = &on_error;
+#ifdef STATS
+    u32 stats_depth = memory->stats.depth;
+#endif
+    if (setjmp(on_error) == 0) {
+        set_visit(memory, visitor);
+    }
+#ifdef STATS
+    unwind_stats(&memory->stats, stats_depth);
+#endif
+    memory->on_error = NULL;
+    return memory->error;
+}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef __VISITOR_H__
+#define __VISITOR_H__
+
+#include "op_codes.c"
+
+typedef struct {
+    u16 access_flags;
+    u16 this_class;
+    u16 super_class;
+} ClassHeader;
+
+typedef struct {
+    const u8*    bytes;
+    u32          size;
+    u16          name_index;
+    AttributeTag tag;
+    Bool         in_code;
+} AttributeView;
+
+typedef struct {
+    const u8* bytes;
+    u32       pc;
+    u32       size;
+    OpCode    op_code;
+} Instruction;
+
+/* NOTE: Every hook is optional and receives `context` first. Pointers
+ * handed to a hook are only valid for the duration of that call. */
+typedef struct {
+    void* context;
+    void (*on_constant)(void*, const Constant*);
+    void (*on_class)(void*, const ClassHeader*);
+    void (*on_method)(void*, const Method*);
+    void (*on_attribute)(void*, const AttributeView*);
+    void (*on_instruction)(void*, const Instruction*);
+} Visitor;
+
+void       visit_instructions(Memory*, const Visitor*, const u8*, u32);
+void       visit_attributes(Memory*, const Visitor*, u16, Bool);
+void       visit_members(Memory*, const Visitor*, Bool);
+void       set_visit(Memory*, const Visitor*);
+ParseError visit_class(Memory*, const u8*, u32, const Visitor*);
+
+#endif
@@ -0,0 +1,417 @@
+#ifndef __WATCH_C__
+#define __WATCH_C__
+
+#include "watch.h"
+
+char* get_watch_path(const char* directory, const char* name) {
+    size_t size = strlen(directory) + strlen(name) + 2;
+    char*  path = malloc(size);
+    if (path == NULL) {
+        fprintf(stderr, "[ERROR] `malloc` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    snprintf(path, size, "%s/%s", directory, name);
+    return path;
+}
+
+Bool set_watch_parents(char* path) {
+    for (char* x = &path[1]; *x != '\0'; ++x) {
+        if (*x != '/') {
+            continue;
+        }
+        *x = '\0';
+        if ((mkdir(path, 0755) < 0) && (errno != EEXIST)) {
+            fprintf(stderr, "[ERROR] Unable to create `%s`\n", path);
+            *x = '/';
+            return FALSE;
+        }
+        *x = '/';
+    }
+    return TRUE;
+}
+
+/* NOTE: The output tree mirrors the input paths as given, minus any
+ * leading `/`, `./` or `../`, so it never reaches outside `output_path`. */
+char* get_watch_output_path(const Watcher* watcher, const char* path) {
+    for (;;) {
+        if (path[0] == '/') {
+            path += 1;
+        } else if (strncmp(path, "./", 2) == 0) {
+            path += 2;
+        } else if (strncmp(path, "../", 3) == 0) {
+            path += 3;
+        } else {
+            break;
+        }
+    }
+    const char* suffix = watcher->view.tag == VIEW_JSON ? ".ndjson" : ".txt";
+    size_t      size =
+        strlen(watcher->output_path) + strlen(path) + strlen(suffix) + 2;
+    char* output_path = malloc(size);
+    if (output_path == NULL) {
+        fprintf(stderr, "[ERROR] `malloc` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    snprintf(output_path,
+             size,
+             "%s/%s%s",
+             watcher->output_path,
+             path,
+             suffix);
+    return output_path;
+}
+
+WatchFile* get_watch_file(Watcher* watcher, const char* path) {
+    for (u32 i = 0; i < watcher->file_count; ++i) {
+        if (strcmp(watcher->files[i].path, path) == 0) {
+            return &watcher->files[i];
+        }
+    }
+    return NULL;
+}
+
+/* NOTE: Read rather than mapped: the assembler may truncate a file while we
+ * look at it, and a truncated mapping faults instead of failing. */
+Bool set_watch_bytes(Watcher* watcher, const char* path, u32* size) {
+    i32 file = open(path, O_RDONLY);
+    if (file < 0) {
+        return FALSE;
+    }
+    struct stat file_stat;
+    if ((fstat(file, &file_stat) < 0) ||
+        ((off_t)UINT32_MAX < file_stat.st_size))
+    {
+        close(file);
+        return FALSE;
+    }
+    *size = (u32)file_stat.st_size;
+    if (watcher->byte_capacity < *size) {
+        u8* bytes = realloc(watcher->bytes, *size);
+        if (bytes == NULL) {
+            fprintf(stderr, "[ERROR] `realloc` failed\n");
+            exit(EXIT_FAILURE);
+        }
+        watcher->bytes = bytes;
+        watcher->byte_capacity = *size;
+    }
+    for (u32 i = 0; i < *size;) {
+        ssize_t n = read(file, &watcher->bytes[i], *size - i);
+        if (n <= 0) {
+            *size = i;
+            break;
+        }
+        i += (u32)n;
+    }
+    close(file);
+    return TRUE;
+}
+
+/* NOTE: Same text as a batch job prints after its `[FILE]` line, written
+ * to a temporary file and renamed, so an editor watching the output never
+ * reloads half of it. A malformed class gets its `[ERROR]` line like any
+ * other output; an output that cannot be written is reported and skipped,
+ * and the watch goes on. */
+void set_watch_output(Watcher* watcher, const char* path, u32 size) {
+    Memory* memory = &watcher->memory;
+    memory->bytes = watcher->bytes;
+    memory->file_size = size;
+    Buffer output;
+    set_buffer(&output, -1);
+    ParseError error = print_class(&output, memory, watcher->view);
+    if (watcher->view.tag == VIEW_JSON) {
+        if (error.code != PARSE_OK) {
+            print_json_error(&output, error);
+        }
+    } else if (error.code != PARSE_OK) {
+        put_str(&output, "[ERROR] ");
+        put_str(&output, get_parse_error_name(error.code));
+        put_str(&output, " (byte ");
+        put_u32(&output, error.offset);
+        put_str(&output, ")\n");
+    } else {
+        put_str(&output, "\n[INFO] ");
+        put_u32(&output, memory->file_size - memory->byte_index);
+        put_str(&output, " bytes left!\n");
+    }
+    memory->bytes = NULL;
+    memory->file_size = 0;
+    char* output_path = get_watch_output_path(watcher, path);
+    if (!set_watch_parents(output_path)) {
+        free_buffer(&output);
+        free(output_path);
+        return;
+    }
+    size_t temp_size = strlen(output_path) + 2;
+    char*  temp_path = malloc(temp_size);
+    if (temp_path == NULL) {
+        fprintf(stderr, "[ERROR] `malloc` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    snprintf(temp_path, temp_size, "%s~", output_path);
+    i32 file = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (file < 0) {
+        fprintf(stderr, "[ERROR] Unable to open `%s`\n", temp_path);
+        free_buffer(&output);
+    } else {
+        output.file = file;
+        free_buffer(&output);
+        close(file);
+        if (rename(temp_path, output_path) < 0) {
+            fprintf(stderr, "[ERROR] Unable to rename `%s`\n", temp_path);
+            unlink(temp_path);
+        }
+    }
+    free(temp_path);
+    free(output_path);
+}
+
+/* NOTE: `stat` is the cheap first check; a changed mtime or size only
+ * costs a read and a hash, and the class is re-printed only if its bytes
+ * actually differ (a rebuild that emits the same class is free). */
+void set_watch_file(Watcher* watcher, const char* path) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    struct stat file_stat;
+    if (stat(path, &file_stat) < 0) {
+        unset_watch_file(watcher, path);
+        return;
+    }
+    WatchFile* file = get_watch_file(watcher, path);
+    if ((file != NULL) && (file->size == file_stat.st_size) &&
+        (file->mtime.tv_sec == file_stat.st_mtim.tv_sec) &&
+        (file->mtime.tv_nsec == file_stat.st_mtim.tv_nsec))
+    {
+        return;
+    }
+    u32 size;
+    if (!set_watch_bytes(watcher, path, &size)) {
+        return;
+    }
+    Hash128 hash = get_hash128(watcher->bytes, size, 0);
+    if (file == NULL) {
+        if (watcher->file_capacity <= watcher->file_count) {
+            u32 file_capacity = watcher->file_capacity == 0
+                                    ? COUNT_WATCH_ITEMS
+                                    : watcher->file_capacity * 2;
+            WatchFile* files =
+                realloc(watcher->files, sizeof(WatchFile) * file_capacity);
+            if (files == NULL) {
+                fprintf(stderr, "[ERROR] `realloc` failed\n");
+                exit(EXIT_FAILURE);
+            }
+            watcher->files = files;
+            watcher->file_capacity = file_capacity;
+        }
+        file = &watcher->files[watcher->file_count++];
+        file->path = strdup(path);
+        if (file->path == NULL) {
+            fprintf(stderr, "[ERROR] `strdup` failed\n");
+            exit(EXIT_FAILURE);
+        }
+    } else if ((file->hash.low == hash.low) && (file->hash.high == hash.high))
+    {
+        file->mtime = file_stat.st_mtim;
+        file->size = file_stat.st_size;
+        return;
+    }
+    file->mtime = file_stat.st_mtim;
+    file->size = file_stat.st_size;
+    file->hash = hash;
+    set_watch_output(watcher, path, size);
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    printf("[WATCH] %s (%ld us)\n",
+           path,
+           ((end.tv_sec - start.tv_sec) * 1000000) +
+               ((end.tv_nsec - start.tv_nsec) / 1000));
+    fflush(stdout);
+}
+
+void unset_watch_file(Watcher* watcher, const char* path) {
+    WatchFile* file = get_watch_file(watcher, path);
+    if (file == NULL) {
+        return;
+    }
+    char* output_path = get_watch_output_path(watcher, path);
+    unlink(output_path);
+    free(output_path);
+    printf("[WATCH] %s (removed)\n", path);
+    fflush(stdout);
+    free(file->path);
+    *file = watcher->files[--watcher->file_count];
+}
+
+/* NOTE: inotify does not recurse, so every directory gets its own watch.
+ * The watch is added before the directory is listed, so a file created
+ * in between shows up in one or the other (at worst both, which the mtime
+ * check makes harmless). */
+void push_watch_dir(Watcher* watcher, const char* path) {
+    i32 descriptor = inotify_add_watch(watcher->inotify, path, WATCH_EVENTS);
+    if (descriptor < 0) {
+        return;
+    }
+    Bool is_new = TRUE;
+    for (u32 i = 0; i < watcher->dir_count; ++i) {
+        if (watcher->dirs[i].descriptor == descriptor) {
+            is_new = FALSE;
+            break;
+        }
+    }
+    if (is_new) {
+        if (watcher->dir_capacity <= watcher->dir_count) {
+            u32 dir_capacity = watcher->dir_capacity == 0
+                                   ? COUNT_WATCH_ITEMS
+                                   : watcher->dir_capacity * 2;
+            WatchDir* dirs =
+                realloc(watcher->dirs, sizeof(WatchDir) * dir_capacity);
+            if (dirs == NULL) {
+                fprintf(stderr, "[ERROR] `realloc` failed\n");
+                exit(EXIT_FAILURE);
+            }
+            watcher->dirs = dirs;
+            watcher->dir_capacity = dir_capacity;
+        }
+        WatchDir* dir = &watcher->dirs[watcher->dir_count++];
+        dir->descriptor = descriptor;
+        dir->path = strdup(path);
+        if (dir->path == NULL) {
+            fprintf(stderr, "[ERROR] `strdup` failed\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    DIR* dir = opendir(path);
+    if (dir == NULL) {
+        return;
+    }
+    for (struct dirent* entry = readdir(dir); entry != NULL;
+         entry = readdir(dir))
+    {
+        if ((strcmp(entry->d_name, ".") == 0) ||
+            (strcmp(entry->d_name, "..") == 0))
+        {
+            continue;
+        }
+        char*       child = get_watch_path(path, entry->d_name);
+        struct stat child_stat;
+        if (lstat(child, &child_stat) == 0) {
+            if (S_ISDIR(child_stat.st_mode)) {
+                push_watch_dir(watcher, child);
+            } else if (S_ISREG(child_stat.st_mode) && is_class_file(child)) {
+                set_watch_file(watcher, child);
+            }
+        }
+        free(child);
+    }
+    closedir(dir);
+}
+
+void set_watch_event(Watcher* watcher, const struct inotify_event* event) {
+    if (event->mask & IN_Q_OVERFLOW) {
+        /* NOTE: Events were dropped; listing everything again catches up,
+         * and unchanged files stop at the `stat`. */
+        u32 dir_count = watcher->dir_count;
+        for (u32 i = 0; i < dir_count; ++i) {
+            char* path = strdup(watcher->dirs[i].path);
+            if (path == NULL) {
+                fprintf(stderr, "[ERROR] `strdup` failed\n");
+                exit(EXIT_FAILURE);
+            }
+            push_watch_dir(watcher, path);
+            free(path);
+        }
+        return;
+    }
+    if (event->len == 0) {
+        return;
+    }
+    const WatchDir* dir = NULL;
+    for (u32 i = 0; i < watcher->dir_count; ++i) {
+        if (watcher->dirs[i].descriptor == event->wd) {
+            dir = &watcher->dirs[i];
+            break;
+        }
+    }
+    if (dir == NULL) {
+        return;
+    }
+    char* path = get_watch_path(dir->path, event->name);
+    if (event->mask & IN_ISDIR) {
+        if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+            push_watch_dir(watcher, path);
+        } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+            size_t size = strlen(path);
+            for (u32 i = watcher->file_count; 0 < i; --i) {
+                const char* file_path = watcher->files[i - 1].path;
+                if ((strncmp(file_path, path, size) == 0) &&
+                    (file_path[size] == '/'))
+                {
+                    char* copy = strdup(file_path);
+                    if (copy == NULL) {
+                        fprintf(stderr, "[ERROR] `strdup` failed\n");
+                        exit(EXIT_FAILURE);
+                    }
+                    unset_watch_file(watcher, copy);
+                    free(copy);
+                }
+            }
+        }
+    } else if (is_class_file(path)) {
+        if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+            unset_watch_file(watcher, path);
+        } else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+            set_watch_file(watcher, path);
+        }
+    }
+    free(path);
+}
+
+/* NOTE: Runs until killed. Every class under `paths` is printed once up
+ * front; after that only the files inotify reports are looked at. */
+void run_watch(const char* output_path,
+               const char** paths,
+               u32          path_count,
+               View         view) {
+    Watcher* watcher = calloc(1, sizeof(Watcher));
+    if (watcher == NULL) {
+        fprintf(stderr, "[ERROR] `calloc` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    watcher->view = view;
+    watcher->output_path = output_path;
+    watcher->memory.lazy_methods = view.tag != VIEW_TOKENS;
+    watcher->memory.attribute_skip_mask = view.attribute_skip_mask;
+    watcher->inotify = inotify_init1(IN_CLOEXEC);
+    if (watcher->inotify < 0) {
+        fprintf(stderr, "[ERROR] `inotify_init1` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    if ((mkdir(output_path, 0755) < 0) && (errno != EEXIST)) {
+        fprintf(stderr, "[ERROR] Unable to create `%s`\n", output_path);
+        exit(EXIT_FAILURE);
+    }
+    for (u32 i = 0; i < path_count; ++i) {
+        push_watch_dir(watcher, paths[i]);
+    }
+    printf("[INFO] Watching %u directories, %u class files\n",
+           watcher->dir_count,
+           watcher->file_count);
+    fflush(stdout);
+    _Alignas(struct inotify_event) char events[SIZE_WATCH_EVENTS];
+    for (;;) {
+        ssize_t size = read(watcher->inotify, events, sizeof(events));
+        if ((size < 0) && (errno == EINTR)) {
+            continue;
+        }
+        if (size <= 0) {
+            fprintf(stderr, "[ERROR] `read` failed\n");
+            exit(EXIT_FAILURE);
+        }
+        for (ssize_t i = 0; i < size;) {
+            const struct inotify_event* event = (const void*)&events[i];
+            set_watch_event(watcher, event);
+            i += (ssize_t)(sizeof(struct inotify_event) + event->len);
+        }
+    }
+}
+
+#endif
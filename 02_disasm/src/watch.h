@@ -0,0 +1,56 @@
+#ifndef __WATCH_H__
+#define __WATCH_H__
+
+#include <sys/inotify.h>
+#include <time.h>
+
+#include "index.c"
+
+#define COUNT_WATCH_ITEMS 64
+#define SIZE_WATCH_EVENTS (1 << 16)
+
+#define WATCH_EVENTS                                                \
+    (IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | \
+     IN_DELETE | IN_DELETE_SELF)
+
+typedef struct {
+    char*           path;
+    struct timespec mtime;
+    off_t           size;
+    Hash128         hash;
+} WatchFile;
+
+typedef struct {
+    char* path;
+    i32   descriptor;
+} WatchDir;
+
+typedef struct {
+    Memory      memory;
+    View        view;
+    const char* output_path;
+    i32         inotify;
+    WatchFile*  files;
+    u32         file_count;
+    u32         file_capacity;
+    WatchDir*   dirs;
+    u32         dir_count;
+    u32         dir_capacity;
+    u8*         bytes;
+    u32         byte_capacity;
+} Watcher;
+
+char* get_watch_path(const char*, const char*);
+Bool  set_watch_parents(char*);
+char* get_watch_output_path(const Watcher*, const char*);
+
+WatchFile* get_watch_file(Watcher*, const char*);
+Bool       set_watch_bytes(Watcher*, const char*, u32*);
+void       set_watch_output(Watcher*, const char*, u32);
+void       set_watch_file(Watcher*, const char*);
+void       unset_watch_file(Watcher*, const char*);
+void       push_watch_dir(Watcher*, const char*);
+void       set_watch_event(Watcher*, const struct inotify_event*);
+void       run_watch(const char*, const char**, u32, View);
+
+#endif
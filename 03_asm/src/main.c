@@ -1,4 +1,4 @@
-#include "memory.c"
+#include "report.c"
 
 i32 main(i32 n, const char** args) {
     printf("sizeof(Token)    : %zu\n"
@@ -16,16 +16,43 @@ i32 main(i32 n, const char** args) {
            sizeof(Method),
            sizeof(Program),
            sizeof(Memory));
-    if (n < 3) {
+    StatsReport report = {0};
+    i32         i = 1;
+    for (; i < n; ++i) {
+        if (get_eq(args[i], "--stats")) {
+            report.text = TRUE;
+        } else if (get_eq(args[i], "--stats-trace")) {
+            if (n <= (i + 1)) {
+                ERROR("No trace file provided");
+            }
+            report.trace_path = args[++i];
+        } else {
+            break;
+        }
+    }
+    if (n < (i + 2)) {
         ERROR("Missing arguments");
     }
+    set_stats_report(&report);
     Memory* memory = calloc(1, sizeof(Memory));
-    set_file_to_chars(memory, args[1]);
+    STATS_PUSH(memory, STATS_LOAD);
+    set_file_to_chars(memory, args[i]);
+    STATS_POP(memory, STATS_LOAD);
+    STATS_PUSH(memory, STATS_TOKENS);
     set_tokens(memory);
+    STATS_POP(memory, STATS_TOKENS);
     set_program(memory);
+    STATS_PUSH(memory, STATS_PRINT);
     print_program(&memory->program);
-    serialize_program_to_file(&memory->program, args[2]);
+    STATS_POP(memory, STATS_PRINT);
+    STATS_PUSH(memory, STATS_SERIALIZE);
+    serialize_program_to_file(&memory->program, args[i + 1]);
+    STATS_POP(memory, STATS_SERIALIZE);
     printf("Done!\n");
+#ifdef STATS
+    report.stats = memory->stats;
+#endif
+    print_stats_report(&report, memory);
     free(memory);
     return EXIT_SUCCESS;
 }
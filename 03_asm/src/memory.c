@@ -285,6 +285,7 @@ void set_constants(Memory* memory) {
         } else {
             UNEXPECTED_TOKEN(token.buffer, token.line);
         }
+        STATS_COUNT_CONSTANT(memory, constant->tag);
     }
     memory->program.constant_count = (u16)(memory->constant_count + 1);
 }
@@ -429,6 +430,7 @@ void set_method_code(Memory* memory, Method* method) {
             } else {
                 UNEXPECTED_TOKEN(token.buffer, token.line);
             }
+            STATS_COUNT_OP_CODE(memory, op->tag);
         } else if (token.tag == TOKEN_RBRACE) {
             break;
         } else {
@@ -449,6 +451,7 @@ void set_methods(Memory* memory) {
         EXPECTED_TOKEN(TOKEN_TYPE_INDEX, memory);
         method->type_index = (u16)get_unsigned(memory);
         set_method_code(memory, method);
+        STATS_COUNT_ATTRIBUTE(memory);
         EXPECTED_TOKEN(TOKEN_RBRACE, memory);
     }
     memory->program.method_count = memory->method_count;
@@ -466,7 +469,9 @@ void set_program(Memory* memory) {
     memory->program.major_version = (u16)get_unsigned(memory);
     EXPECTED_TOKEN(TOKEN_MINOR_VERSION, memory);
     memory->program.minor_version = (u16)get_unsigned(memory);
+    STATS_PUSH(memory, STATS_CONSTANT_POOL);
     set_constants(memory);
+    STATS_POP(memory, STATS_CONSTANT_POOL);
     set_access_flags(memory);
     EXPECTED_TOKEN(TOKEN_THIS_CLASS, memory);
     memory->program.this_class = (u16)get_unsigned(memory);
@@ -474,8 +479,12 @@ void set_program(Memory* memory) {
     memory->program.super_class = (u16)get_unsigned(memory);
     set_interfaces(memory);
     set_fields(memory);
+    STATS_PUSH(memory, STATS_METHODS);
     set_methods(memory);
+    STATS_POP(memory, STATS_METHODS);
+    STATS_PUSH(memory, STATS_ATTRIBUTES);
     set_attributes(memory);
+    STATS_POP(memory, STATS_ATTRIBUTES);
 }
 
 #endif
@@ -2,6 +2,7 @@
 #define __MEMORY_H__
 
 #include "program.c"
+#include "stats.c"
 #include "tokens.c"
 
 #define SIZE_FILE       4096
@@ -26,6 +27,9 @@ typedef struct {
     Method   methods[COUNT_METHODS];
     u16      op_count;
     Op       ops[COUNT_OPS];
+#ifdef STATS
+    Stats stats;
+#endif
 } Memory;
 
 void set_file_to_chars(Memory*, const char*);
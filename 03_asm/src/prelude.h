@@ -10,6 +10,7 @@ typedef FILE File;
 typedef uint8_t  u8;
 typedef uint16_t u16;
 typedef uint32_t u32;
+typedef uint64_t u64;
 
 typedef int8_t  i8;
 typedef int16_t i16;
@@ -0,0 +1,315 @@
+#ifndef __REPORT_C__
+#define __REPORT_C__
+
+#include "report.h"
+
+const char* get_stats_phase_name(StatsPhase phase) {
+    switch (phase) {
+    case STATS_LOAD: {
+        return "load";
+    }
+    case STATS_TOKENS: {
+        return "tokens";
+    }
+    case STATS_CONSTANT_POOL: {
+        return "constant pool";
+    }
+    case STATS_METHODS: {
+        return "methods";
+    }
+    case STATS_ATTRIBUTES: {
+        return "attributes";
+    }
+    case STATS_PRINT: {
+        return "print";
+    }
+    case STATS_SERIALIZE: {
+        return "serialize";
+    }
+    case COUNT_STATS_PHASES: {
+        break;
+    }
+    }
+    return NULL;
+}
+
+const char* get_stats_constant_tag_name(ConstantTag tag) {
+    switch (tag) {
+    case CONST_CLASS: {
+        return "Class";
+    }
+    case CONST_FIELD_REF: {
+        return "FieldRef";
+    }
+    case CONST_METHOD_REF: {
+        return "MethodRef";
+    }
+    case CONST_NAME_AND_TYPE: {
+        return "NameAndType";
+    }
+    case CONST_STRING: {
+        return "String";
+    }
+    case CONST_UTF8: {
+        return "Utf8";
+    }
+    }
+    return "?";
+}
+
+const char* get_stats_op_name(OpTag tag) {
+    switch (tag) {
+    case OP_ICONST_0: {
+        return "iconst_0";
+    }
+    case OP_ICONST_1: {
+        return "iconst_1";
+    }
+    case OP_ICONST_2: {
+        return "iconst_2";
+    }
+    case OP_BIPUSH: {
+        return "bipush";
+    }
+    case OP_LDC: {
+        return "ldc";
+    }
+    case OP_ILOAD: {
+        return "iload";
+    }
+    case OP_ILOAD_0: {
+        return "iload_0";
+    }
+    case OP_ILOAD_1: {
+        return "iload_1";
+    }
+    case OP_ILOAD_2: {
+        return "iload_2";
+    }
+    case OP_ILOAD_3: {
+        return "iload_3";
+    }
+    case OP_ISTORE: {
+        return "istore";
+    }
+    case OP_ISTORE_1: {
+        return "istore_1";
+    }
+    case OP_ISTORE_2: {
+        return "istore_2";
+    }
+    case OP_ISTORE_3: {
+        return "istore_3";
+    }
+    case OP_IADD: {
+        return "iadd";
+    }
+    case OP_IINC: {
+        return "iinc";
+    }
+    case OP_IFNE: {
+        return "ifne";
+    }
+    case OP_IF_ICMPNE: {
+        return "if_icmpne";
+    }
+    case OP_IF_ICMPGE: {
+        return "if_icmpge";
+    }
+    case OP_GOTO: {
+        return "goto";
+    }
+    case OP_IRETURN: {
+        return "ireturn";
+    }
+    case OP_RETURN: {
+        return "return";
+    }
+    case OP_GETSTATIC: {
+        return "getstatic";
+    }
+    case OP_INVOKEVIRTUAL: {
+        return "invokevirtual";
+    }
+    case OP_INVOKESTATIC: {
+        return "invokestatic";
+    }
+    }
+    return "?";
+}
+
+double get_stats_cycles_per_us(const StatsReport* report) {
+    StatsClock end = get_stats_clock();
+    u64        nanoseconds = end.nanoseconds - report->start.nanoseconds;
+    if (nanoseconds == 0) {
+        return 1;
+    }
+    return ((double)(end.cycles - report->start.cycles) * (double)1000) /
+           (double)nanoseconds;
+}
+
+void set_stats_report(StatsReport* report) {
+    if (!report->text && (report->trace_path == NULL)) {
+        return;
+    }
+#ifndef STATS
+    ERROR("Built without `-DSTATS`");
+#endif
+    report->start = get_stats_clock();
+}
+
+/* NOTE: `Memory` is a set of fixed pools that only ever grow during a run,
+ * so their final size is their peak. */
+void print_stats(File* file, const StatsReport* report, const Memory* memory) {
+    const Stats* stats = &report->stats;
+    double       cycles_per_us = get_stats_cycles_per_us(report);
+    u64          total = 0;
+    for (u32 i = 0; i < COUNT_STATS_PHASES; ++i) {
+        total += stats->phase_cycles[i];
+    }
+    fprintf(file,
+            "[STATS] %.0f cycles/us\n"
+            "  %-18s %10s %14s %10s %6s\n",
+            cycles_per_us,
+            "Phase",
+            "Count",
+            "Cycles",
+            "ms",
+            "Share");
+    for (u32 i = 0; i < COUNT_STATS_PHASES; ++i) {
+        fprintf(file,
+                "  %-18s %10lu %14lu %10.3f %5.1f%%\n",
+                get_stats_phase_name((StatsPhase)i),
+                stats->phase_counts[i],
+                stats->phase_cycles[i],
+                (double)stats->phase_cycles[i] /
+                    (cycles_per_us * (double)1000),
+                total == 0 ? (double)0
+                           : ((double)stats->phase_cycles[i] * (double)100) /
+                                 (double)total);
+    }
+    fprintf(file, "[STATS] Constant tags\n");
+    for (u32 i = 0; i < COUNT_STATS_CONSTANT_TAGS; ++i) {
+        if (stats->constant_tag_counts[i] != 0) {
+            fprintf(file,
+                    "  %-18s %10lu\n",
+                    get_stats_constant_tag_name((ConstantTag)i),
+                    stats->constant_tag_counts[i]);
+        }
+    }
+    fprintf(file,
+            "[STATS] Attribute tags\n"
+            "  %-18s %10lu\n",
+            "Code",
+            stats->code_attribute_count);
+    fprintf(file, "[STATS] Op codes\n");
+    for (u32 i = 0; i < COUNT_STATS_OP_CODES; ++i) {
+        if (stats->op_code_counts[i] != 0) {
+            fprintf(file,
+                    "  %-18s %10lu\n",
+                    get_stats_op_name((OpTag)i),
+                    stats->op_code_counts[i]);
+        }
+    }
+    fprintf(file,
+            "[STATS] Pools\n"
+            "  %-18s %10u of %d bytes\n"
+            "  %-18s %10u of %d bytes\n"
+            "  %-18s %10u of %d\n"
+            "  %-18s %10u of %d\n"
+            "  %-18s %10u of %d\n"
+            "  %-18s %10u of %d\n",
+            "file",
+            memory->file_size,
+            SIZE_FILE,
+            "buffer",
+            memory->buffer_size,
+            SIZE_BUFFER,
+            "tokens",
+            memory->token_count,
+            COUNT_TOKENS,
+            "constants",
+            (u32)memory->constant_count,
+            COUNT_CONSTANTS,
+            "methods",
+            (u32)memory->method_count,
+            COUNT_METHODS,
+            "ops",
+            (u32)memory->op_count,
+            COUNT_OPS);
+}
+
+void print_stats_trace(File*              file,
+                       const StatsReport* report,
+                       const Memory*      memory) {
+    const Stats* stats = &report->stats;
+    double       cycles_per_us = get_stats_cycles_per_us(report);
+    fprintf(file,
+            "{\"traceEvents\":[\n"
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+            "\"args\":{\"name\":\"main\"}},\n");
+    for (u32 i = 0; i < stats->event_count; ++i) {
+        const StatsEvent* event = &stats->events[i];
+        fprintf(file,
+                "{\"name\":\"%s\",\"cat\":\"asm\",\"ph\":\"X\",\"pid\":1,"
+                "\"tid\":0,\"ts\":%.3f,\"dur\":%.3f},\n",
+                get_stats_phase_name(event->phase),
+                (double)(event->start - report->start.cycles) / cycles_per_us,
+                (double)event->cycles / cycles_per_us);
+    }
+    fprintf(file,
+            "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+            "\"args\":{\"name\":\"asm\"}}\n"
+            "],\"otherData\":{\"constant_tags\":{");
+    Bool first = TRUE;
+    for (u32 i = 0; i < COUNT_STATS_CONSTANT_TAGS; ++i) {
+        if (stats->constant_tag_counts[i] != 0) {
+            fprintf(file,
+                    "%s\"%s\":%lu",
+                    first ? "" : ",",
+                    get_stats_constant_tag_name((ConstantTag)i),
+                    stats->constant_tag_counts[i]);
+            first = FALSE;
+        }
+    }
+    fprintf(file,
+            "},\"attribute_tags\":{\"Code\":%lu},\"op_codes\":{",
+            stats->code_attribute_count);
+    first = TRUE;
+    for (u32 i = 0; i < COUNT_STATS_OP_CODES; ++i) {
+        if (stats->op_code_counts[i] != 0) {
+            fprintf(file,
+                    "%s\"%s\":%lu",
+                    first ? "" : ",",
+                    get_stats_op_name((OpTag)i),
+                    stats->op_code_counts[i]);
+            first = FALSE;
+        }
+    }
+    fprintf(file,
+            "},\"file\":%u,\"buffer\":%u,\"tokens\":%u,\"constants\":%u,"
+            "\"methods\":%u,\"ops\":%u}}\n",
+            memory->file_size,
+            memory->buffer_size,
+            memory->token_count,
+            (u32)memory->constant_count,
+            (u32)memory->method_count,
+            (u32)memory->op_count);
+}
+
+void print_stats_report(StatsReport* report, const Memory* memory) {
+    if (report->text) {
+        print_stats(stderr, report, memory);
+    }
+    if (report->trace_path != NULL) {
+        File* file = fopen(report->trace_path, "w");
+        if (file == NULL) {
+            ERROR("Unable to open file");
+        }
+        print_stats_trace(file, report, memory);
+        fclose(file);
+    }
+    free_stats(&report->stats);
+}
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef __REPORT_H__
+#define __REPORT_H__
+
+#include "memory.c"
+
+const char* get_stats_phase_name(StatsPhase);
+const char* get_stats_constant_tag_name(ConstantTag);
+const char* get_stats_op_name(OpTag);
+double      get_stats_cycles_per_us(const StatsReport*);
+
+void set_stats_report(StatsReport*);
+void print_stats(File*, const StatsReport*, const Memory*);
+void print_stats_trace(File*, const StatsReport*, const Memory*);
+void print_stats_report(StatsReport*, const Memory*);
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef __STATS_C__
+#define __STATS_C__
+
+#include "stats.h"
+
+u64 get_stats_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((u64)now.tv_sec * 1000000000) + (u64)now.tv_nsec;
+#endif
+}
+
+StatsClock get_stats_clock(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (StatsClock){
+        .cycles = get_stats_cycles(),
+        .nanoseconds = ((u64)now.tv_sec * 1000000000) + (u64)now.tv_nsec,
+    };
+}
+
+void push_stats_event(Stats* stats, StatsEvent event) {
+    if (stats->event_capacity <= stats->event_count) {
+        u32 event_capacity = stats->event_capacity == 0
+                                 ? COUNT_STATS_EVENTS
+                                 : stats->event_capacity * 2;
+        StatsEvent* events =
+            realloc(stats->events, sizeof(StatsEvent) * event_capacity);
+        if (events == NULL) {
+            ERROR("`realloc` failed");
+        }
+        stats->events = events;
+        stats->event_capacity = event_capacity;
+    }
+    stats->events[stats->event_count++] = event;
+}
+
+void push_stats_phase(Stats* stats, StatsPhase phase) {
+    if (COUNT_STATS_DEPTH <= stats->depth) {
+        ERROR("Stats phases nested too deeply");
+    }
+    stats->open_phases[stats->depth] = phase;
+    stats->open_child_cycles[stats->depth] = 0;
+    stats->open_starts[stats->depth] = get_stats_cycles();
+    ++stats->depth;
+}
+
+/* NOTE: Cycles spent in nested phases are taken out of the enclosing one,
+ * so `phase_cycles` is exclusive. */
+void pop_stats_phase(Stats* stats, StatsPhase phase) {
+    u64 end = get_stats_cycles();
+    if ((stats->depth == 0) ||
+        (stats->open_phases[stats->depth - 1] != phase))
+    {
+        ERROR("Unbalanced stats phase");
+    }
+    u32 depth = --stats->depth;
+    u64 cycles = end - stats->open_starts[depth];
+    stats->phase_cycles[phase] += cycles - stats->open_child_cycles[depth];
+    ++stats->phase_counts[phase];
+    if (depth != 0) {
+        stats->open_child_cycles[depth - 1] += cycles;
+    }
+    push_stats_event(stats,
+                     (StatsEvent){
+                         .start = stats->open_starts[depth],
+                         .cycles = cycles,
+                         .phase = phase,
+                     });
+}
+
+void free_stats(Stats* stats) {
+    free(stats->events);
+    stats->events = NULL;
+    stats->event_count = 0;
+    stats->event_capacity = 0;
+}
+
+#endif
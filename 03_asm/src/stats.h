@@ -0,0 +1,82 @@
+#ifndef __STATS_H__
+#define __STATS_H__
+
+#include <time.h>
+
+#include "program.c"
+
+#define COUNT_STATS_DEPTH         8
+#define COUNT_STATS_EVENTS        64
+#define COUNT_STATS_CONSTANT_TAGS 8
+#define COUNT_STATS_OP_CODES      256
+
+typedef enum {
+    STATS_LOAD,
+    STATS_TOKENS,
+    STATS_CONSTANT_POOL,
+    STATS_METHODS,
+    STATS_ATTRIBUTES,
+    STATS_PRINT,
+    STATS_SERIALIZE,
+    COUNT_STATS_PHASES,
+} StatsPhase;
+
+typedef struct {
+    u64        start;
+    u64        cycles;
+    StatsPhase phase;
+} StatsEvent;
+
+typedef struct {
+    u64 cycles;
+    u64 nanoseconds;
+} StatsClock;
+
+typedef struct {
+    StatsEvent* events;
+    u32         event_count;
+    u32         event_capacity;
+    u32         depth;
+    StatsPhase  open_phases[COUNT_STATS_DEPTH];
+    u64         open_starts[COUNT_STATS_DEPTH];
+    u64         open_child_cycles[COUNT_STATS_DEPTH];
+    u64         phase_cycles[COUNT_STATS_PHASES];
+    u64         phase_counts[COUNT_STATS_PHASES];
+    u64         constant_tag_counts[COUNT_STATS_CONSTANT_TAGS];
+    u64         code_attribute_count;
+    u64         op_code_counts[COUNT_STATS_OP_CODES];
+} Stats;
+
+typedef struct {
+    Stats       stats;
+    StatsClock  start;
+    const char* trace_path;
+    Bool        text;
+} StatsReport;
+
+#ifdef STATS
+    #define STATS_PUSH(memory, phase) push_stats_phase(&(memory)->stats, phase)
+    #define STATS_POP(memory, phase)  pop_stats_phase(&(memory)->stats, phase)
+    #define STATS_COUNT_CONSTANT(memory, tag) \
+        ++(memory)->stats.constant_tag_counts[tag]
+    #define STATS_COUNT_ATTRIBUTE(memory) \
+        ++(memory)->stats.code_attribute_count
+    #define STATS_COUNT_OP_CODE(memory, op_code) \
+        ++(memory)->stats.op_code_counts[op_code]
+#else
+    #define STATS_PUSH(memory, phase)
+    #define STATS_POP(memory, phase)
+    #define STATS_COUNT_CONSTANT(memory, tag)
+    #define STATS_COUNT_ATTRIBUTE(memory)
+    #define STATS_COUNT_OP_CODE(memory, op_code)
+#endif
+
+u64        get_stats_cycles(void);
+StatsClock get_stats_clock(void);
+
+void push_stats_event(Stats*, StatsEvent);
+void push_stats_phase(Stats*, StatsPhase);
+void pop_stats_phase(Stats*, StatsPhase);
+void free_stats(Stats*);
+
+#endif
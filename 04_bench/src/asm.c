@@ -0,0 +1,71 @@
+#include "../../03_asm/src/memory.c"
+#include "bench.c"
+
+/* NOTE: The assembler's `Memory` has fixed capacities (`SIZE_FILE`,
+ * `COUNT_TOKENS`, ...), so it replays the given sources rather than a
+ * generated corpus. Each pass starts from a zeroed `Memory` with the
+ * source already copied in; only the three stages are timed. */
+i32 main(i32 n, const char** args) {
+    if (n < 4) {
+        ERROR("Missing arguments");
+    }
+    u32         pass_count = (u32)strtoul(args[2], NULL, 10);
+    u32         input_count = (u32)(n - 3);
+    BenchInput* inputs = calloc(input_count, sizeof(BenchInput));
+    if (inputs == NULL) {
+        ERROR("`calloc` failed");
+    }
+    u64 corpus_size = 0;
+    for (u32 i = 0; i < input_count; ++i) {
+        set_bench_input(&inputs[i], args[3 + i]);
+        if (SIZE_FILE < inputs[i].size) {
+            ERROR("File does not fit into memory");
+        }
+        corpus_size += inputs[i].size;
+    }
+    Memory* memory = calloc(1, sizeof(Memory));
+    if (memory == NULL) {
+        ERROR("`calloc` failed");
+    }
+    BenchStage tokens = {.name = "set_tokens"};
+    BenchStage program = {.name = "set_program"};
+    BenchStage serialize = {.name = "serialize_program_to_file"};
+    for (u32 pass = 0; pass <= pass_count; ++pass) {
+        for (u32 i = 0; i < input_count; ++i) {
+            memset(memory, 0, sizeof(Memory));
+            memcpy(memory->file, inputs[i].bytes, inputs[i].size);
+            memory->file_size = inputs[i].size;
+            u64 start = get_bench_now();
+            set_tokens(memory);
+            u64 tokenized = get_bench_now();
+            set_program(memory);
+            u64 assembled = get_bench_now();
+            serialize_program_to_file(&memory->program, args[1]);
+            u64 serialized = get_bench_now();
+            if (pass == 0) {
+                continue;
+            }
+            push_bench_sample(&tokens, tokenized - start, inputs[i].size);
+            push_bench_sample(&program, assembled - tokenized, inputs[i].size);
+            push_bench_sample(&serialize,
+                              serialized - assembled,
+                              inputs[i].size);
+        }
+    }
+    printf("[BENCH] %u sources, %.2f KB, %u passes\n",
+           input_count,
+           (double)corpus_size / (double)1024,
+           pass_count);
+    print_bench_stage(&tokens);
+    print_bench_stage(&program);
+    print_bench_stage(&serialize);
+    free_bench_stage(&tokens);
+    free_bench_stage(&program);
+    free_bench_stage(&serialize);
+    free(memory);
+    for (u32 i = 0; i < input_count; ++i) {
+        free(inputs[i].bytes);
+    }
+    free(inputs);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+#ifndef __BENCH_C__
+#define __BENCH_C__
+
+#include "bench.h"
+
+u64 get_bench_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((u64)now.tv_sec * 1000000000) + (u64)now.tv_nsec;
+}
+
+void set_bench_input(BenchInput* input, const char* path) {
+    File* file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "[ERROR] Unable to open `%s`\n", path);
+        exit(EXIT_FAILURE);
+    }
+    fseek(file, 0, SEEK_END);
+    input->size = (u32)ftell(file);
+    rewind(file);
+    input->bytes = malloc(input->size == 0 ? 1 : input->size);
+    if (input->bytes == NULL) {
+        fprintf(stderr, "[ERROR] `malloc` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    if (fread(input->bytes, 1, input->size, file) != input->size) {
+        fprintf(stderr, "[ERROR] `fread` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    fclose(file);
+}
+
+void push_bench_sample(BenchStage* stage, u64 nanoseconds, u32 byte_count) {
+    if (stage->sample_capacity <= stage->sample_count) {
+        u32 sample_capacity = stage->sample_capacity == 0
+                                  ? COUNT_BENCH_SAMPLES
+                                  : stage->sample_capacity * 2;
+        u64* samples =
+            realloc(stage->samples, sizeof(u64) * sample_capacity);
+        if (samples == NULL) {
+            fprintf(stderr, "[ERROR] `realloc` failed\n");
+            exit(EXIT_FAILURE);
+        }
+        stage->samples = samples;
+        stage->sample_capacity = sample_capacity;
+    }
+    stage->samples[stage->sample_count++] = nanoseconds;
+    stage->byte_count += byte_count;
+    stage->nanoseconds += nanoseconds;
+}
+
+i32 compare_bench_samples(const void* a, const void* b) {
+    u64 x = *(const u64*)a;
+    u64 y = *(const u64*)b;
+    return x < y ? -1 : y < x ? 1 : 0;
+}
+
+/* NOTE: Nearest rank; expects the samples sorted. */
+u64 get_bench_percentile(const BenchStage* stage, u32 percentile) {
+    if (stage->sample_count == 0) {
+        return 0;
+    }
+    u64 rank = ((u64)(stage->sample_count - 1) * percentile) / 100;
+    return stage->samples[rank];
+}
+
+/* NOTE: Throughput is over the summed per-class times, not wall time, so
+ * whatever the harness does between samples is left out. */
+void print_bench_stage(BenchStage* stage) {
+    if (stage->sample_count == 0) {
+        return;
+    }
+    qsort(stage->samples,
+          stage->sample_count,
+          sizeof(u64),
+          compare_bench_samples);
+    double seconds = (double)stage->nanoseconds / (double)1000000000;
+    printf("  %-26s %9.1f MB/s %11.0f files/s\n",
+           stage->name,
+           ((double)stage->byte_count / (double)(1024 * 1024)) / seconds,
+           (double)stage->sample_count / seconds);
+    printf("  %-26s p50 %.2f us, p90 %.2f us, p99 %.2f us, max %.2f us\n",
+           "",
+           (double)get_bench_percentile(stage, 50) / (double)1000,
+           (double)get_bench_percentile(stage, 90) / (double)1000,
+           (double)get_bench_percentile(stage, 99) / (double)1000,
+           (double)stage->samples[stage->sample_count - 1] / (double)1000);
+}
+
+void free_bench_stage(BenchStage* stage) {
+    free(stage->samples);
+    stage->samples = NULL;
+    stage->sample_count = 0;
+    stage->sample_capacity = 0;
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <string.h>
+#include <time.h>
+
+/* NOTE: Included after the code under test, whose `prelude.h` supplies the
+ * integer types; the disassembler and the assembler are separate unity
+ * builds and cannot share one translation unit. */
+
+#define COUNT_BENCH_SAMPLES 1024
+
+typedef struct {
+    u8* bytes;
+    u32 size;
+} BenchInput;
+
+/* NOTE: One sample per class per pass, in nanoseconds. `byte_count` is
+ * input bytes, so MB/s compares across stages that see the same files. */
+typedef struct {
+    const char* name;
+    u64*        samples;
+    u32         sample_count;
+    u32         sample_capacity;
+    u64         byte_count;
+    u64         nanoseconds;
+} BenchStage;
+
+u64  get_bench_now(void);
+void set_bench_input(BenchInput*, const char*);
+
+void push_bench_sample(BenchStage*, u64, u32);
+i32  compare_bench_samples(const void*, const void*);
+u64  get_bench_percentile(const BenchStage*, u32);
+void print_bench_stage(BenchStage*);
+void free_bench_stage(BenchStage*);
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef __CORPUS_C__
+#define __CORPUS_C__
+
+#include "corpus.h"
+
+/* NOTE: xorshift32; the same seed always writes the same corpus. */
+u32 get_corpus_random(u32* state) {
+    u32 x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+u32 get_corpus_unit_size(const CorpusShape* shape, CorpusUnit unit) {
+    switch (unit) {
+    case CORPUS_UNIT_FILL: {
+        /* NOTE: `ldc_w`, `pop`, or just `iinc` with no constants. */
+        return shape->constant_count == 0 ? 3 : 4;
+    }
+    case CORPUS_UNIT_BRANCH: {
+        /* NOTE: `iload_0`, `ifeq`, `iinc`. */
+        return 7;
+    }
+    }
+    return 0;
+}
+
+/* NOTE: Lays the body out before anything is written, since the code and
+ * attribute sizes come first in the file. Every unit leaves the stack
+ * empty and the one `int` local untouched in type, so every frame is a
+ * `same_frame` (or its extended form) and the method verifies. */
+void set_corpus_code(const CorpusShape* shape,
+                     CorpusCode*        code,
+                     u32*               random) {
+    u32 pc = 0;
+    code->unit_count = 0;
+    code->frame_count = 0;
+    for (;;) {
+        CorpusUnit unit = (get_corpus_random(random) % 100) <
+                                  shape->stack_map_density
+                              ? CORPUS_UNIT_BRANCH
+                              : CORPUS_UNIT_FILL;
+        u32 size = get_corpus_unit_size(shape, unit);
+        if (shape->code_size < (pc + size + SIZE_CORPUS_TAIL)) {
+            break;
+        }
+        code->units[code->unit_count++] = unit;
+        pc += size;
+        if (unit == CORPUS_UNIT_BRANCH) {
+            code->frames[code->frame_count++] = (u16)pc;
+        }
+    }
+    code->code_size = pc + SIZE_CORPUS_TAIL;
+}
+
+u32 get_corpus_stack_map_size(const CorpusCode* code) {
+    u32 size = 2;
+    for (u32 i = 0; i < code->frame_count; ++i) {
+        u32 delta = i == 0 ? code->frames[0]
+                           : (u32)(code->frames[i] - code->frames[i - 1]) - 1;
+        size += delta <= SIZE_CORPUS_SAME ? 1 : 3;
+    }
+    return size;
+}
+
+void set_corpus_stack_map(File* file, const CorpusCode* code) {
+    set_u16(file, CORPUS_STACK_MAP);
+    set_u32(file, get_corpus_stack_map_size(code));
+    set_u16(file, (u16)code->frame_count);
+    for (u32 i = 0; i < code->frame_count; ++i) {
+        u32 delta = i == 0 ? code->frames[0]
+                           : (u32)(code->frames[i] - code->frames[i - 1]) - 1;
+        if (delta <= SIZE_CORPUS_SAME) {
+            set_u8(file, (u8)delta);
+        } else {
+            set_u8(file, 251);
+            set_u16(file, (u16)delta);
+        }
+    }
+}
+
+void set_corpus_method(File*              file,
+                       const CorpusShape* shape,
+                       const CorpusCode*  code,
+                       u32                method_index,
+                       u16                first_string) {
+    u32 stack_map_size =
+        code->frame_count == 0 ? 0 : 6 + get_corpus_stack_map_size(code);
+    set_u16(file, ACCESS_PUBLIC + ACCESS_STATIC);
+    set_u16(file, (u16)(CORPUS_FIRST_NAME + method_index));
+    set_u16(file, CORPUS_DESCRIPTOR);
+    set_u16(file, 1);
+    set_u16(file, CORPUS_CODE);
+    set_u32(file, 12 + code->code_size + stack_map_size);
+    set_u16(file, 1);
+    set_u16(file, 1);
+    set_u32(file, code->code_size);
+    for (u32 i = 0; i < code->unit_count; ++i) {
+        switch (code->units[i]) {
+        case CORPUS_UNIT_FILL: {
+            if (shape->constant_count == 0) {
+                set_instr_u8_u8(file, INSTR_IINC, 0, 1);
+                break;
+            }
+            u32 string = (method_index + i) % shape->constant_count;
+            set_instr_u16(file,
+                          INSTR_LDC_W,
+                          (u16)(first_string + (string * 2) + 1));
+            set_instr_empty(file, INSTR_POP);
+            break;
+        }
+        case CORPUS_UNIT_BRANCH: {
+            set_instr_empty(file, INSTR_ILOAD_0);
+            set_instr_u16(file, INSTR_IFEQ, 6);
+            set_instr_u8_u8(file, INSTR_IINC, 0, 1);
+            break;
+        }
+        }
+    }
+    set_instr_empty(file, INSTR_ILOAD_0);
+    set_instr_empty(file, INSTR_IRETURN);
+    SET_BYTES(file, &EMPTY);
+    if (code->frame_count == 0) {
+        SET_BYTES(file, &EMPTY);
+        return;
+    }
+    set_u16(file, 1);
+    set_corpus_stack_map(file, code);
+}
+
+void set_corpus_class(const CorpusShape* shape,
+                      CorpusCode*        code,
+                      u32*               random,
+                      const char*        path,
+                      u32                class_index) {
+    File* file = fopen(path, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "[ERROR] Unable to open `%s`\n", path);
+        exit(EXIT_FAILURE);
+    }
+    {
+        const Version version = {
+            .magic = __builtin_bswap32(0xCAFEBABE),
+            .minor_version = 0,
+            .major_version = __builtin_bswap16(52),
+        };
+        SET_BYTES(file, &version);
+    }
+    u16 first_string = (u16)(CORPUS_FIRST_NAME + shape->method_count);
+    {
+        char name[SIZE_CORPUS_NAME];
+        set_u16(file, (u16)(first_string + (shape->constant_count * 2)));
+        set_constant_pool_utf8(file, "Code");
+        set_constant_pool_utf8(file, "StackMapTable");
+        set_constant_pool_utf8(file, "(I)I");
+        snprintf(name, sizeof(name), "Gen%u", class_index);
+        set_constant_pool_class(file, CORPUS_THIS_NAME, name);
+        set_constant_pool_class(file, CORPUS_SUPER_NAME, "java/lang/Object");
+        for (u32 i = 0; i < shape->method_count; ++i) {
+            snprintf(name, sizeof(name), "m%u", i);
+            set_constant_pool_utf8(file, name);
+        }
+        for (u32 i = 0; i < shape->constant_count; ++i) {
+            snprintf(name,
+                     sizeof(name),
+                     "constant %u of Gen%u",
+                     i,
+                     class_index);
+            set_constant_pool_string(file,
+                                     (u16)(first_string + (i * 2)),
+                                     name);
+        }
+    }
+    {
+        const Flags flags = {
+            .access_modifiers =
+                __builtin_bswap16(ACCESS_PUBLIC + ACCESS_SUPER),
+            .class_constant_index = __builtin_bswap16(CORPUS_THIS),
+            .super_constant_index = __builtin_bswap16(CORPUS_SUPER),
+        };
+        SET_BYTES(file, &flags);
+    }
+    {
+        /* NOTE: Nothing inscribed into `interfaces` section. */
+        SET_BYTES(file, &EMPTY);
+    }
+    {
+        /* NOTE: Nothing inscribed into `fields` section. */
+        SET_BYTES(file, &EMPTY);
+    }
+    set_u16(file, (u16)shape->method_count);
+    for (u32 i = 0; i < shape->method_count; ++i) {
+        set_corpus_code(shape, code, random);
+        set_corpus_method(file, shape, code, i, first_string);
+    }
+    {
+        /* NOTE: Nothing inscribed into `attributes` section. */
+        SET_BYTES(file, &EMPTY);
+    }
+    fclose(file);
+}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef __CORPUS_H__
+#define __CORPUS_H__
+
+#include <string.h>
+
+#include "../../01_hello_world/src/class.c"
+
+#define SIZE_CORPUS_PATH  4096
+#define SIZE_CORPUS_NAME  32
+#define SIZE_CORPUS_CODE  65535
+#define SIZE_CORPUS_TAIL  2
+#define SIZE_CORPUS_SAME  63
+#define COUNT_CORPUS_POOL 65535
+
+/* NOTE: Fixed pool slots every generated class shares; method names and
+ * string constants follow. */
+#define CORPUS_CODE       1
+#define CORPUS_STACK_MAP  2
+#define CORPUS_DESCRIPTOR 3
+#define CORPUS_THIS_NAME  4
+#define CORPUS_THIS       5
+#define CORPUS_SUPER_NAME 6
+#define CORPUS_SUPER      7
+#define CORPUS_FIRST_NAME 8
+
+/* NOTE: `stack_map_density` is the percentage of code units that branch;
+ * each branch target gets a stack map frame. */
+typedef struct {
+    u32 class_count;
+    u32 constant_count;
+    u32 method_count;
+    u32 code_size;
+    u32 stack_map_density;
+    u32 seed;
+} CorpusShape;
+
+typedef enum {
+    CORPUS_UNIT_FILL,
+    CORPUS_UNIT_BRANCH,
+} CorpusUnit;
+
+typedef struct {
+    CorpusUnit* units;
+    u16*     frames;
+    u32      unit_count;
+    u32      frame_count;
+    u32      code_size;
+} CorpusCode;
+
+u32  get_corpus_random(u32*);
+u32  get_corpus_unit_size(const CorpusShape*, CorpusUnit);
+void set_corpus_code(const CorpusShape*, CorpusCode*, u32*);
+u32  get_corpus_stack_map_size(const CorpusCode*);
+void set_corpus_stack_map(File*, const CorpusCode*);
+void set_corpus_method(File*, const CorpusShape*, const CorpusCode*, u32, u16);
+void set_corpus_class(const CorpusShape*, CorpusCode*, u32*, const char*, u32);
+
+#endif
@@ -0,0 +1,110 @@
+#include "../../02_disasm/src/batch.c"
+#include "bench.c"
+
+#define COUNT_BENCH_PASSES 5
+
+/* NOTE: Every class is loaded up front so only parsing and printing are
+ * timed. The first pass warms caches and the arena and is not recorded.
+ * Printing goes to an in-memory `Buffer` that is emptied after each class,
+ * so `write(2)` never shows up in the numbers. */
+i32 main(i32 n, const char** args) {
+    if (n < 2) {
+        fprintf(stderr, "[ERROR] No directory or jar provided\n");
+        exit(EXIT_FAILURE);
+    }
+    u32 pass_count =
+        2 < n ? (u32)strtoul(args[2], NULL, 10) : COUNT_BENCH_PASSES;
+    set_mutf8_dispatch();
+    Batch batch = {0};
+    if (is_jar_file(args[1])) {
+        set_batch_jar_jobs(&batch, args[1]);
+    } else {
+        set_batch_jobs(&batch, args[1]);
+    }
+    BenchInput* inputs = calloc(batch.job_count, sizeof(BenchInput));
+    if ((batch.job_count != 0) && (inputs == NULL)) {
+        fprintf(stderr, "[ERROR] `calloc` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    u64 corpus_size = 0;
+    for (u32 i = 0; i < batch.job_count; ++i) {
+        BatchJob* job = &batch.jobs[i];
+        if (job->entry.name == NULL) {
+            set_bench_input(&inputs[i], job->path);
+        } else {
+            u8*         buffer = NULL;
+            u32         buffer_capacity = 0;
+            const u8*   bytes;
+            const char* load_error = try_jar_entry_bytes(&job->entry,
+                                                         &buffer,
+                                                         &buffer_capacity,
+                                                         &bytes);
+            if (load_error != NULL) {
+                fprintf(stderr, "[ERROR] %s: %s\n", job->path, load_error);
+                exit(EXIT_FAILURE);
+            }
+            inputs[i].size = job->entry.size;
+            inputs[i].bytes =
+                malloc(job->entry.size == 0 ? 1 : job->entry.size);
+            if (inputs[i].bytes == NULL) {
+                fprintf(stderr, "[ERROR] `malloc` failed\n");
+                exit(EXIT_FAILURE);
+            }
+            memcpy(inputs[i].bytes, bytes, job->entry.size);
+            free(buffer);
+        }
+        corpus_size += inputs[i].size;
+    }
+    Memory* memory = calloc(1, sizeof(Memory));
+    if (memory == NULL) {
+        fprintf(stderr, "[ERROR] `calloc` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    memory->lazy_methods = FALSE;
+    Buffer buffer;
+    set_buffer(&buffer, -1);
+    BenchStage parse = {.name = "set_tokens"};
+    BenchStage print = {.name = "print_tokens"};
+    for (u32 pass = 0; pass <= pass_count; ++pass) {
+        for (u32 i = 0; i < batch.job_count; ++i) {
+            u64        start = get_bench_now();
+            ParseError error =
+                parse_class(memory, inputs[i].bytes, inputs[i].size);
+            u64 parsed = get_bench_now();
+            if (error.code != PARSE_OK) {
+                fprintf(stderr,
+                        "[ERROR] %s: %s (byte %u)\n",
+                        batch.jobs[i].path,
+                        get_parse_error_name(error.code),
+                        error.offset);
+                exit(EXIT_FAILURE);
+            }
+            print_tokens(&buffer, memory, NULL);
+            u64 printed = get_bench_now();
+            buffer.size = 0;
+            if (pass == 0) {
+                continue;
+            }
+            push_bench_sample(&parse, parsed - start, inputs[i].size);
+            push_bench_sample(&print, printed - parsed, inputs[i].size);
+        }
+    }
+    printf("[BENCH] %u classes, %.2f MB, %u passes\n",
+           batch.job_count,
+           (double)corpus_size / (double)(1024 * 1024),
+           pass_count);
+    print_bench_stage(&parse);
+    print_bench_stage(&print);
+    free_bench_stage(&parse);
+    free_bench_stage(&print);
+    free_buffer(&buffer);
+    free_memory(memory);
+    free(memory);
+    for (u32 i = 0; i < batch.job_count; ++i) {
+        free(inputs[i].bytes);
+        free(batch.jobs[i].path);
+    }
+    free(inputs);
+    free(batch.jobs);
+    return EXIT_SUCCESS;
+}
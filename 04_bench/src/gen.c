@@ -0,0 +1,49 @@
+#include "corpus.c"
+
+i32 main(i32 n, const char** args) {
+    if (n < 7) {
+        fprintf(stderr,
+                "[ERROR] Usage: %s <directory> <classes> <constants> "
+                "<methods> <code size> <stack map %%> [seed]\n",
+                args[0]);
+        exit(EXIT_FAILURE);
+    }
+    CorpusShape shape = {
+        .class_count = (u32)strtoul(args[2], NULL, 10),
+        .constant_count = (u32)strtoul(args[3], NULL, 10),
+        .method_count = (u32)strtoul(args[4], NULL, 10),
+        .code_size = (u32)strtoul(args[5], NULL, 10),
+        .stack_map_density = (u32)strtoul(args[6], NULL, 10),
+        .seed = 7 < n ? (u32)strtoul(args[7], NULL, 10) : 1,
+    };
+    if ((COUNT_CORPUS_POOL < shape.constant_count) ||
+        (COUNT_CORPUS_POOL < shape.method_count) ||
+        (COUNT_CORPUS_POOL < (CORPUS_FIRST_NAME + shape.method_count +
+                              (shape.constant_count * 2))) ||
+        (SIZE_CORPUS_CODE < shape.code_size) ||
+        (shape.code_size < SIZE_CORPUS_TAIL) ||
+        (100 < shape.stack_map_density))
+    {
+        fprintf(stderr, "[ERROR] Shape does not fit in a class file\n");
+        exit(EXIT_FAILURE);
+    }
+    CorpusCode code = {
+        .units = malloc(sizeof(CorpusUnit) * shape.code_size),
+        .frames = malloc(sizeof(u16) * shape.code_size),
+    };
+    if ((code.units == NULL) || (code.frames == NULL)) {
+        fprintf(stderr, "[ERROR] `malloc` failed\n");
+        exit(EXIT_FAILURE);
+    }
+    /* NOTE: xorshift never leaves zero. */
+    u32 random = shape.seed == 0 ? 1 : shape.seed;
+    for (u32 i = 0; i < shape.class_count; ++i) {
+        char path[SIZE_CORPUS_PATH];
+        snprintf(path, sizeof(path), "%s/Gen%u.class", args[1], i);
+        set_corpus_class(&shape, &code, &random, path, i);
+    }
+    free(code.units);
+    free(code.frames);
+    printf("Done!\n");
+    return EXIT_SUCCESS;
+}